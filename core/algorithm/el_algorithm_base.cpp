@@ -30,6 +30,7 @@
 #include "core/el_debug.h"
 #include "core/el_types.h"
 #include "core/engine/el_engine_base.h"
+#include "core/utils/el_heap.h"
 
 namespace edgelab::base {
 
@@ -65,9 +66,12 @@ el_err_code_t Algorithm::underlying_run(void* input) {
     __p_input = input;
 
     // preprocess
-    start_time        = el_get_time_ms();
-    ret               = preprocess();
-    end_time          = el_get_time_ms();
+    {
+        const HeapScope heap_scope(EL_HEAP_TAG_PREPROCESS);
+        start_time = el_get_time_us();
+        ret        = preprocess();
+        end_time   = el_get_time_us();
+    }
     __preprocess_time = end_time - start_time;
 
     EL_ON_ALGO_PREPROCESS_DONE;
@@ -77,9 +81,12 @@ el_err_code_t Algorithm::underlying_run(void* input) {
     }
 
     // run
-    start_time = el_get_time_ms();
-    ret        = __p_engine->run();
-    end_time   = el_get_time_ms();
+    {
+        const HeapScope heap_scope(EL_HEAP_TAG_RUN);
+        start_time = el_get_time_us();
+        ret        = __p_engine->run();
+        end_time   = el_get_time_us();
+    }
     __run_time = end_time - start_time;
 
     EL_ON_ALGO_RUN_DONE;
@@ -89,9 +96,12 @@ el_err_code_t Algorithm::underlying_run(void* input) {
     }
 
     // postprocess
-    start_time         = el_get_time_ms();
-    ret                = postprocess();
-    end_time           = el_get_time_ms();
+    {
+        const HeapScope heap_scope(EL_HEAP_TAG_POSTPROCESS);
+        start_time = el_get_time_us();
+        ret        = postprocess();
+        end_time   = el_get_time_us();
+    }
     __postprocess_time = end_time - start_time;
 
     EL_ON_ALGO_POSTPROCESS_DONE;
@@ -101,10 +111,16 @@ el_err_code_t Algorithm::underlying_run(void* input) {
 
 Algorithm::InfoType Algorithm::get_algorithm_info() const { return __algorithm_info; };
 
-uint32_t Algorithm::get_preprocess_time() const { return __preprocess_time; }
+uint32_t Algorithm::get_preprocess_time() const { return __preprocess_time / 1000u; }
+
+uint32_t Algorithm::get_run_time() const { return __run_time / 1000u; }
+
+uint32_t Algorithm::get_postprocess_time() const { return __postprocess_time / 1000u; }
+
+uint32_t Algorithm::get_preprocess_time_us() const { return __preprocess_time; }
 
-uint32_t Algorithm::get_run_time() const { return __run_time; }
+uint32_t Algorithm::get_run_time_us() const { return __run_time; }
 
-uint32_t Algorithm::get_postprocess_time() const { return __postprocess_time; }
+uint32_t Algorithm::get_postprocess_time_us() const { return __postprocess_time; }
 
 }  // namespace edgelab::base
@@ -84,6 +84,10 @@ class Algorithm {
     uint32_t get_run_time() const;
     uint32_t get_postprocess_time() const;
 
+    uint32_t get_preprocess_time_us() const;
+    uint32_t get_run_time_us() const;
+    uint32_t get_postprocess_time_us() const;
+
    protected:
     el_err_code_t underlying_run(void* input);
 
@@ -103,9 +107,9 @@ class Algorithm {
    private:
     InfoType __algorithm_info;
 
-    uint32_t __preprocess_time;   // ms
-    uint32_t __run_time;          // ms
-    uint32_t __postprocess_time;  // ms
+    uint32_t __preprocess_time;   // us
+    uint32_t __run_time;          // us
+    uint32_t __postprocess_time;  // us
 };
 
 }  // namespace base
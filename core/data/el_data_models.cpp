@@ -28,7 +28,11 @@
 #if CONFIG_EL_MODEL
 
     #include <algorithm>
+    #include <cstddef>
+    #include <cstring>
+    #include <iterator>
 
+    #include "core/utils/el_hash.h"
     #include "porting/el_flash.h"
 
 namespace edgelab {
@@ -44,7 +48,12 @@ Models::Models()
       __flash_2_memory_map(nullptr),
       __mmap_handler(),
       __model_id_mask(0u),
-      __model_info() {}
+      __model_format(EL_MODEL_FMT_UNDEFINED),
+      __model_info(),
+      __model_info_index(),
+      __model_meta(),
+      __verify_offset(),
+      __verify_crc() {}
 
 Models::~Models() { deinit(); }
 
@@ -56,11 +65,24 @@ el_err_code_t Models::init(el_model_format_v model_format) {
     return EL_OK;
 }
 
+el_err_code_t Models::init(const el_model_index_t& index, el_model_format_v model_format) {
+    if (!porting::el_flash_mmap_init(
+          &__partition_start_addr, &__partition_size, &__flash_2_memory_map, &__mmap_handler)) [[unlikely]]
+        return EL_EIO;
+    if (!load_index(index, model_format)) [[unlikely]] {
+        EL_LOGI("[Models] model index is stale, scanning models partition...");
+        seek_models_from_flash(model_format);
+    }
+    return EL_OK;
+}
+
 void Models::deinit() {
     porting::el_flash_mmap_deinit(&__mmap_handler);
     __flash_2_memory_map = nullptr;
     __mmap_handler       = 0;
     __model_info.clear();
+    std::fill(std::begin(__model_meta), std::end(__model_meta), el_model_meta_t{});
+    m_update_model_info_index();
 }
 
 std::size_t Models::seek_models_from_flash(const el_model_format_v& model_format) {
@@ -68,48 +90,249 @@ std::size_t Models::seek_models_from_flash(const el_model_format_v& model_format
         return 0u;
 
     __model_id_mask = 0u;
+    __model_format  = model_format;
     __model_info.clear();
+    std::fill(std::begin(__model_meta), std::end(__model_meta), el_model_meta_t{});
 
     switch (model_format) {
     case EL_MODEL_FMT_PACKED_TFLITE:
         m_seek_packed_models_from_flash();
-        return std::distance(__model_info.begin(), __model_info.end());
+        break;
     case EL_MODEL_FMT_PLAIN_TFLITE:
         m_seek_plain_models_from_flash();
-        return std::distance(__model_info.begin(), __model_info.end());
+        break;
     case EL_MODEL_FMT_PACKED_TFLITE | EL_MODEL_FMT_PLAIN_TFLITE:
         m_seek_packed_models_from_flash();
         m_seek_plain_models_from_flash();
-        return std::distance(__model_info.begin(), __model_info.end());
+        break;
     default:
-        return 0u;
+        __model_format = EL_MODEL_FMT_UNDEFINED;
+    }
+
+    m_update_model_info_index();
+    return std::distance(__model_info.begin(), __model_info.end());
+}
+
+bool Models::load_index(const el_model_index_t& index, const el_model_format_v& model_format) {
+    if (!__flash_2_memory_map) [[unlikely]]
+        return false;
+
+    uint32_t signature = 0u;
+    if (index.version != EL_MODEL_INDEX_VERSION || index.format != model_format ||
+        index.partition_size != __partition_size || index.count > EL_MODEL_INDEX_ENTRIES_MAX ||
+        !m_get_partition_signature(signature) || index.signature != signature)
+        return false;
+
+    // entries are validated against the headers in flash before any of them is taken
+    el_model_info_t model_info[EL_MODEL_INDEX_ENTRIES_MAX]{};
+    el_model_meta_t model_meta[EL_MODEL_INDEX_ENTRIES_MAX]{};
+    for (std::size_t i = 0u; i < index.count; ++i) {
+        const auto& entry = index.entries[i];
+        if (!entry.id || entry.id > EL_MODEL_INDEX_ENTRIES_MAX || entry.offset > __partition_size ||
+            __partition_size - entry.offset < sizeof(el_model_header_t) + entry.size) [[unlikely]]
+            return false;
+
+        if (entry.type == EL_ALGO_TYPE_UNDEFINED) {
+            const auto* header = reinterpret_cast<const el_model_header_t*>(__flash_2_memory_map + entry.offset);
+            if (el_ntohl(header->b4[1]) != CONFIG_EL_MODEL_TFLITE_MAGIC) [[unlikely]]
+                return false;
+            model_info[i] = el_model_info_t{.id          = entry.id,
+                                            .type        = EL_ALGO_TYPE_UNDEFINED,
+                                            .addr_flash  = __partition_start_addr + entry.offset,
+                                            .size        = entry.size,
+                                            .addr_memory = __flash_2_memory_map + entry.offset};
+        } else if (!m_parse_packed_model(entry.offset, model_info[i], model_meta[i]) ||
+                   model_info[i].id != entry.id || model_info[i].type != entry.type ||
+                   model_info[i].size != entry.size) [[unlikely]]
+            return false;
+    }
+
+    __model_id_mask = 0u;
+    __model_format  = model_format;
+    __model_info.clear();
+    std::fill(std::begin(__model_meta), std::end(__model_meta), el_model_meta_t{});
+    // restored in the reversed order, so that the list is in the same order as it was indexed
+    for (std::size_t i = index.count; i-- > 0u;) {
+        __model_info.emplace_front(model_info[i]);
+        __model_meta[model_info[i].id] = model_meta[i];
+        __model_id_mask |= (1u << model_info[i].id);
+    }
+
+    m_update_model_info_index();
+    return true;
+}
+
+el_model_index_t Models::get_index() const {
+    uint32_t signature = 0u;
+    m_get_partition_signature(signature);
+
+    el_model_index_t index{};
+    index.version        = EL_MODEL_INDEX_VERSION;
+    index.format         = static_cast<uint8_t>(__model_format);
+    index.partition_size = __partition_size;
+    index.signature      = signature;
+    for (const auto& v : __model_info) {
+        if (index.count >= EL_MODEL_INDEX_ENTRIES_MAX) [[unlikely]]
+            break;
+        index.entries[index.count++] = el_model_index_entry_t{
+          .id     = v.id,
+          .type   = static_cast<uint8_t>(v.type),
+          .offset = v.addr_flash - __partition_start_addr,
+          .size   = v.size,
+        };
+    }
+    return index;
+}
+
+el_model_meta_t Models::get_model_meta(el_model_id_t model_id) const {
+    if (model_id <= EL_MODEL_INDEX_ENTRIES_MAX && __model_info_index[model_id]) [[likely]]
+        return __model_meta[model_id];
+    return {};
+}
+
+el_model_verify_t Models::verify(el_model_id_t model_id) {
+    if (model_id > EL_MODEL_INDEX_ENTRIES_MAX || !__model_info_index[model_id]) [[unlikely]]
+        return EL_MODEL_VERIFY_NONE;
+    while (__model_meta[model_id].verify == EL_MODEL_VERIFY_PENDING)
+        m_verify_chunk(model_id, __model_info_index[model_id]->size);
+    return __model_meta[model_id].verify;
+}
+
+bool Models::verify_step(std::size_t max_bytes) {
+    for (el_model_id_t id = 1u; id <= EL_MODEL_INDEX_ENTRIES_MAX; ++id) {
+        if (__model_info_index[id] && __model_meta[id].verify == EL_MODEL_VERIFY_PENDING) {
+            m_verify_chunk(id, max_bytes);
+            return true;
+        }
     }
+    return false;
+}
+
+// the CRC is accumulated across the calls, so that the verification could be split into small steps
+void Models::m_verify_chunk(el_model_id_t model_id, std::size_t max_bytes) {
+    const auto* model_info = __model_info_index[model_id];
+    auto&       model_meta = __model_meta[model_id];
+    std::size_t remaining  = model_info->size - __verify_offset[model_id];
+    std::size_t size       = std::min(max_bytes, remaining);
+
+    __verify_crc[model_id] =
+      el_crc32(model_info->addr_memory + __verify_offset[model_id], size, __verify_crc[model_id]);
+    __verify_offset[model_id] += size;
+    if (__verify_offset[model_id] < model_info->size) return;
+
+    model_meta.verify = __verify_crc[model_id] == model_meta.crc32 ? EL_MODEL_VERIFY_OK : EL_MODEL_VERIFY_FAILED;
+    if (model_meta.verify == EL_MODEL_VERIFY_FAILED) [[unlikely]]
+        EL_LOGW("[Models] model %d is corrupted, CRC-32 0x%.8lx != 0x%.8lx",
+                model_id,
+                static_cast<unsigned long>(__verify_crc[model_id]),
+                static_cast<unsigned long>(model_meta.crc32));
+}
+
+void Models::m_update_model_info_index() {
+    std::fill(std::begin(__model_info_index), std::end(__model_info_index), nullptr);
+    std::fill(std::begin(__verify_offset), std::end(__verify_offset), 0u);
+    std::fill(std::begin(__verify_crc), std::end(__verify_crc), 0u);
+    for (const auto& v : __model_info)
+        if (v.id <= EL_MODEL_INDEX_ENTRIES_MAX) [[likely]]
+            __model_info_index[v.id] = &v;
+}
+
+// FNV-1a hash of the partition size and the models image tag, the tag is changed each time the image is written, so
+// that the index is validated without reading the models, the headers of the indexed models are still parsed again on
+// loading the index, returns false if the image has no valid tag
+bool Models::m_get_partition_signature(uint32_t& signature) const {
+    uint32_t hash  = 0x811c9dc5;
+    uint32_t prime = 0x1000193;
+    auto     feed  = [&](const void* data, std::size_t size) {
+        for (std::size_t i = 0u; i < size; ++i) {
+            hash ^= static_cast<const uint8_t*>(data)[i];
+            hash *= prime;
+        }
+    };
+
+    signature = 0u;
+    if (!__flash_2_memory_map || __partition_size < sizeof(el_models_image_tag_t)) [[unlikely]]
+        return false;
+    el_models_image_tag_t tag{};
+    std::memcpy(&tag, __flash_2_memory_map + __partition_size - sizeof(tag), sizeof(tag));
+    if (el_ntohl(tag.magic) != CONFIG_EL_MODEL_IMAGE_TAG_MAGIC ||
+        el_ntohl(tag.crc32) != el_crc32(reinterpret_cast<const uint8_t*>(&tag), offsetof(el_models_image_tag_t, crc32)))
+        return false;
+
+    feed(&__partition_size, sizeof(__partition_size));
+    feed(&tag.generation, sizeof(tag.generation));
+    signature = hash;
+    return true;
 }
 
 void Models::m_seek_packed_models_from_flash() {
-    const uint8_t*           mem_addr = nullptr;
-    const el_model_header_t* header   = nullptr;
+    el_model_info_t model_info{};
+    el_model_meta_t model_meta{};
     for (std::size_t it = 0u; it < __partition_size; it += CONFIG_EL_MODEL_SEEK_STEP_BYTES) {
-        mem_addr = __flash_2_memory_map + it;
-        header   = reinterpret_cast<const el_model_header_t*>(mem_addr);
-        if ((el_ntohl(header->b4[0]) & 0xFFFFFF00) != (CONFIG_EL_MODEL_HEADER_MAGIC << 8u)) continue;
+        if (!m_parse_packed_model(it, model_info, model_meta)) continue;
 
-        uint8_t  model_id   = header->b1[3] >> 4u;
-        uint8_t  model_type = header->b1[3] & 0x0F;
-        uint32_t model_size = (el_ntohl(header->b4[1]) & 0xFFFFFF00) >> 8u;
-        if (!model_id || !model_type || !model_size || model_size > (__partition_size - it)) [[unlikely]]
-            continue;
+        if (~__model_id_mask & (1u << model_info.id)) {
+            __model_info.emplace_front(model_info);
+            __model_meta[model_info.id] = model_meta;
+            __model_id_mask |= (1u << model_info.id);
+        }
+        // skip the extended header (if any) and the payload, the model header is skipped by the seek step
+        it += (model_info.addr_memory - (__flash_2_memory_map + it)) - sizeof(el_model_header_t) + model_info.size;
+    }
+}
+
+bool Models::m_parse_packed_model(std::size_t      offset,
+                                  el_model_info_t& model_info,
+                                  el_model_meta_t& model_meta) const {
+    if (__partition_size - offset < sizeof(el_model_header_t)) [[unlikely]]
+        return false;
+
+    const uint8_t* mem_addr = __flash_2_memory_map + offset;
+    const auto*    header   = reinterpret_cast<const el_model_header_t*>(mem_addr);
+    if ((el_ntohl(header->b4[0]) & 0xFFFFFF00) != (CONFIG_EL_MODEL_HEADER_MAGIC << 8u)) return false;
+
+    uint8_t  model_id   = header->b1[3] >> 4u;
+    uint8_t  model_type = header->b1[3] & 0x0F;
+    uint32_t model_size = (el_ntohl(header->b4[1]) & 0xFFFFFF00) >> 8u;
+    if (!model_id || !model_type || !model_size || model_size > (__partition_size - offset)) [[unlikely]]
+        return false;
 
-        if (~__model_id_mask & (1u << model_id)) {
-            __model_info.emplace_front(el_model_info_t{.id          = model_id,
-                                                       .type        = static_cast<el_algorithm_type_t>(model_type),
-                                                       .addr_flash  = __partition_start_addr + it,
-                                                       .size        = model_size,
-                                                       .addr_memory = mem_addr + sizeof(el_model_header_t)});
-            __model_id_mask |= (1u << model_id);
+    std::size_t ext_size = 0u;
+    model_meta           = el_model_meta_t{};
+    if (header->b1[7] == EL_MODEL_HEADER_VERSION_EXT) {
+        const auto* ext = reinterpret_cast<const el_model_header_ext_t*>(mem_addr + sizeof(el_model_header_t));
+        if (model_size <= sizeof(el_model_header_ext_t) ||
+            el_ntohl(ext->magic) != CONFIG_EL_MODEL_HEADER_EXT_MAGIC) [[unlikely]]
+            return false;
+        ext_size = el_ntohs(ext->size);
+        if (ext_size < sizeof(el_model_header_ext_t) || ext_size >= model_size) [[unlikely]]
+            return false;
+
+        auto to_float = [](uint32_t bits) {
+            float v;
+            std::memcpy(&v, &bits, sizeof(v));
+            return v;
+        };
+        model_meta.verify     = EL_MODEL_VERIFY_PENDING;
+        model_meta.version    = el_ntohs(ext->version);
+        model_meta.crc32      = el_ntohl(ext->crc32);
+        model_meta.arena_size = el_ntohl(ext->arena_size);
+        for (std::size_t i = 0u; i < 4u; ++i) {
+            model_meta.input_shape[i]  = el_ntohs(ext->input_shape[i]);
+            model_meta.output_shape[i] = el_ntohs(ext->output_shape[i]);
         }
-        it += model_size;
+        model_meta.input_quant.scale       = to_float(el_ntohl(ext->input_scale));
+        model_meta.input_quant.zero_point  = static_cast<int32_t>(el_ntohl(ext->input_zero_point));
+        model_meta.output_quant.scale      = to_float(el_ntohl(ext->output_scale));
+        model_meta.output_quant.zero_point = static_cast<int32_t>(el_ntohl(ext->output_zero_point));
     }
+
+    model_info = el_model_info_t{.id          = model_id,
+                                 .type        = static_cast<el_algorithm_type_t>(model_type),
+                                 .addr_flash  = __partition_start_addr + static_cast<uint32_t>(offset),
+                                 .size        = static_cast<uint32_t>(model_size - ext_size),
+                                 .addr_memory = mem_addr + sizeof(el_model_header_t) + ext_size};
+    return true;
 }
 
 void Models::m_seek_plain_models_from_flash() {
@@ -133,7 +356,7 @@ void Models::m_seek_plain_models_from_flash() {
 
         __model_info.emplace_front(el_model_info_t{.id          = model_id,
                                                    .type        = EL_ALGO_TYPE_UNDEFINED,
-                                                   .addr_flash  = __partition_start_addr + it,
+                                                   .addr_flash  = static_cast<uint32_t>(__partition_start_addr + it),
                                                    .size        = 0u,
                                                    .addr_memory = mem_addr});
         __model_id_mask |= (1u << model_id);
@@ -143,21 +366,16 @@ void Models::m_seek_plain_models_from_flash() {
 bool Models::has_model(el_model_id_t model_id) const { return __model_id_mask & (1u << model_id); }
 
 el_err_code_t Models::get(el_model_id_t model_id, el_model_info_t& model_info) const {
-    auto it = std::find_if(
-      __model_info.begin(), __model_info.end(), [&](const el_model_info_t& v) { return v.id == model_id; });
-    if (it != __model_info.end()) [[likely]] {
-        model_info = *it;
+    if (model_id <= EL_MODEL_INDEX_ENTRIES_MAX && __model_info_index[model_id]) [[likely]] {
+        model_info = *__model_info_index[model_id];
         return EL_OK;
     }
     return EL_EINVAL;
 }
 
 el_model_info_t Models::get_model_info(el_model_id_t model_id) const {
-    auto it = std::find_if(
-      __model_info.begin(), __model_info.end(), [&](const el_model_info_t& v) { return v.id == model_id; });
-    if (it != __model_info.end()) [[likely]] {
-        return *it;
-    }
+    if (model_id <= EL_MODEL_INDEX_ENTRIES_MAX && __model_info_index[model_id]) [[likely]]
+        return *__model_info_index[model_id];
     return {};
 }
 
@@ -48,6 +48,9 @@ class Models {
     Models& operator=(const Models&) = delete;
 
     el_err_code_t init(el_model_format_v model_format = EL_MODEL_FMT_PACKED_TFLITE | EL_MODEL_FMT_PLAIN_TFLITE);
+    // models are restored from the index if it is still valid, otherwise the partition is scanned
+    el_err_code_t init(const el_model_index_t& index,
+                       el_model_format_v       model_format = EL_MODEL_FMT_PACKED_TFLITE | EL_MODEL_FMT_PLAIN_TFLITE);
     void          deinit();
 
     std::size_t                               seek_models_from_flash(const el_model_format_v& model_format);
@@ -57,10 +60,23 @@ class Models {
     const std::forward_list<el_model_info_t>& get_all_model_info() const;
     std::size_t                               get_all_model_info_size() const;
 
+    bool             load_index(const el_model_index_t& index, const el_model_format_v& model_format);
+    el_model_index_t get_index() const;
+
+    el_model_meta_t get_model_meta(el_model_id_t model_id) const;
+    // finishes the verification of a model synchronously, returns the cached state if it was verified
+    el_model_verify_t verify(el_model_id_t model_id);
+    // checks at most max_bytes of a pending model, returns false if no model is pending
+    bool verify_step(std::size_t max_bytes = CONFIG_EL_MODEL_VERIFY_CHUNK_BYTES);
+
    protected:
     Models();
-    void m_seek_packed_models_from_flash();
-    void m_seek_plain_models_from_flash();
+    void     m_seek_packed_models_from_flash();
+    void     m_seek_plain_models_from_flash();
+    bool     m_parse_packed_model(std::size_t offset, el_model_info_t& model_info, el_model_meta_t& model_meta) const;
+    void     m_verify_chunk(el_model_id_t model_id, std::size_t max_bytes);
+    void     m_update_model_info_index();
+    bool     m_get_partition_signature(uint32_t& signature) const;
 
    private:
     uint32_t                           __partition_start_addr;
@@ -68,7 +84,12 @@ class Models {
     const uint8_t*                     __flash_2_memory_map;
     uint32_t                           __mmap_handler;
     uint16_t                           __model_id_mask;
+    el_model_format_v                  __model_format;
     std::forward_list<el_model_info_t> __model_info;
+    const el_model_info_t*             __model_info_index[EL_MODEL_INDEX_ENTRIES_MAX + 1];  // indexed by model id
+    el_model_meta_t                    __model_meta[EL_MODEL_INDEX_ENTRIES_MAX + 1];
+    uint32_t                           __verify_offset[EL_MODEL_INDEX_ENTRIES_MAX + 1];
+    uint32_t                           __verify_crc[EL_MODEL_INDEX_ENTRIES_MAX + 1];
 };
 
 }  // namespace edgelab
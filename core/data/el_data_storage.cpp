@@ -27,6 +27,8 @@
 
 #if CONFIG_EL_STORAGE
 
+    #include "porting/el_misc.h"
+
 namespace edgelab {
 
 Storage* Storage::get_ptr() {
@@ -35,7 +37,14 @@ Storage* Storage::get_ptr() {
 }
 
     #if CONFIG_EL_LIB_FLASHDB
+        #if CONFIG_EL_STORAGE_CACHE
+Storage::Storage()
+    : __lock(), __kvdb(new fdb_kvdb{}), __cache(), __cache_size(0), __dirty_count(0), __dirty_since(0) {
+    EL_ASSERT(__kvdb);
+}
+        #else
 Storage::Storage() : __lock(), __kvdb(new fdb_kvdb{}) { EL_ASSERT(__kvdb); }
+        #endif
     #else
 Storage::Storage() : __lock() {}
     #endif
@@ -45,6 +54,15 @@ Storage::~Storage() { deinit(); };
 el_err_code_t Storage::init(const char* name, const char* path) {
     const Guard<Mutex> guard(__lock);
     #if CONFIG_EL_LIB_FLASHDB
+        #ifdef FDB_USING_FILE_MODE
+    // in file mode the path is a directory, each sector is stored as a file in it
+    bool     file_mode = true;
+    uint32_t sec_size  = FDB_BLOCK_SIZE;
+    uint32_t max_size  = CONFIG_EL_STORAGE_PARTITION_FS_SIZE_0;
+    fdb_kvdb_control(__kvdb, FDB_KVDB_CTRL_SET_FILE_MODE, &file_mode);
+    fdb_kvdb_control(__kvdb, FDB_KVDB_CTRL_SET_SEC_SIZE, &sec_size);
+    fdb_kvdb_control(__kvdb, FDB_KVDB_CTRL_SET_MAX_SIZE, &max_size);
+        #endif
     return fdb_kvdb_init(__kvdb, name, path, nullptr, nullptr) == FDB_NO_ERR ? EL_OK : EL_EINVAL;
     #else
     return EL_OK;
@@ -54,6 +72,12 @@ el_err_code_t Storage::init(const char* name, const char* path) {
 void Storage::deinit() {
     const Guard<Mutex> guard(__lock);
     #if CONFIG_EL_LIB_FLASHDB
+        #if CONFIG_EL_STORAGE_CACHE
+    if (__kvdb) [[likely]] {
+        m_sync();
+        m_clear_cache();
+    }
+        #endif
     if (__kvdb && (fdb_kvdb_deinit(__kvdb) == FDB_NO_ERR)) [[likely]] {
         delete __kvdb;
         __kvdb = nullptr;
@@ -63,9 +87,16 @@ void Storage::deinit() {
 
 bool Storage::contains(const char* key) const {
     const Guard<Mutex> guard(__lock);
+    return m_contains(key);
+}
+
+bool Storage::m_contains(const char* key) const {
     #if CONFIG_EL_LIB_FLASHDB
     if (!key || !__kvdb) [[unlikely]]
         return false;
+        #if CONFIG_EL_STORAGE_CACHE
+    if (m_find_cache(key)) return true;
+        #endif
     fdb_kv kv{};
     return find_kv(__kvdb, key, &kv);
     #else
@@ -76,6 +107,11 @@ bool Storage::contains(const char* key) const {
 size_t Storage::get_value_size(const char* key) const {
     const Guard<Mutex> guard(__lock);
     #if CONFIG_EL_LIB_FLASHDB
+    if (!key || !__kvdb) [[unlikely]]
+        return 0u;
+        #if CONFIG_EL_STORAGE_CACHE
+    if (const auto* entry = m_find_cache(key); entry) return entry->size;
+        #endif
     fdb_kv   handler{};
     fdb_kv_t p_handler = fdb_kv_get_obj(__kvdb, key, &handler);
     if (!p_handler || !p_handler->value_len) [[unlikely]]
@@ -87,15 +123,55 @@ size_t Storage::get_value_size(const char* key) const {
     #endif
 }
 
-Storage::Iterator Storage::begin() { return Iterator(this); }
+bool Storage::sync(uint32_t delay_ms) const {
+    const Guard<Mutex> guard(__lock);
+    #if CONFIG_EL_LIB_FLASHDB && CONFIG_EL_STORAGE_CACHE
+    if (!__dirty_count || !__kvdb) [[likely]]
+        return true;
+    auto now = el_get_time_ms();
+    if (now - __dirty_since < delay_ms) return true;
+    if (m_sync()) [[likely]]
+        return true;
+    __dirty_since = now;  // retry the failed writes after another delay
+    return false;
+    #else
+    return true;
+    #endif
+}
+
+bool Storage::is_dirty() const {
+    const Guard<Mutex> guard(__lock);
+    #if CONFIG_EL_LIB_FLASHDB && CONFIG_EL_STORAGE_CACHE
+    return __dirty_count != 0;
+    #else
+    return false;
+    #endif
+}
+
+// keys are listed from the flash, the cached writes are committed first by both begin() and cbegin()
+Storage::Iterator Storage::begin() {
+    sync();
+    return Iterator(this);
+}
 Storage::Iterator Storage::end() { return Iterator(nullptr); }
-Storage::Iterator Storage::cbegin() const { return Iterator(this); }
+Storage::Iterator Storage::cbegin() const {
+    sync();
+    return Iterator(this);
+}
 Storage::Iterator Storage::cend() const { return Iterator(nullptr); }
 
 bool Storage::erase(const char* key) {
     const Guard<Mutex> guard(__lock);
     #if CONFIG_EL_LIB_FLASHDB
+    if (!key || !__kvdb) [[unlikely]]
+        return false;
+        #if CONFIG_EL_STORAGE_CACHE
+    // a key only written to the cache is not in the flash yet
+    bool is_cached = m_drop_cache(key);
+    return (fdb_kv_del(__kvdb, key) == FDB_NO_ERR) | is_cached;
+        #else
     return fdb_kv_del(__kvdb, key) == FDB_NO_ERR;
+        #endif
     #else
     return true;
     #endif
@@ -106,6 +182,9 @@ void Storage::clear() {
     #if CONFIG_EL_LIB_FLASHDB
     if (!__kvdb) [[unlikely]]
         return;
+        #if CONFIG_EL_STORAGE_CACHE
+    m_clear_cache();
+        #endif
     struct fdb_kv_iterator iterator;
     fdb_kv_iterator_init(__kvdb, &iterator);
     while (fdb_kv_iterate(__kvdb, &iterator)) fdb_kv_del(__kvdb, iterator.curr_kv.name);
@@ -115,12 +194,162 @@ void Storage::clear() {
 bool Storage::reset() {
     const Guard<Mutex> guard(__lock);
     #if CONFIG_EL_LIB_FLASHDB
+        #if CONFIG_EL_STORAGE_CACHE
+    m_clear_cache();
+        #endif
     return __kvdb ? fdb_kv_set_default(__kvdb) == FDB_NO_ERR : false;
     #else
     return true;
     #endif
 }
 
+bool Storage::m_get(const char* key, void* value, size_t size) const {
+    const Guard<Mutex> guard(__lock);
+    #if CONFIG_EL_LIB_FLASHDB
+    if (!key || !value || !size || !__kvdb) [[unlikely]]
+        return false;
+
+        #if CONFIG_EL_STORAGE_CACHE
+    if (const auto* entry = m_find_cache(key); entry) {
+        std::memcpy(value, entry->value, std::min(size, entry->size));
+        return true;
+    }
+        #endif
+
+    fdb_kv   handler{};
+    fdb_kv_t p_handler = fdb_kv_get_obj(__kvdb, key, &handler);
+    if (!p_handler || !p_handler->value_len) [[unlikely]]
+        return false;
+
+    // the blob is bounded by the size of the buffer, so the value is read into the buffer of the caller directly
+    fdb_blob blob{};
+    size_t   len = std::min(size, static_cast<size_t>(p_handler->value_len));
+    return fdb_blob_read(reinterpret_cast<fdb_db_t>(__kvdb),
+                         fdb_kv_to_blob(p_handler, fdb_blob_make(&blob, value, len))) == len;
+    #else
+    return true;
+    #endif
+}
+
+bool Storage::m_emplace(const char* key, const void* value, size_t size) {
+    const Guard<Mutex> guard(__lock);
+    return m_set(key, value, size);
+}
+
+bool Storage::m_try_emplace(const char* key, const void* value, size_t size) {
+    const Guard<Mutex> guard(__lock);
+    if (!key || m_contains(key)) return false;
+    return m_set(key, value, size);
+}
+
+bool Storage::m_set(const char* key, const void* value, size_t size) {
+    #if CONFIG_EL_LIB_FLASHDB
+    if (!key || !value || !size || !__kvdb) [[unlikely]]
+        return false;
+
+        #if CONFIG_EL_STORAGE_CACHE
+    auto mark_dirty = [this](CacheEntry& entry) {
+        if (entry.dirty) return;
+        entry.dirty = true;
+        if (!__dirty_count++) __dirty_since = el_get_time_ms();
+    };
+
+    // a write of the cached value is dropped, a write of the same size is updated in place
+    if (auto* entry = const_cast<CacheEntry*>(m_find_cache(key)); entry) {
+        if (entry->size == size) {
+            if (std::memcmp(entry->value, value, size) != 0) {
+                std::memcpy(entry->value, value, size);
+                mark_dirty(*entry);
+            }
+            return true;
+        }
+        m_drop_cache(key);
+    }
+
+    // the size of the cache includes the entries, once it is full the cached writes are committed and evicted
+    size_t entry_size = sizeof(CacheEntry) + size;
+    bool   cacheable  = entry_size <= CONFIG_EL_STORAGE_CACHE_SIZE_MAX && std::strlen(key) < FDB_KV_NAME_MAX;
+    if (cacheable && __cache_size + entry_size > CONFIG_EL_STORAGE_CACHE_SIZE_MAX) {
+        cacheable = m_sync();
+        if (cacheable) [[likely]]
+            m_clear_cache();
+    }
+
+    if (cacheable) [[likely]] {
+        auto& entry = __cache.emplace_front();
+        std::strncpy(entry.key, key, sizeof(entry.key) - 1);
+        entry.key[sizeof(entry.key) - 1] = '\0';
+        entry.value                      = new uint8_t[size]{};
+        entry.size                       = size;
+        entry.dirty                      = false;
+        __cache_size += entry_size;
+
+        // the stored value is compared once, writes of the value already in the flash are dropped
+        fdb_kv   handler{};
+        fdb_kv_t p_handler = fdb_kv_get_obj(__kvdb, key, &handler);
+        fdb_blob blob{};
+        if (!p_handler || p_handler->value_len != size ||
+            fdb_blob_read(reinterpret_cast<fdb_db_t>(__kvdb),
+                          fdb_kv_to_blob(p_handler, fdb_blob_make(&blob, entry.value, size))) != size ||
+            std::memcmp(entry.value, value, size) != 0) {
+            std::memcpy(entry.value, value, size);
+            mark_dirty(entry);
+        }
+        return true;
+    }
+        #endif
+
+    fdb_blob blob{};
+    return fdb_kv_set_blob(__kvdb, key, fdb_blob_make(&blob, value, size)) == FDB_NO_ERR;
+    #else
+    return true;
+    #endif
+}
+
+    #if CONFIG_EL_LIB_FLASHDB && CONFIG_EL_STORAGE_CACHE
+const Storage::CacheEntry* Storage::m_find_cache(const char* key) const {
+    for (const auto& entry : __cache)
+        if (std::strncmp(entry.key, key, sizeof(entry.key)) == 0) return &entry;
+    return nullptr;
+}
+
+bool Storage::m_sync() const {
+    bool is_ok = true;
+    for (auto& entry : __cache) {
+        if (!entry.dirty) continue;
+        fdb_blob blob{};
+        if (fdb_kv_set_blob(__kvdb, entry.key, fdb_blob_make(&blob, entry.value, entry.size)) != FDB_NO_ERR)
+            [[unlikely]] {
+            is_ok = false;
+            continue;
+        }
+        entry.dirty = false;
+        --__dirty_count;
+    }
+    return is_ok;
+}
+
+bool Storage::m_drop_cache(const char* key) {
+    bool is_cached = false;
+    __cache.remove_if([this, key, &is_cached](const CacheEntry& entry) {
+        if (std::strncmp(entry.key, key, sizeof(entry.key)) != 0) return false;
+        if (entry.dirty) --__dirty_count;
+        __cache_size -= sizeof(CacheEntry) + entry.size;
+        delete[] entry.value;
+        is_cached = true;
+        return true;
+    });
+    return is_cached;
+}
+
+void Storage::m_clear_cache() {
+    for (auto& entry : __cache) delete[] entry.value;
+    __cache.clear();
+    __cache_size  = 0;
+    __dirty_count = 0;
+}
+    #endif
+
 }  // namespace edgelab
 
 #endif
@@ -93,57 +93,54 @@ static constexpr inline uint32_t djb2_hash(const uint8_t* bytes) {
     return hash;
 }
 
+// same as djb2_hash() over the bytes of the string, usable in constant expressions (no reinterpret_cast)
+static constexpr inline uint32_t djb2_hash(const char* str) {
+    uint32_t hash = 0x1505;
+    uint8_t  byte{};
+    while ((byte = static_cast<uint8_t>(*str++))) hash = ((hash << 5) + hash) + byte;
+    return hash;
+}
+
 template <typename T> static inline constexpr const char* get_type_name() { return __PRETTY_FUNCTION__; }
 
-// currently we're not going to manage the life time of the key chars, and std::type_info is unavailable (due to -fno-rtti)
-//      1. you can free the buffer using delete[] if you don't need to use the same key anymore (if not, program will crash)
-//      2. personally I don't think it a good idea to let el_storage_kv_t to manage the lifetime of the key:
-//          a. too compilcate to use const difference to determine whether to delete the key (need to set to nullptr while copy/assign, etc.)
-//          b. not wise to use a bool flag to dertermine whether to delete the key (because copy/assign would be a continuation of the key)
-template <typename VarType, typename ValueTypeNoCV = typename std::remove_cv<VarType>::type>
-static inline el_storage_kv_t<ValueTypeNoCV> el_make_storage_kv_from_type(VarType&& data) {
-    using VarTypeNoCVRef               = typename std::remove_cv<typename std::remove_reference<VarType>::type>::type;
-    const char*          type_name     = get_type_name<VarTypeNoCVRef>();
-    uint32_t             hash          = djb2_hash(reinterpret_cast<const uint8_t*>(type_name));
-    char*                static_buffer = nullptr;
-    static const char*   hex_literals  = "0123456789ABCDEF";
-    static const char*   key_header    = "edgelab#type_name#";
-    static const uint8_t header_size   = std::strlen(key_header);
-    static const uint8_t buffer_size   = [&]() -> uint8_t {
-        // 8 for hash hex (uint32_t), 1 for terminator, -1 for bit hacks (remove last 1 in binary)
-        uint8_t len = static_cast<uint8_t>(header_size + (sizeof(hash) << 1) + 1u - 1u);
-        len |= len >> 1;
-        len |= len >> 2;
-        len |= len >> 4;
-        return ++len;  // the nearest power of 2 value to key length
-    }();
-    static std::forward_list<std::pair<unsigned long, char*>> hash_list{};
-    auto it{std::find_if(hash_list.begin(), hash_list.end(), [&](const std::pair<unsigned long, char*>& pair) {
-        return pair.first == hash;
-    })};
-    if (it != hash_list.end())
-        static_buffer = it->second;
-    else {
-        static_buffer = new char[buffer_size]{};     // we're not going to delete it
-        std::memset(static_buffer, 0, buffer_size);  // not trust initializer
-        std::memcpy(static_buffer, key_header, header_size);
-        union hex_fmt {
-            uint32_t i;
-            uint8_t  o[sizeof(uint32_t)];
-            hex_fmt(uint32_t n) : i(__builtin_bswap32(n)) {}  // assuming n is little-endian, not platform consistent
-        };
-        hex_fmt   f{hash};  // wtf snprinf crashes the program, skip use that
-        uint16_t* fmt_ptr = reinterpret_cast<uint16_t*>(static_buffer + header_size);
-        for (uint8_t i = 0; i < sizeof(decltype(hex_fmt::i)); ++i)
-            fmt_ptr[i] = (hex_literals[f.o[i] & 0x0f] << 8) | hex_literals[f.o[i] >> 4];
+namespace storage_type_key {
 
-        hash_list.emplace_front(hash, static_buffer);
-    }
+constexpr char        KEY_HEADER[]   = "edgelab#type_name#";
+constexpr std::size_t KEY_HEADER_LEN = sizeof(KEY_HEADER) - 1;
+// header, 8 hex digits of the hash (uint32_t) and the terminator, rounded up to a power of 2
+constexpr std::size_t KEY_BUFFER_SIZE = 32;
+
+static_assert(KEY_HEADER_LEN + (sizeof(uint32_t) << 1) + 1 <= KEY_BUFFER_SIZE);
+    #if CONFIG_EL_LIB_FLASHDB
+static_assert(KEY_BUFFER_SIZE <= FDB_KV_NAME_MAX);
+    #endif
+
+struct Key {
+    char str[KEY_BUFFER_SIZE];
+};
+
+// keys are formatted as the header followed by the hash in upper case hex (most significant digit first), stored keys
+// of the previous runtime formatter are kept compatible
+static constexpr inline Key make_key(uint32_t hash) {
+    constexpr char hex_literals[] = "0123456789ABCDEF";
+    Key            key{};
+    for (std::size_t i = 0; i < KEY_HEADER_LEN; ++i) key.str[i] = KEY_HEADER[i];
+    for (std::size_t i = 0; i < (sizeof(hash) << 1); ++i)
+        key.str[KEY_HEADER_LEN + i] = hex_literals[(hash >> (28u - (i << 2))) & 0x0f];
+    return key;
+}
+
+// one key per type, generated at compile time and stored in read-only data
+template <typename T> struct TypeKey {
+    static constexpr Key value = make_key(djb2_hash(get_type_name<T>()));
+};
 
-    EL_ASSERT(static_buffer != nullptr);
-    EL_ASSERT(buffer_size <= FDB_KV_NAME_MAX);
+}  // namespace storage_type_key
 
-    return el_make_storage_kv(static_buffer, std::forward<VarType>(data));
+template <typename VarType, typename ValueTypeNoCV = typename std::remove_cv<VarType>::type>
+static inline el_storage_kv_t<ValueTypeNoCV> el_make_storage_kv_from_type(VarType&& data) {
+    using VarTypeNoCVRef = typename std::remove_cv<typename std::remove_reference<VarType>::type>::type;
+    return el_make_storage_kv(storage_type_key::TypeKey<VarTypeNoCVRef>::value.str, std::forward<VarType>(data));
 }
 
 }  // namespace utility
@@ -239,33 +236,13 @@ class Storage {
 
     bool contains(const char* key) const;
 
-    // size of the buffer should be equal to handler->value_len
+    // the value is read into the buffer of the kv directly, at most kv.size bytes are read
     template <typename ValueType, typename std::enable_if<!std::is_const<ValueType>::value>::type* = nullptr>
     bool get(types::el_storage_kv_t<ValueType>& kv) const {
-        const Guard<Mutex> guard(__lock);
-    #if CONFIG_EL_LIB_FLASHDB
-        if (!kv.size || !__kvdb) [[unlikely]]
-            return false;
-
-        fdb_kv   handler{};
-        fdb_kv_t p_handler = fdb_kv_get_obj(__kvdb, kv.key, &handler);
-        if (!p_handler || !p_handler->value_len) [[unlikely]]
-            return false;
-
-        // TODO: skip allocate buffer if the value_len is equal to kv.size
-        unsigned char* buffer = new unsigned char[p_handler->value_len];
-        fdb_blob       blob{};
-        fdb_blob_read(reinterpret_cast<fdb_db_t>(__kvdb),
-                      fdb_kv_to_blob(p_handler, fdb_blob_make(&blob, buffer, p_handler->value_len)));
         if constexpr (std::is_pointer<ValueType>::value)
-            std::memcpy(kv.value, buffer, std::min(kv.size, static_cast<size_t>(p_handler->value_len)));
+            return m_get(kv.key, kv.value, kv.size);
         else
-            std::memcpy(&kv.value, buffer, std::min(kv.size, static_cast<size_t>(p_handler->value_len)));
-        
-        delete[] buffer;
-    #endif
-
-        return true;
+            return m_get(kv.key, &kv.value, kv.size);
     }
 
     template <typename ValueType,
@@ -300,17 +277,12 @@ class Storage {
         return *this;
     }
 
+    // the value is written back to the flash later if the cache is enabled, call sync() to commit it
     template <typename ValueType> bool emplace(const types::el_storage_kv_t<ValueType>& kv) {
-        const Guard<Mutex> guard(__lock);
-    #if CONFIG_EL_LIB_FLASHDB
-        fdb_blob blob{};
         if constexpr (std::is_pointer<ValueType>::value)
-            return fdb_kv_set_blob(__kvdb, kv.key, fdb_blob_make(&blob, kv.value, kv.size)) == FDB_NO_ERR;
+            return m_emplace(kv.key, kv.value, kv.size);
         else
-            return fdb_kv_set_blob(__kvdb, kv.key, fdb_blob_make(&blob, &kv.value, kv.size)) == FDB_NO_ERR;
-    #else
-        return true;
-    #endif
+            return m_emplace(kv.key, &kv.value, kv.size);
     }
 
     template <typename KVType> Storage& operator<<(KVType&& kv) {
@@ -320,20 +292,18 @@ class Storage {
         return *this;
     }
 
+    // the key is checked and written under one lock, so that a concurrent write of the key is never overwritten
     template <typename ValueType> bool try_emplace(const types::el_storage_kv_t<ValueType>& kv) {
-        const Guard<Mutex> guard(__lock);
-    #if CONFIG_EL_LIB_FLASHDB
-        if (!kv.key || !__kvdb) [[unlikely]]
-            return false;
-        fdb_kv kv_{};
-        if (find_kv(__kvdb, kv.key, &kv_)) return false;
-        fdb_blob blob{};
-        return fdb_kv_set_blob(__kvdb, kv.key, fdb_blob_make(&blob, &kv.value, kv.size)) == FDB_NO_ERR;
-    #else
-        return true;
-    #endif
+        if constexpr (std::is_pointer<ValueType>::value)
+            return m_try_emplace(kv.key, kv.value, kv.size);
+        else
+            return m_try_emplace(kv.key, &kv.value, kv.size);
     }
 
+    // commits the cached writes once the oldest one is at least delay_ms old, returns false if any write failed
+    bool sync(uint32_t delay_ms = 0) const;
+    bool is_dirty() const;
+
     Iterator begin();
     Iterator end();
     Iterator cbegin() const;
@@ -346,10 +316,38 @@ class Storage {
    protected:
     Storage();
 
+    bool m_get(const char* key, void* value, size_t size) const;
+    bool m_emplace(const char* key, const void* value, size_t size);
+    bool m_try_emplace(const char* key, const void* value, size_t size);
+    // unlocked, the callers hold the lock
+    bool m_contains(const char* key) const;
+    bool m_set(const char* key, const void* value, size_t size);
+
+    #if CONFIG_EL_LIB_FLASHDB && CONFIG_EL_STORAGE_CACHE
+    struct CacheEntry {
+        char     key[FDB_KV_NAME_MAX];
+        uint8_t* value;
+        size_t   size;
+        bool     dirty;
+    };
+
+    const CacheEntry* m_find_cache(const char* key) const;
+    bool              m_sync() const;
+    bool              m_drop_cache(const char* key);
+    void              m_clear_cache();
+    #endif
+
    private:
     Mutex __lock;
     #if CONFIG_EL_LIB_FLASHDB
     fdb_kvdb_t __kvdb;
+        #if CONFIG_EL_STORAGE_CACHE
+    // the cached writes are committed by the const readers of the flash (e.g. cbegin()) as well
+    mutable std::forward_list<CacheEntry> __cache;
+    size_t                                __cache_size;
+    mutable size_t                        __dirty_count;
+    mutable uint64_t                      __dirty_since;
+        #endif
     #endif
 };
 
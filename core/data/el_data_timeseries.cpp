@@ -0,0 +1,165 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2023 Seeed Technology Co.,Ltd
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#include "el_data_timeseries.h"
+
+#if CONFIG_EL_TSDB
+
+    #include "core/el_debug.h"
+    #include "core/synchronize/el_guard.hpp"
+    #include "porting/el_misc.h"
+
+namespace edgelab {
+
+static_assert(sizeof(fdb_time_t) >= sizeof(int64_t), "TimeSeries requires FDB_USING_TIMESTAMP_64BIT");
+
+namespace {
+
+fdb_time_t _get_time() { return TimeSeries::get_ptr()->get_time(); }
+
+struct QueryArgs {
+    fdb_tsdb_t                  tsdb;
+    uint8_t*                    buffer;
+    const TimeSeries::Callback* callback;
+    std::size_t                 count;
+};
+
+bool _query_callback(fdb_tsl_t tsl, void* arg) {
+    auto* args = static_cast<QueryArgs*>(arg);
+    if (tsl->status != FDB_TSL_WRITE) [[unlikely]]
+        return false;
+
+    std::size_t size = tsl->log_len < CONFIG_EL_TSDB_LOG_SIZE_MAX ? tsl->log_len : CONFIG_EL_TSDB_LOG_SIZE_MAX;
+    fdb_blob    blob{};
+    size = fdb_blob_read(reinterpret_cast<fdb_db_t>(args->tsdb),
+                         fdb_tsl_to_blob(tsl, fdb_blob_make(&blob, args->buffer, size)));
+    ++args->count;
+
+    return !(*args->callback)(tsl->time, args->buffer, size);  // FlashDB stops the iteration on true
+}
+
+}  // namespace
+
+TimeSeries* TimeSeries::get_ptr() {
+    static TimeSeries time_series{};
+    return &time_series;
+}
+
+TimeSeries::TimeSeries()
+    : __lock(),
+      __tsdb(new fdb_tsdb{}),
+      __is_ready(false),
+      __time_base(0),
+      __buffer(new uint8_t[CONFIG_EL_TSDB_LOG_SIZE_MAX]{}) {
+    EL_ASSERT(__tsdb);
+    EL_ASSERT(__buffer);
+}
+
+TimeSeries::~TimeSeries() {
+    deinit();
+    delete[] __buffer;
+    __buffer = nullptr;
+}
+
+el_err_code_t TimeSeries::init(const char* name, const char* path) {
+    const Guard<Mutex> guard(__lock);
+    if (!__tsdb) [[unlikely]]
+        return EL_EPERM;
+    if (__is_ready) [[unlikely]]
+        return EL_OK;
+    #ifdef FDB_USING_FILE_MODE
+    // in file mode the path is a directory, each sector is stored as a file in it
+    bool     file_mode = true;
+    uint32_t sec_size  = FDB_BLOCK_SIZE;
+    uint32_t max_size  = CONFIG_EL_TSDB_PARTITION_SIZE;
+    fdb_tsdb_control(__tsdb, FDB_TSDB_CTRL_SET_FILE_MODE, &file_mode);
+    fdb_tsdb_control(__tsdb, FDB_TSDB_CTRL_SET_SEC_SIZE, &sec_size);
+    fdb_tsdb_control(__tsdb, FDB_TSDB_CTRL_SET_MAX_SIZE, &max_size);
+    #endif
+    if (fdb_tsdb_init(__tsdb, name, path, _get_time, CONFIG_EL_TSDB_LOG_SIZE_MAX, nullptr) != FDB_NO_ERR) [[unlikely]]
+        return EL_EIO;
+
+    fdb_time_t last_time = 0;
+    fdb_tsdb_control(__tsdb, FDB_TSDB_CTRL_GET_LAST_TIME, &last_time);
+    __time_base = static_cast<int64_t>(last_time) + 1;
+    __is_ready  = true;
+
+    return EL_OK;
+}
+
+void TimeSeries::deinit() {
+    const Guard<Mutex> guard(__lock);
+    if (__is_ready && fdb_tsdb_deinit(__tsdb) == FDB_NO_ERR) [[likely]]
+        __is_ready = false;
+}
+
+int64_t TimeSeries::get_time() const { return __time_base + static_cast<int64_t>(el_get_time_ms()); }
+
+int64_t TimeSeries::get_last_time() const {
+    const Guard<Mutex> guard(__lock);
+    if (!__is_ready) [[unlikely]]
+        return 0;
+    fdb_time_t last_time = 0;
+    fdb_tsdb_control(__tsdb, FDB_TSDB_CTRL_GET_LAST_TIME, &last_time);
+    return last_time;
+}
+
+el_err_code_t TimeSeries::append(const void* data, std::size_t size, int64_t time) {
+    const Guard<Mutex> guard(__lock);
+    if (!__is_ready) [[unlikely]]
+        return EL_EPERM;
+    if (!data || !size || size > CONFIG_EL_TSDB_LOG_SIZE_MAX) [[unlikely]]
+        return EL_EINVAL;
+
+    fdb_blob blob{};
+    return fdb_tsl_append_with_ts(__tsdb, fdb_blob_make(&blob, data, size), time) == FDB_NO_ERR ? EL_OK : EL_EIO;
+}
+
+std::size_t TimeSeries::query(int64_t from, int64_t to, const Callback& callback) const {
+    const Guard<Mutex> guard(__lock);
+    if (!__is_ready || !callback || from > to) [[unlikely]]
+        return 0u;
+
+    auto args = QueryArgs{.tsdb = __tsdb, .buffer = __buffer, .callback = &callback, .count = 0u};
+    fdb_tsl_iter_by_time(__tsdb, from, to, _query_callback, &args);
+    return args.count;
+}
+
+std::size_t TimeSeries::count(int64_t from, int64_t to) const {
+    const Guard<Mutex> guard(__lock);
+    if (!__is_ready || from > to) [[unlikely]]
+        return 0u;
+    return fdb_tsl_query_count(__tsdb, from, to, FDB_TSL_WRITE);
+}
+
+void TimeSeries::clear() {
+    const Guard<Mutex> guard(__lock);
+    if (__is_ready) [[likely]]
+        fdb_tsl_clean(__tsdb);
+}
+
+}  // namespace edgelab
+
+#endif
@@ -0,0 +1,84 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2023 Seeed Technology Co.,Ltd
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#ifndef _EL_DATA_TIMESERIES_H_
+#define _EL_DATA_TIMESERIES_H_
+
+#include "core/el_config_internal.h"
+
+#if CONFIG_EL_TSDB
+
+    #include <cstddef>
+    #include <cstdint>
+    #include <functional>
+
+    #include "core/el_types.h"
+    #include "core/synchronize/el_mutex.hpp"
+    #include "third_party/FlashDB/flashdb.h"
+
+namespace edgelab {
+
+// logs with timestamps in milliseconds, the oldest logs are overwritten once the partition is full
+class TimeSeries {
+   public:
+    // returns false to stop the iteration
+    using Callback = std::function<bool(int64_t time, const uint8_t* data, std::size_t size)>;
+
+    [[nodiscard]] static TimeSeries* get_ptr();
+
+    ~TimeSeries();
+
+    TimeSeries(const TimeSeries&)            = delete;
+    TimeSeries& operator=(const TimeSeries&) = delete;
+
+    el_err_code_t init(const char* name = CONFIG_EL_TSDB_NAME, const char* path = CONFIG_EL_TSDB_PATH);
+    void          deinit();
+
+    // the clock continues from the last log after reboot, so that the time keeps increasing across boots
+    int64_t get_time() const;
+    int64_t get_last_time() const;
+
+    // time of the logs must be strictly increasing, the log is dropped otherwise
+    el_err_code_t append(const void* data, std::size_t size, int64_t time);
+    std::size_t   query(int64_t from, int64_t to, const Callback& callback) const;
+    std::size_t   count(int64_t from, int64_t to) const;
+    void          clear();
+
+   protected:
+    TimeSeries();
+
+   private:
+    mutable Mutex __lock;
+    fdb_tsdb_t    __tsdb;
+    bool          __is_ready;
+    int64_t       __time_base;
+    uint8_t*      __buffer;
+};
+
+}  // namespace edgelab
+
+#endif
+
+#endif
@@ -91,12 +91,35 @@
     #define CONFIG_EL_MODEL_PARTITION_NAME  "models"
     #define CONFIG_EL_MODEL_SEEK_STEP_BYTES sizeof(el_model_header_t)
 #endif
+#ifndef CONFIG_EL_MODEL_HEADER_EXT_MAGIC
+    #define CONFIG_EL_MODEL_HEADER_EXT_MAGIC 0x4C485458
+#endif
+#ifndef CONFIG_EL_MODEL_IMAGE_TAG_MAGIC
+    #define CONFIG_EL_MODEL_IMAGE_TAG_MAGIC 0x4C484947
+#endif
+#ifndef CONFIG_EL_MODEL_VERIFY_CHUNK_BYTES
+    #define CONFIG_EL_MODEL_VERIFY_CHUNK_BYTES (64U * 1024U)  // bytes checked per background verification step
+#endif
 
 /* sensor related config */
 #ifndef CONFIG_EL_HAS_ACCELERATED_JPEG_CODEC
     #define CONFIG_EL_HAS_ACCELERATED_JPEG_CODEC 0
 #endif
 
+/* heap accounting, counts the C++ allocations by replacing the global operator new and delete, and the el_malloc family
+ * of the porting layers routed to el_heap_malloc */
+#ifndef CONFIG_EL_HEAP_ACCOUNTING
+    #define CONFIG_EL_HEAP_ACCOUNTING 0
+#endif
+
+#ifndef CONFIG_EL_HEAP_BUDGET_ASSERT
+    #define CONFIG_EL_HEAP_BUDGET_ASSERT 0  // assert instead of warning if a frame exceeds the allocation budget
+#endif
+
+#ifndef CONFIG_EL_HEAP_BUDGET_WARMUP_FRAMES
+    #define CONFIG_EL_HEAP_BUDGET_WARMUP_FRAMES 8  // frames before the budget is checked (caches are filled)
+#endif
+
 /* third-party libraries */
 #ifndef CONFIG_EL_LIB_FLASHDB
     #define CONFIG_EL_LIB_FLASHDB 1
@@ -122,6 +145,38 @@
     #ifndef CONFIG_EL_LIB_FLASHDB
         #warning "Storage depends on FlashDB"
     #endif
+    #ifndef CONFIG_EL_STORAGE_CACHE
+        #define CONFIG_EL_STORAGE_CACHE 1  // writes are cached in RAM and committed to the flash by sync()
+    #endif
+    #ifndef CONFIG_EL_STORAGE_CACHE_SIZE_MAX
+        #define CONFIG_EL_STORAGE_CACHE_SIZE_MAX (4 * 1024)  // bytes of cache entries, larger values are written through
+    #endif
+    #ifndef CONFIG_EL_STORAGE_SYNC_DELAY_MS
+        #define CONFIG_EL_STORAGE_SYNC_DELAY_MS (2000)  // writes in this window are coalesced into one commit
+    #endif
+#endif
+
+/* time series related config, logs are kept in a FlashDB TSDB ring (FDB_USING_TSDB and a partition are required) */
+#ifndef CONFIG_EL_TSDB
+    #define CONFIG_EL_TSDB 0
+#endif
+
+#if CONFIG_EL_TSDB
+    #ifndef CONFIG_EL_TSDB_NAME
+        #define CONFIG_EL_TSDB_NAME "edgelab_tsdb"
+    #endif
+    #ifndef CONFIG_EL_TSDB_PATH
+        #define CONFIG_EL_TSDB_PATH "tsdb0"  // name of the partition, or the directory in file mode
+    #endif
+    #ifndef CONFIG_EL_TSDB_PARTITION_SIZE
+        #define CONFIG_EL_TSDB_PARTITION_SIZE (64 * 1024)
+    #endif
+    #ifndef CONFIG_EL_TSDB_LOG_SIZE_MAX
+        #define CONFIG_EL_TSDB_LOG_SIZE_MAX (1024)
+    #endif
+    #if !CONFIG_EL_LIB_FLASHDB
+        #warning "Time series depends on FlashDB"
+    #endif
 #endif
 
 #endif
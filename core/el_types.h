@@ -63,6 +63,19 @@ typedef struct EL_ATTR_PACKED el_quant_param_t {
     int32_t zero_point;
 } el_quant_param_t;
 
+// time spent on the steps of loading a model into an engine, in us
+typedef struct el_engine_load_perf_t {
+    uint32_t map;        // model flatbuffer mapped from the memory
+    uint32_t construct;  // interpreter constructed
+    uint32_t allocate;   // tensors allocated (memory planning)
+} el_engine_load_perf_t;
+
+// a view of the bytes owned by the caller, e.g. a part of a reply sent by a transport
+typedef struct el_buffer_view_t {
+    const char* data;
+    size_t      size;
+} el_buffer_view_t;
+
 typedef struct EL_ATTR_PACKED el_memory_pool_t {
     void*  pool;
     size_t size;
@@ -135,6 +148,24 @@ typedef struct EL_ATTR_PACKED el_img_t {
     el_pixel_rotate_t rotate;
 } el_img_t;
 
+typedef enum {
+    EL_JPEG_QUALITY_BEST = 0,
+    EL_JPEG_QUALITY_HIGH,
+    EL_JPEG_QUALITY_MED,
+    EL_JPEG_QUALITY_LOW,
+} el_jpeg_quality_t;
+
+typedef enum {
+    EL_JPEG_SUBSAMPLE_444 = 0,
+    EL_JPEG_SUBSAMPLE_420,
+} el_jpeg_subsample_t;
+
+typedef struct EL_ATTR_PACKED el_jpeg_config_t {
+    uint8_t  quality;    // el_jpeg_quality_t
+    uint8_t  subsample;  // el_jpeg_subsample_t
+    uint32_t max_size;   // byte budget of an encoded image, 0 for unlimited
+} el_jpeg_config_t;
+
 typedef struct EL_ATTR_PACKED el_res_t {
     uint32_t width;
     uint32_t height;
@@ -198,6 +229,42 @@ typedef union EL_ATTR_PACKED el_model_header_t {
     uint32_t      b4[2];
 } el_model_header_t;
 
+#define EL_MODEL_HEADER_VERSION_EXT 1  // value of the padding byte if an extended header follows
+
+/**
+ * @brief Model Extended Header Specification
+ * @details
+ *      follows the model header if its padding byte is EL_MODEL_HEADER_VERSION_EXT, the size in the model header
+ *      covers both the extended header and the payload (the TFLite flatbuffer), big-endian in file
+ *      fields appended by the later versions are skipped by the size of the extended header
+ */
+typedef struct EL_ATTR_PACKED el_model_header_ext_t {
+    uint32_t magic;              // CONFIG_EL_MODEL_HEADER_EXT_MAGIC
+    uint16_t size;               // size of the extended header
+    uint16_t version;            // version of the model
+    uint32_t crc32;              // CRC-32 of the payload
+    uint32_t arena_size;         // tensor arena required by the model in bytes, 0 if unknown
+    uint16_t input_shape[4];     // shape of the first input, unused dimensions are 0
+    uint16_t output_shape[4];    // shape of the first output
+    uint32_t input_scale;        // bits of the IEEE-754 float
+    int32_t  input_zero_point;
+    uint32_t output_scale;
+    int32_t  output_zero_point;
+} el_model_header_ext_t;
+
+/**
+ * @brief Models Image Tag Specification
+ * @details
+ *      optional, at the end of the models partition, written with the models image, the generation is changed each
+ *      time the image is written, so that the index of the models found in the image is validated by reading the tag
+ *      only, big-endian in file
+ */
+typedef struct EL_ATTR_PACKED el_models_image_tag_t {
+    uint32_t magic;       // CONFIG_EL_MODEL_IMAGE_TAG_MAGIC
+    uint32_t generation;  // changed each time the models image is written
+    uint32_t crc32;       // CRC-32 of the magic and the generation
+} el_models_image_tag_t;
+
 /**
  * @brief Mdoel Info Specification
  * @details
@@ -220,11 +287,61 @@ typedef struct EL_ATTR_PACKED el_model_info_t {
 
 typedef uint8_t el_model_id_t;
 
+typedef enum {
+    EL_MODEL_VERIFY_NONE = 0u,  // no checksum to verify against (plain models or models without extended header)
+    EL_MODEL_VERIFY_PENDING,
+    EL_MODEL_VERIFY_OK,
+    EL_MODEL_VERIFY_FAILED,
+} el_model_verify_t;
+
+/**
+ * @brief Model Meta Specification
+ * @details
+ *      decoded from the extended header, all zero if the model does not have one
+ */
+typedef struct el_model_meta_t {
+    el_model_verify_t verify;
+    uint16_t          version;
+    uint32_t          crc32;
+    uint32_t          arena_size;
+    uint16_t          input_shape[4];
+    uint16_t          output_shape[4];
+    el_quant_param_t  input_quant;
+    el_quant_param_t  output_quant;
+} el_model_meta_t;
+
+#define EL_MODEL_INDEX_VERSION     3
+#define EL_MODEL_INDEX_ENTRIES_MAX 15  // valid model id range [1, 15]
+
+typedef struct EL_ATTR_PACKED el_model_index_entry_t {
+    uint8_t  id;
+    uint8_t  type;
+    uint32_t offset;  // offset of the model (including the header if packed) to the partition start
+    uint32_t size;
+} el_model_index_entry_t;
+
+/**
+ * @brief Model Index Specification
+ * @details
+ *      a persisted snapshot of the models found in the partition, the index is valid if the version, the format,
+ *      the partition size and the signature (hash of the models image tag) are matched, and each entry still points
+ *      to a valid model, images without a tag are scanned on every boot
+ */
+typedef struct EL_ATTR_PACKED el_model_index_t {
+    uint8_t                version;
+    uint8_t                format;  // el_model_format_v of the scan
+    uint8_t                count;
+    uint32_t               partition_size;
+    uint32_t               signature;
+    el_model_index_entry_t entries[EL_MODEL_INDEX_ENTRIES_MAX];
+} el_model_index_t;
+
 typedef enum {
     EL_TRANSPORT_UNKNOWN = 0,
     EL_TRANSPORT_UART,
     EL_TRANSPORT_SPI,
     EL_TRANSPORT_I2C,
+    EL_TRANSPORT_MQTT,
 } el_transport_type_t;
 
 #ifdef __cplusplus
@@ -65,6 +65,11 @@ class Engine {
     virtual el_quant_param_t get_input_quant_param(size_t index) const  = 0;
     virtual el_quant_param_t get_output_quant_param(size_t index) const = 0;
 
+    // tensor arena bytes used by the loaded model, 0 if no model is loaded
+    virtual size_t get_arena_used_bytes() const = 0;
+
+    inline const el_engine_load_perf_t& get_load_perf() const { return __load_perf; }
+
 #ifdef CONFIG_EL_INFERENCER_TENSOR_NAME
     virtual size_t           get_input_index(const char* input_name) const                                = 0;
     virtual size_t           get_output_index(const char* output_name) const                              = 0;
@@ -76,6 +81,9 @@ class Engine {
     virtual el_quant_param_t get_input_quant_param(const char* input_name) const                          = 0;
     virtual el_quant_param_t get_output_quant_param(const char* output_name) const                        = 0;
 #endif
+
+   protected:
+    el_engine_load_perf_t __load_perf{};
 };
 
 }  // namespace edgelab::base
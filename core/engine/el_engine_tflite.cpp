@@ -26,6 +26,7 @@
 #include "el_engine_tflite.h"
 
 #include "core/el_debug.h"
+#include "porting/el_misc.h"
 
 #ifdef CONFIG_EL_TFLITE
 
@@ -384,7 +385,12 @@ el_err_code_t EngineTFLite::run() {
 }
 
 el_err_code_t EngineTFLite::load_model(const void* model_data, size_t model_size) {
-    model = tflite::GetModel(model_data);
+    __load_perf = el_engine_load_perf_t{};
+
+    uint64_t start_time = el_get_time_us();
+    model               = tflite::GetModel(model_data);
+    uint64_t end_time   = el_get_time_us();
+    __load_perf.map     = end_time - start_time;
     if (model == nullptr) {
         return EL_EINVAL;
     }
@@ -395,12 +401,19 @@ el_err_code_t EngineTFLite::load_model(const void* model_data, size_t model_size
         interpreter = nullptr;
     }
     #endif
+    start_time = el_get_time_us();
     interpreter =
       new tflite::MicroInterpreter(model, resolver, static_cast<uint8_t*>(memory_pool.pool), memory_pool.size);
+    end_time              = el_get_time_us();
+    __load_perf.construct = end_time - start_time;
     if (interpreter == nullptr) {
         return EL_ENOMEM;
     }
-    if (kTfLiteOk != interpreter->AllocateTensors()) {
+    start_time           = el_get_time_us();
+    auto status          = interpreter->AllocateTensors();
+    end_time             = el_get_time_us();
+    __load_perf.allocate = end_time - start_time;
+    if (kTfLiteOk != status) {
         delete interpreter;
         interpreter = nullptr;
         return EL_ELOG;
@@ -525,6 +538,8 @@ el_quant_param_t EngineTFLite::get_output_quant_param(size_t index) const {
     return quant_param;
 }
 
+size_t EngineTFLite::get_arena_used_bytes() const { return interpreter ? interpreter->arena_used_bytes() : 0; }
+
     #ifdef CONFIG_EL_FILESYSTEM
 el_err_code_t EngineTFLite::load_model(const char* model_path) {
     el_err_code_t ret  = EL_OK;
@@ -378,6 +378,8 @@ class EngineTFLite final : public base::Engine {
     el_quant_param_t get_input_quant_param(size_t index) const override;
     el_quant_param_t get_output_quant_param(size_t index) const override;
 
+    size_t get_arena_used_bytes() const override;
+
 #ifdef CONFIG_EL_INFERENCER_TENSOR_NAME
     size_t           get_input_index(const char* input_name) const override;
     size_t           get_output_index(const char* output_name) const override;
@@ -0,0 +1,118 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2023 nullptr (Seeed Technology Inc.)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#ifndef _EL_EVENT_HPP_
+#define _EL_EVENT_HPP_
+
+#include <cstdint>
+
+#include "core/el_config_internal.h"
+
+#if !CONFIG_EL_HAS_FREERTOS_SUPPORT && CONFIG_EL_PORTING_POSIX
+    #include <chrono>
+    #include <condition_variable>
+    #include <mutex>
+#elif !CONFIG_EL_HAS_FREERTOS_SUPPORT
+    #include "porting/el_misc.h"
+#endif
+
+namespace edgelab {
+
+// a binary event, set() wakes up the waiter and the event stays set until it is taken by a waiter, sets before the
+// waiter takes it are merged into one
+class Event {
+   public:
+#if CONFIG_EL_HAS_FREERTOS_SUPPORT
+    Event() noexcept : _event(xSemaphoreCreateBinary()) {}
+    ~Event() noexcept { vSemaphoreDelete(_event); }
+#elif CONFIG_EL_PORTING_POSIX
+    Event() noexcept : _lock(), _cond(), _is_set(false) {}
+    ~Event() noexcept = default;
+#else
+    Event() noexcept : _is_set(false) {}
+    ~Event() noexcept = default;
+#endif
+
+    Event(const Event&)            = delete;
+    Event& operator=(const Event&) = delete;
+
+    inline void set() const {
+#if CONFIG_EL_HAS_FREERTOS_SUPPORT
+        xSemaphoreGive(_event);
+#elif CONFIG_EL_PORTING_POSIX
+        {
+            const std::lock_guard<std::mutex> guard(_lock);
+            _is_set = true;
+        }
+        _cond.notify_one();
+#else
+        _is_set = true;
+#endif
+    }
+
+    // same as set(), but could only be called from an interrupt
+    inline void set_from_isr() const {
+#if CONFIG_EL_HAS_FREERTOS_SUPPORT
+        BaseType_t is_woken = pdFALSE;
+        xSemaphoreGiveFromISR(_event, &is_woken);
+        portYIELD_FROM_ISR(is_woken);
+#else
+        set();
+#endif
+    }
+
+    // blocks until the event is set or timeout, returns true and clears the event if it is set
+    inline bool wait(uint32_t timeout_ms) const {
+#if CONFIG_EL_HAS_FREERTOS_SUPPORT
+        return xSemaphoreTake(_event, pdMS_TO_TICKS(timeout_ms)) == pdTRUE;
+#elif CONFIG_EL_PORTING_POSIX
+        std::unique_lock<std::mutex> lock(_lock);
+        bool is_set = _cond.wait_for(lock, std::chrono::milliseconds(timeout_ms), [this] { return _is_set; });
+        _is_set     = false;
+        return is_set;
+#else
+        // no scheduler to block on, polls the flag
+        for (uint64_t start = el_get_time_ms(); !_is_set && el_get_time_ms() - start < timeout_ms;) el_sleep(1);
+        bool is_set = _is_set;
+        _is_set     = false;
+        return is_set;
+#endif
+    }
+
+   private:
+#if CONFIG_EL_HAS_FREERTOS_SUPPORT
+    mutable SemaphoreHandle_t _event;
+#elif CONFIG_EL_PORTING_POSIX
+    mutable std::mutex              _lock;
+    mutable std::condition_variable _cond;
+    mutable bool                    _is_set;
+#else
+    mutable volatile bool _is_set;
+#endif
+};
+
+}  // namespace edgelab
+
+#endif
@@ -28,6 +28,10 @@
 
 #include "core/el_config_internal.h"
 
+#if !CONFIG_EL_HAS_FREERTOS_SUPPORT && CONFIG_EL_PORTING_POSIX
+    #include <mutex>
+#endif
+
 namespace edgelab {
 
 class Mutex {
@@ -35,6 +39,9 @@ class Mutex {
 #if CONFIG_EL_HAS_FREERTOS_SUPPORT
     Mutex() noexcept : _lock(xSemaphoreCreateCounting(1, 1)) {}
     ~Mutex() noexcept { vSemaphoreDelete(_lock); }
+#elif CONFIG_EL_PORTING_POSIX
+    Mutex() noexcept : _lock() {}
+    ~Mutex() noexcept = default;
 #else
     Mutex() noexcept  = default;
     ~Mutex() noexcept = default;
@@ -43,18 +50,24 @@ class Mutex {
     inline void lock() const {
 #if CONFIG_EL_HAS_FREERTOS_SUPPORT
         xSemaphoreTake(_lock, portMAX_DELAY);
+#elif CONFIG_EL_PORTING_POSIX
+        _lock.lock();
 #endif
     }
 
     inline void unlock() const {
 #if CONFIG_EL_HAS_FREERTOS_SUPPORT
         xSemaphoreGive(_lock);
+#elif CONFIG_EL_PORTING_POSIX
+        _lock.unlock();
 #endif
     }
 
    private:
 #if CONFIG_EL_HAS_FREERTOS_SUPPORT
     mutable SemaphoreHandle_t _lock;
+#elif CONFIG_EL_PORTING_POSIX
+    mutable std::mutex _lock;
 #endif
 };
 
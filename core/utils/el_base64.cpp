@@ -67,37 +67,26 @@ void el_base64_encode_output(const unsigned char* in, int in_len, int (*putc_fun
     }
 }
 
-void el_base64_encode(const unsigned char* in, int in_len, char* out) {
-    int           i = 0;
-    int           j = 0;
-    unsigned char char_array_3[3];
-    unsigned char char_array_4[4];
-
-    while (in_len--) {
-        char_array_3[i++] = *(in++);
-        if (i == 3) {
-            char_array_4[0] = (char_array_3[0] & 0xfc) >> 2;
-            char_array_4[1] = ((char_array_3[0] & 0x03) << 4) + ((char_array_3[1] & 0xf0) >> 4);
-            char_array_4[2] = ((char_array_3[1] & 0x0f) << 2) + ((char_array_3[2] & 0xc0) >> 6);
-            char_array_4[3] = char_array_3[2] & 0x3f;
-
-            for (i = 0; i < 4; i++) *out++ = constants::BASE64_CHARS_TABLE[char_array_4[i]];
-
-            i = 0;
-        }
-    }
-
-    if (i) {
-        for (j = i; j < 3; j++) char_array_3[j] = '\0';
+static inline void el_base64_encode_triple(const unsigned char* in, char* out) {
+    uint32_t v = (static_cast<uint32_t>(in[0]) << 16) | (static_cast<uint32_t>(in[1]) << 8) | in[2];
+    out[0]     = constants::BASE64_CHARS_TABLE[v >> 18];
+    out[1]     = constants::BASE64_CHARS_TABLE[(v >> 12) & 0x3f];
+    out[2]     = constants::BASE64_CHARS_TABLE[(v >> 6) & 0x3f];
+    out[3]     = constants::BASE64_CHARS_TABLE[v & 0x3f];
+}
 
-        char_array_4[0] = (char_array_3[0] & 0xfc) >> 2;
-        char_array_4[1] = ((char_array_3[0] & 0x03) << 4) + ((char_array_3[1] & 0xf0) >> 4);
-        char_array_4[2] = ((char_array_3[1] & 0x0f) << 2) + ((char_array_3[2] & 0xc0) >> 6);
-        char_array_4[3] = char_array_3[2] & 0x3f;
+void el_base64_encode(const unsigned char* in, int in_len, char* out) {
+    // 24 bytes (8 triples) per iteration, the fixed count loop is unrolled by compiler
+    for (; in_len >= 24; in += 24, out += 32, in_len -= 24)
+        for (int i = 0; i < 8; ++i) el_base64_encode_triple(in + i * 3, out + (i << 2));
 
-        for (j = 0; j < i + 1; j++) *out++ = constants::BASE64_CHARS_TABLE[char_array_4[i]];
+    for (; in_len >= 3; in += 3, out += 4, in_len -= 3) el_base64_encode_triple(in, out);
 
-        while (i++ < 3) *out++ = '=';
+    if (in_len) {
+        unsigned char tail[3]{in[0], static_cast<unsigned char>(in_len > 1 ? in[1] : 0), 0};
+        el_base64_encode_triple(tail, out);
+        out[3] = '=';
+        if (in_len == 1) out[2] = '=';
     }
 }
 
@@ -32,6 +32,7 @@ namespace edgelab {
 
 void el_base64_encode_output(const unsigned char* in, int in_len, int (*putc_func)(int));
 
+// encodes in_len bytes to ((in_len + 2) / 3) * 4 chars, out is not null terminated
 void el_base64_encode(const unsigned char* in, int in_len, char* out);
 
 }  // namespace edgelab
@@ -929,8 +929,8 @@ EL_ATTR_WEAK void rgb_to_rgb(const el_img_t* src, el_img_t* dst) {
 
 #if CONFIG_EL_LIB_JPEGENC
 
-EL_ATTR_WEAK el_err_code_t rgb_to_jpeg(const el_img_t* src, el_img_t* dst) {
-    static JPEG   jpg;
+EL_ATTR_WEAK el_err_code_t rgb_to_jpeg(const el_img_t* src, el_img_t* dst, const el_jpeg_config_t* config) {
+    static JPEG   jpg;  // encoder state is reused across images
     JPEGENCODE    jpe;
     int           rc            = 0;
     el_err_code_t err           = EL_OK;
@@ -938,6 +938,7 @@ EL_ATTR_WEAK el_err_code_t rgb_to_jpeg(const el_img_t* src, el_img_t* dst) {
     int           pitch         = 0;
     int           bytesPerPixel = 0;
     int           pixelFormat   = 0;
+    size_t        limit         = dst->size;
     EL_ASSERT(src->format == EL_PIXEL_FORMAT_GRAYSCALE || src->format == EL_PIXEL_FORMAT_RGB565 ||
               src->format == EL_PIXEL_FORMAT_RGB888);
     if (src->format == EL_PIXEL_FORMAT_GRAYSCALE) {
@@ -950,13 +951,26 @@ EL_ATTR_WEAK el_err_code_t rgb_to_jpeg(const el_img_t* src, el_img_t* dst) {
         bytesPerPixel = 3;
         pixelFormat   = JPEG_PIXEL_RGB888;
     }
+    // the encoder gives up early once the output reaches the high water mark, instead of encoding the whole image
+    if (config->max_size && config->max_size + EL_JPEG_OUTPUT_HEADROOM < limit)
+        limit = config->max_size + EL_JPEG_OUTPUT_HEADROOM;
+    // headers are written without bounds checking
+    if (limit < (EL_JPEG_OUTPUT_HEADROOM << 1)) [[unlikely]] {
+        err = EL_EINVAL;
+        goto exit;
+    }
     pitch = src->width * bytesPerPixel;
-    rc    = jpg.open(dst->data, dst->size);
+    rc    = jpg.open(dst->data, static_cast<int>(limit));
     if (rc != JPEG_SUCCESS) {
         err = EL_EIO;
         goto exit;
     }
-    rc = jpg.encodeBegin(&jpe, src->width, src->height, pixelFormat, JPEG_SUBSAMPLE_444, JPEG_Q_LOW);
+    rc = jpg.encodeBegin(&jpe,
+                         src->width,
+                         src->height,
+                         pixelFormat,
+                         config->subsample == EL_JPEG_SUBSAMPLE_420 ? JPEG_SUBSAMPLE_420 : JPEG_SUBSAMPLE_444,
+                         config->quality);
     if (rc != JPEG_SUCCESS) {
         err = EL_EIO;
         goto exit;
@@ -966,10 +980,12 @@ EL_ATTR_WEAK el_err_code_t rgb_to_jpeg(const el_img_t* src, el_img_t* dst) {
         rc = jpg.addMCU(&jpe, &src->data[jpe.x * bytesPerPixel + jpe.y * src->width * bytesPerPixel], pitch);
     }
     if (rc != JPEG_SUCCESS) {
-        err = EL_EIO;
+        err = rc == JPEG_NO_BUFFER ? EL_ENOMEM : EL_EIO;
         goto exit;
     }
     dst->size = jpg.close();
+    if (config->max_size && dst->size > config->max_size) [[unlikely]]
+        err = EL_ENOMEM;
 
 exit:
     return err;
@@ -989,7 +1005,9 @@ EL_ATTR_WEAK el_err_code_t el_img_convert(const el_img_t* src, el_img_t* dst) {
         src->format == EL_PIXEL_FORMAT_GRAYSCALE) {
 #if CONFIG_EL_LIB_JPEGENC
         if (dst->format == EL_PIXEL_FORMAT_JPEG) {
-            return rgb_to_jpeg(src, dst);
+            static const el_jpeg_config_t config{
+              .quality = EL_JPEG_QUALITY_LOW, .subsample = EL_JPEG_SUBSAMPLE_444, .max_size = 0};
+            return rgb_to_jpeg(src, dst, &config);
         }
 #endif
 
@@ -1011,6 +1029,27 @@ EL_ATTR_WEAK el_err_code_t el_img_convert(const el_img_t* src, el_img_t* dst) {
     return EL_ENOTSUP;
 }
 
+EL_ATTR_WEAK el_err_code_t el_img_encode_jpeg(const el_img_t* src, el_img_t* dst, const el_jpeg_config_t* config) {
+    if (!src || !src->data) [[unlikely]]
+        return EL_EINVAL;
+
+    if (!dst || !dst->data || !config) [[unlikely]]
+        return EL_EINVAL;
+
+    if (config->quality > EL_JPEG_QUALITY_LOW || config->subsample > EL_JPEG_SUBSAMPLE_420) [[unlikely]]
+        return EL_EINVAL;
+
+#if CONFIG_EL_LIB_JPEGENC
+    if (src->format == EL_PIXEL_FORMAT_RGB565 || src->format == EL_PIXEL_FORMAT_RGB888 ||
+        src->format == EL_PIXEL_FORMAT_GRAYSCALE) {
+        dst->format = EL_PIXEL_FORMAT_JPEG;
+        return rgb_to_jpeg(src, dst, config);
+    }
+#endif
+
+    return EL_ENOTSUP;
+}
+
 // TODO: need to be optimized
 EL_ATTR_WEAK void el_draw_point(el_img_t* img, int16_t x, int16_t y, uint32_t color) {
     size_t   index = 0;
@@ -30,10 +30,17 @@
 
 #include "core/el_types.h"
 
+// the JPEG encoder stops once its output reaches this many bytes to the end of the output buffer
+#define EL_JPEG_OUTPUT_HEADROOM 512
+
 namespace edgelab {
 
 el_err_code_t el_img_convert(const el_img_t* src, el_img_t* dst);
 
+// encodes src into dst->data (dst->size bytes), dst->size is updated to the encoded size on success
+// returns EL_ENOMEM if the encoded image exceeds the output buffer or config->max_size
+el_err_code_t el_img_encode_jpeg(const el_img_t* src, el_img_t* dst, const el_jpeg_config_t* config);
+
 void el_draw_rect(el_img_t* img, int16_t x, int16_t y, int16_t w, int16_t h, uint32_t color, uint8_t thickness = 1);
 
 void el_fill_rect(el_img_t* img, int16_t x, int16_t y, int16_t w, int16_t h, uint32_t color);
@@ -52,10 +52,27 @@ const static uint16_t CRC16_MAXIM_TABLE[256] = {
   0x4c80, 0x8c41, 0x4400, 0x84c1, 0x8581, 0x4540, 0x8701, 0x47c0, 0x4680, 0x8641, 0x8201, 0x42c0, 0x4380, 0x8341,
   0x4100, 0x81c1, 0x8081, 0x4040};
 
+// slicing-by-4 tables of the reflected polynomial 0xedb88320, generated at compile time
+struct CRC32Table {
+    uint32_t v[4][256];
+
+    constexpr CRC32Table() : v{} {
+        for (uint32_t i = 0; i < 256; ++i) {
+            uint32_t c = i;
+            for (int j = 0; j < 8; ++j) c = c & 1 ? (c >> 1) ^ 0xedb88320 : c >> 1;
+            v[0][i] = c;
+        }
+        for (uint32_t i = 0; i < 256; ++i)
+            for (int k = 1; k < 4; ++k) v[k][i] = (v[k - 1][i] >> 8) ^ v[0][v[k - 1][i] & 0xff];
+    }
+};
+
+constexpr static CRC32Table CRC32_TABLE{};
+
 }
 
-EL_ATTR_WEAK uint16_t el_crc16_maxim(const uint8_t* data, size_t length) {
-    uint16_t crc = 0x0000;
+EL_ATTR_WEAK uint16_t el_crc16_maxim(const uint8_t* data, size_t length, uint16_t crc) {
+    crc ^= 0xffff;
 
     for (size_t i = 0; i < length; ++i) {
         uint8_t index = static_cast<uint8_t>(crc ^ data[i]);
@@ -65,4 +82,18 @@ EL_ATTR_WEAK uint16_t el_crc16_maxim(const uint8_t* data, size_t length) {
     return crc ^ 0xffff;
 }
 
+EL_ATTR_WEAK uint32_t el_crc32(const uint8_t* data, size_t length, uint32_t crc) {
+    const auto& t = constants::CRC32_TABLE.v;
+
+    crc = ~crc;
+    for (; length >= 4; length -= 4, data += 4) {
+        crc ^= static_cast<uint32_t>(data[0]) | (static_cast<uint32_t>(data[1]) << 8) |
+               (static_cast<uint32_t>(data[2]) << 16) | (static_cast<uint32_t>(data[3]) << 24);
+        crc = t[3][crc & 0xff] ^ t[2][(crc >> 8) & 0xff] ^ t[1][(crc >> 16) & 0xff] ^ t[0][crc >> 24];
+    }
+    for (; length; --length, ++data) crc = (crc >> 8) ^ t[0][(crc ^ *data) & 0xff];
+
+    return ~crc;
+}
+
 }  // namespace edgelab
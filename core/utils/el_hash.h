@@ -31,7 +31,11 @@
 
 namespace edgelab {
 
-uint16_t el_crc16_maxim(const uint8_t* data, size_t length);
+// CRC-16/MAXIM, incremental by passing the result of the previous call as crc
+uint16_t el_crc16_maxim(const uint8_t* data, size_t length, uint16_t crc = 0xffffu);
+
+// CRC-32 (IEEE 802.3, same as zlib), incremental by passing the result of the previous call as crc
+uint32_t el_crc32(const uint8_t* data, size_t length, uint32_t crc = 0u);
 
 }
 
@@ -0,0 +1,252 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2023 Seeed Technology Co.,Ltd
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#include "el_heap.h"
+
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+#include "core/el_compiler.h"
+#include "core/el_debug.h"
+
+namespace edgelab {
+
+namespace {
+
+const char* const __tag_names[EL_HEAP_TAG_COUNT] = {"other", "preprocess", "run", "postprocess", "reply"};
+
+#if CONFIG_EL_HEAP_ACCOUNTING
+
+// the allocated size is stored ahead of the block, so that the freed size is known without the allocator internals
+constexpr size_t __header_size = alignof(std::max_align_t);
+
+std::atomic<uint32_t> __alloc_count{0};
+std::atomic<uint32_t> __free_count{0};
+std::atomic<size_t>   __alloc_bytes{0};
+std::atomic<size_t>   __live_bytes{0};
+std::atomic<size_t>   __peak_bytes{0};
+std::atomic<size_t>   __frame_peak_bytes{0};
+
+// frame state is only touched by the task running the frames
+el_heap_frame_stats_t __frame{};
+uint32_t              __frame_alloc_count{0};
+size_t                __frame_alloc_bytes{0};
+size_t                __frame_live_bytes{0};
+
+inline void __update_max(std::atomic<size_t>& max, size_t value) {
+    for (size_t cur = max.load(std::memory_order_relaxed);
+         value > cur && !max.compare_exchange_weak(cur, value, std::memory_order_relaxed);) {
+    }
+}
+
+inline void* __counted_alloc(size_t size) noexcept {
+    auto* p = static_cast<uint8_t*>(el_heap_port_malloc(size + __header_size));
+    if (!p) [[unlikely]]
+        return nullptr;
+    *reinterpret_cast<size_t*>(p) = size;
+
+    __alloc_count.fetch_add(1, std::memory_order_relaxed);
+    __alloc_bytes.fetch_add(size, std::memory_order_relaxed);
+    size_t live = __live_bytes.fetch_add(size, std::memory_order_relaxed) + size;
+    __update_max(__peak_bytes, live);
+    __update_max(__frame_peak_bytes, live);
+
+    return p + __header_size;
+}
+
+inline void __counted_free(void* ptr) noexcept {
+    if (!ptr) [[unlikely]]
+        return;
+    auto* p = static_cast<uint8_t*>(ptr) - __header_size;
+
+    __free_count.fetch_add(1, std::memory_order_relaxed);
+    __live_bytes.fetch_sub(*reinterpret_cast<size_t*>(p), std::memory_order_relaxed);
+
+    el_heap_port_free(p);
+}
+
+#endif
+
+}  // namespace
+
+void el_heap_get_stats(el_heap_stats_t* stats) {
+#if CONFIG_EL_HEAP_ACCOUNTING
+    stats->alloc_count = __alloc_count.load(std::memory_order_relaxed);
+    stats->free_count  = __free_count.load(std::memory_order_relaxed);
+    stats->alloc_bytes = __alloc_bytes.load(std::memory_order_relaxed);
+    stats->live_bytes  = __live_bytes.load(std::memory_order_relaxed);
+    stats->peak_bytes  = __peak_bytes.load(std::memory_order_relaxed);
+#else
+    *stats = el_heap_stats_t{};
+#endif
+}
+
+void el_heap_frame_begin() {
+#if CONFIG_EL_HEAP_ACCOUNTING
+    __frame_alloc_count = __alloc_count.load(std::memory_order_relaxed);
+    __frame_alloc_bytes = __alloc_bytes.load(std::memory_order_relaxed);
+    __frame_live_bytes  = __live_bytes.load(std::memory_order_relaxed);
+    __frame_peak_bytes.store(__frame_live_bytes, std::memory_order_relaxed);
+    std::memset(__frame.tag_alloc_count, 0, sizeof(__frame.tag_alloc_count));
+    std::memset(__frame.tag_alloc_bytes, 0, sizeof(__frame.tag_alloc_bytes));
+#endif
+}
+
+void el_heap_frame_end() {
+#if CONFIG_EL_HEAP_ACCOUNTING
+    __frame.alloc_count = __alloc_count.load(std::memory_order_relaxed) - __frame_alloc_count;
+    __frame.alloc_bytes = __alloc_bytes.load(std::memory_order_relaxed) - __frame_alloc_bytes;
+    __frame.peak_bytes  = __frame_peak_bytes.load(std::memory_order_relaxed) - __frame_live_bytes;
+    ++__frame.frames;
+
+    // allocations out of the tagged scopes
+    __frame.tag_alloc_count[EL_HEAP_TAG_OTHER] = __frame.alloc_count;
+    __frame.tag_alloc_bytes[EL_HEAP_TAG_OTHER] = __frame.alloc_bytes;
+    for (size_t i = EL_HEAP_TAG_OTHER + 1; i < EL_HEAP_TAG_COUNT; ++i) {
+        __frame.tag_alloc_count[EL_HEAP_TAG_OTHER] -= __frame.tag_alloc_count[i];
+        __frame.tag_alloc_bytes[EL_HEAP_TAG_OTHER] -= __frame.tag_alloc_bytes[i];
+    }
+
+    if (__frame.budget && __frame.frames > CONFIG_EL_HEAP_BUDGET_WARMUP_FRAMES &&
+        __frame.alloc_count > __frame.budget) [[unlikely]] {
+        ++__frame.over_budget;
+        EL_LOGW("[Heap] frame %u allocated %u times (%u bytes), budget %u",
+                static_cast<unsigned>(__frame.frames),
+                static_cast<unsigned>(__frame.alloc_count),
+                static_cast<unsigned>(__frame.alloc_bytes),
+                static_cast<unsigned>(__frame.budget));
+    #if CONFIG_EL_HEAP_BUDGET_ASSERT
+        EL_ASSERT(__frame.alloc_count <= __frame.budget);
+    #endif
+    }
+#endif
+}
+
+void el_heap_get_frame_stats(el_heap_frame_stats_t* stats) {
+#if CONFIG_EL_HEAP_ACCOUNTING
+    *stats = __frame;
+#else
+    *stats = el_heap_frame_stats_t{};
+#endif
+}
+
+void el_heap_set_budget(uint32_t alloc_count) {
+#if CONFIG_EL_HEAP_ACCOUNTING
+    __frame        = el_heap_frame_stats_t{};
+    __frame.budget = alloc_count;
+#else
+    (void)alloc_count;
+#endif
+}
+
+const char* el_heap_tag_name(el_heap_tag_t tag) { return tag < EL_HEAP_TAG_COUNT ? __tag_names[tag] : "unknown"; }
+
+EL_ATTR_WEAK void* el_heap_port_malloc(size_t size) { return std::malloc(size); }
+
+EL_ATTR_WEAK void el_heap_port_free(void* ptr) { std::free(ptr); }
+
+void* el_heap_malloc(size_t size) {
+#if CONFIG_EL_HEAP_ACCOUNTING
+    return __counted_alloc(size);
+#else
+    return el_heap_port_malloc(size);
+#endif
+}
+
+void* el_heap_calloc(size_t nmemb, size_t size) {
+    if (size && nmemb > SIZE_MAX / size) [[unlikely]]
+        return nullptr;
+    void* p = el_heap_malloc(nmemb * size);
+    if (p) [[likely]]
+        std::memset(p, 0, nmemb * size);
+    return p;
+}
+
+void el_heap_free(void* ptr) {
+#if CONFIG_EL_HEAP_ACCOUNTING
+    __counted_free(ptr);
+#else
+    el_heap_port_free(ptr);
+#endif
+}
+
+#if CONFIG_EL_HEAP_ACCOUNTING
+
+HeapScope::HeapScope(el_heap_tag_t tag)
+    : _tag(tag),
+      _alloc_count(__alloc_count.load(std::memory_order_relaxed)),
+      _alloc_bytes(__alloc_bytes.load(std::memory_order_relaxed)) {}
+
+HeapScope::~HeapScope() {
+    __frame.tag_alloc_count[_tag] += __alloc_count.load(std::memory_order_relaxed) - _alloc_count;
+    __frame.tag_alloc_bytes[_tag] += __alloc_bytes.load(std::memory_order_relaxed) - _alloc_bytes;
+}
+
+#endif
+
+}  // namespace edgelab
+
+#if CONFIG_EL_HEAP_ACCOUNTING
+
+// over-aligned allocations (std::align_val_t) are left to the default implementation and not counted
+
+void* operator new(std::size_t size) {
+    void* p = edgelab::__counted_alloc(size ? size : 1);
+    if (!p) [[unlikely]] {
+#if __cpp_exceptions
+        throw std::bad_alloc();
+#else
+        std::abort();
+#endif
+    }
+    return p;
+}
+
+void* operator new[](std::size_t size) { return operator new(size); }
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    return edgelab::__counted_alloc(size ? size : 1);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    return edgelab::__counted_alloc(size ? size : 1);
+}
+
+void operator delete(void* ptr) noexcept { edgelab::__counted_free(ptr); }
+
+void operator delete[](void* ptr) noexcept { edgelab::__counted_free(ptr); }
+
+void operator delete(void* ptr, std::size_t) noexcept { edgelab::__counted_free(ptr); }
+
+void operator delete[](void* ptr, std::size_t) noexcept { edgelab::__counted_free(ptr); }
+
+void operator delete(void* ptr, const std::nothrow_t&) noexcept { edgelab::__counted_free(ptr); }
+
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept { edgelab::__counted_free(ptr); }
+
+#endif
@@ -0,0 +1,106 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2023 Seeed Technology Co.,Ltd
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#ifndef _EL_HEAP_H_
+#define _EL_HEAP_H_
+
+#include <cstddef>
+#include <cstdint>
+
+#include "core/el_config_internal.h"
+
+namespace edgelab {
+
+typedef enum {
+    EL_HEAP_TAG_OTHER = 0,
+    EL_HEAP_TAG_PREPROCESS,
+    EL_HEAP_TAG_RUN,
+    EL_HEAP_TAG_POSTPROCESS,
+    EL_HEAP_TAG_REPLY,
+    EL_HEAP_TAG_COUNT,
+} el_heap_tag_t;
+
+typedef struct el_heap_stats_t {
+    uint32_t alloc_count;
+    uint32_t free_count;
+    size_t   alloc_bytes;
+    size_t   live_bytes;
+    size_t   peak_bytes;
+} el_heap_stats_t;
+
+typedef struct el_heap_frame_stats_t {
+    uint32_t frames;       // frames counted since the last reset
+    uint32_t alloc_count;  // allocations of the last frame
+    size_t   alloc_bytes;
+    size_t   peak_bytes;  // peak live bytes of the last frame above the live bytes at the beginning of the frame
+    uint32_t tag_alloc_count[EL_HEAP_TAG_COUNT];
+    size_t   tag_alloc_bytes[EL_HEAP_TAG_COUNT];
+    uint32_t budget;       // allocations allowed per frame, 0 if unlimited
+    uint32_t over_budget;  // frames exceeded the budget since the last reset
+} el_heap_frame_stats_t;
+
+// all the counters are 0 if CONFIG_EL_HEAP_ACCOUNTING is disabled
+void el_heap_get_stats(el_heap_stats_t* stats);
+
+// allocations between begin and end are accounted to a frame, frames are not supposed to be nested
+void el_heap_frame_begin();
+void el_heap_frame_end();
+void el_heap_get_frame_stats(el_heap_frame_stats_t* stats);
+
+// setting the budget also resets the frame counters
+void el_heap_set_budget(uint32_t alloc_count);
+
+const char* el_heap_tag_name(el_heap_tag_t tag);
+
+// allocations counted the same way as the C++ ones, for the el_malloc family of a porting layer, they are taken from
+// the heap of the porting layer below, uncounted if CONFIG_EL_HEAP_ACCOUNTING is disabled
+void* el_heap_malloc(size_t size);
+void* el_heap_calloc(size_t nmemb, size_t size);
+void  el_heap_free(void* ptr);
+
+// the heap of the porting layer (e.g. the FreeRTOS heap), weak and backed by the C heap by default, the counted C++
+// allocations are taken from it as well, so that enabling the accounting never moves them to another heap
+void* el_heap_port_malloc(size_t size);
+void  el_heap_port_free(void* ptr);
+
+// allocations are global counters, so a scope also counts the allocations of other tasks running in the meantime
+class HeapScope {
+   public:
+#if CONFIG_EL_HEAP_ACCOUNTING
+    explicit HeapScope(el_heap_tag_t tag);
+    ~HeapScope();
+
+   private:
+    el_heap_tag_t _tag;
+    uint32_t      _alloc_count;
+    size_t        _alloc_bytes;
+#else
+    explicit HeapScope(el_heap_tag_t) {}
+#endif
+};
+
+}  // namespace edgelab
+
+#endif
@@ -1,5 +1,9 @@
 #pragma once
 
+#include <atomic>
+#include <cstring>
+#include <new>
+
 #include "core/el_types.h"
 
 namespace edgelab {
@@ -138,4 +142,226 @@ class lwRingBuffer {
     size_t tail;
 };
 
+/**
+ * Ring buffer of a power-of-two capacity for a single producer and a single consumer (e.g. an ISR and a task)
+ *
+ * The head and tail are free-running counters masked on access, so that the whole capacity is usable and the two
+ * sides never write the same counter, the producer only advances the tail and the consumer only advances the head.
+ * Unlike lwRingBuffer, put() drops the bytes that do not fit instead of overwriting the oldest ones, as overwriting
+ * would move the head from the producer side.
+ */
+class lwRingBufferSPSC {
+   public:
+    // the data is aligned to align bytes (a power of two), e.g. to the cache lines of the regions written by DMA
+    lwRingBufferSPSC(size_t len, size_t align = __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+        : buf(nullptr), len(roundup(len)), mask(this->len - 1), align(align), head(0), tail(0), discarding(false) {
+        buf = static_cast<char*>(::operator new[](this->len, std::align_val_t{this->align}));
+    }
+    ~lwRingBufferSPSC() { ::operator delete[](buf, std::align_val_t{align}); }
+
+    lwRingBufferSPSC(const lwRingBufferSPSC&)            = delete;
+    lwRingBufferSPSC& operator=(const lwRingBufferSPSC&) = delete;
+
+    // producer side
+
+    bool put(char c) {
+        size_t t = tail.load(std::memory_order_relaxed);
+        if (t - head.load(std::memory_order_acquire) == len) [[unlikely]]
+            return false;
+        buf[t & mask] = c;
+        tail.store(t + 1, std::memory_order_release);
+        return true;
+    }
+    size_t put(const char* str, size_t slen) {
+        size_t t = tail.load(std::memory_order_relaxed);
+        size_t f = len - (t - head.load(std::memory_order_acquire));
+        if (slen > f) {
+            slen = f;
+        }
+        size_t o = t & mask;
+        size_t n = len - o;
+        if (slen > n) {
+            memcpy(buf + o, str, n);
+            memcpy(buf, str + n, slen - n);
+        } else {
+            memcpy(buf + o, str, slen);
+        }
+        tail.store(t + slen, std::memory_order_release);
+        return slen;
+    }
+    void push(char c) { this->put(c); }
+
+    /**
+     * Get the contiguous free region to be written in place (e.g. by DMA)
+     * @param slen the length of the region, it could be less than free() when the free space wraps around
+     * @return the start of the region
+     */
+    char* reserve(size_t* slen) {
+        size_t t = tail.load(std::memory_order_relaxed);
+        size_t f = len - (t - head.load(std::memory_order_acquire));
+        size_t n = len - (t & mask);
+        *slen    = f < n ? f : n;
+        return buf + (t & mask);
+    }
+    // makes the slen bytes written to the reserved region readable
+    void commit(size_t slen) { tail.store(tail.load(std::memory_order_relaxed) + slen, std::memory_order_release); }
+
+    // consumer side
+
+    char get() {
+        size_t h = head.load(std::memory_order_relaxed);
+        if (h == tail.load(std::memory_order_acquire)) {
+            return 0;
+        }
+        char c = buf[h & mask];
+        head.store(h + 1, std::memory_order_release);
+        return c;
+    }
+    size_t get(char* str, size_t slen) {
+        size_t h = head.load(std::memory_order_relaxed);
+        size_t s = tail.load(std::memory_order_acquire) - h;
+        if (slen > s) {
+            slen = s;
+        }
+        copy(h, str, slen);
+        head.store(h + slen, std::memory_order_release);
+        return slen;
+    }
+    char pop() { return get(); }
+
+    /**
+     * Get the contiguous region of data to be read in place (e.g. by DMA)
+     * @param slen the length of the region, it could be less than size() when the data wraps around
+     * @return the start of the region
+     */
+    const char* peek(size_t* slen) {
+        size_t h = head.load(std::memory_order_relaxed);
+        size_t s = tail.load(std::memory_order_acquire) - h;
+        size_t n = len - (h & mask);
+        *slen    = s < n ? s : n;
+        return buf + (h & mask);
+    }
+    // releases the slen bytes read from the peeked region
+    void consume(size_t slen) {
+        size_t h = head.load(std::memory_order_relaxed);
+        size_t s = tail.load(std::memory_order_acquire) - h;
+        head.store(h + (slen < s ? slen : s), std::memory_order_release);
+    }
+
+    bool   isEmpty() { return head.load(std::memory_order_acquire) == tail.load(std::memory_order_acquire); }
+    bool   isFull() { return size() == len; }
+    size_t size() { return tail.load(std::memory_order_acquire) - head.load(std::memory_order_acquire); }
+    size_t free() { return len - size(); }
+    size_t capacity() { return len; }
+    void   clear() { head.store(tail.load(std::memory_order_acquire), std::memory_order_release); }
+
+    friend lwRingBufferSPSC& operator>>(lwRingBufferSPSC& input, char& c) {
+        c = input.get();
+        return input;
+    }
+    friend lwRingBufferSPSC& operator<<(lwRingBufferSPSC& output, char c) {
+        output.put(c);
+        return output;
+    }
+    char operator[](size_t i) { return buf[(head.load(std::memory_order_relaxed) + i) & mask]; }
+
+    /**
+     * Find the first occurrence of c in the ring buffer, the data is searched as at most 2 contiguous spans
+     * @param c the character to search for
+     * @return the index of the first occurrence of c in the ring buffer
+     *         if c is not found, return this->len
+     */
+    size_t find(char c) {
+        size_t      h = head.load(std::memory_order_relaxed);
+        size_t      s = tail.load(std::memory_order_acquire) - h;
+        size_t      o = h & mask;
+        size_t      n = len - o < s ? len - o : s;
+        const void* p = memchr(buf + o, c, n);
+        if (p) {
+            return static_cast<const char*>(p) - (buf + o);
+        }
+        p = memchr(buf, c, s - n);
+        if (p) {
+            return n + (static_cast<const char*>(p) - buf);
+        }
+        return this->len;
+    }
+
+    /**
+     * Check if the ring buffer contains the string *str
+     * @param str the string to search for
+     * @param slen the length of the string
+     * @return true if the ring buffer contains the string *str
+     *         false otherwise
+     */
+    bool match(const char* str, size_t slen) {
+        size_t h = head.load(std::memory_order_relaxed);
+        if (slen > tail.load(std::memory_order_acquire) - h) {
+            return false;
+        }
+        size_t o = h & mask;
+        size_t n = len - o;
+        if (slen > n) {
+            return memcmp(buf + o, str, n) == 0 && memcmp(buf, str + n, slen - n) == 0;
+        }
+        return memcmp(buf + o, str, slen) == 0;
+    }
+
+    /**
+     * Extract string from the ring buffer until the character c is found
+     * @param c the character to search for
+     * @param str the string to extract
+     * @param slen the length of the string
+     * @return the length of the string extracted
+     * @note a string longer than slen is dropped, so is a string filling the whole buffer without c, which is dropped
+     *       up to the next c, as the producer could never put c into a full buffer
+     */
+    size_t extract(char c, char* str, size_t slen) {
+        size_t i = find(c);
+        size_t h = head.load(std::memory_order_relaxed);
+        if (i == this->len) {
+            if (tail.load(std::memory_order_acquire) - h == len) [[unlikely]] {
+                head.store(h + len, std::memory_order_release);
+                discarding = true;
+            }
+            return 0;
+        }
+        if (slen < i || discarding) {
+            head.store(h + i + 1, std::memory_order_release);
+            discarding = false;
+            return 0;
+        }
+        copy(h, str, i + 1);
+        head.store(h + i + 1, std::memory_order_release);
+        return i + 1;
+    }
+
+   protected:
+    static size_t roundup(size_t len) {
+        size_t n = 1;
+        while (n < len) n <<= 1;
+        return n;
+    }
+
+    void copy(size_t from, char* str, size_t slen) {
+        size_t o = from & mask;
+        size_t n = len - o;
+        if (slen > n) {
+            memcpy(str, buf + o, n);
+            memcpy(str + n, buf, slen - n);
+        } else {
+            memcpy(str, buf + o, slen);
+        }
+    }
+
+   private:
+    char*               buf;
+    size_t              len;
+    size_t              mask;
+    size_t              align;
+    std::atomic<size_t> head;
+    std::atomic<size_t> tail;
+    bool                discarding;  // consumer side, the rest of a dropped string is dropped up to its end
+};
+
 }  // namespace edgelab
@@ -28,30 +28,87 @@
 
 #include <cstdbool>
 #include <cstdint>
+#include <string>
 
 #include "core/el_types.h"
+#include "core/synchronize/el_event.hpp"
+#include "core/synchronize/el_mutex.hpp"
 
 namespace edgelab {
 
+// called once the views sent are no longer referenced by the transport, could be called from an interrupt
+typedef void (*el_send_done_cb_t)(void* arg);
+
 // No status transport protocol (framed), TCP alternative should have a server class, a connection could derive from Transport
 class Transport {
    public:
     el_transport_type_t type;
 
-    Transport() : type(EL_TRANSPORT_UNKNOWN), _is_present(false) {}
+    Transport() : type(EL_TRANSPORT_UNKNOWN), _is_present(false), _recv_event(nullptr), _reply_lock() {}
     virtual ~Transport() = default;
 
     virtual std::size_t read_bytes(char* buffer, size_t size)       = 0;
     virtual std::size_t send_bytes(const char* buffer, size_t size) = 0;
 
+    // sends the views in order as one reply, transports able to send from the views directly (e.g. by DMA) override
+    // it and may return before the views are sent, the views must be kept until done is called, others gather the views
+    // and send them by one send_bytes
+    virtual std::size_t send_views(const el_buffer_view_t* views,
+                                   size_t                  n,
+                                   el_send_done_cb_t       done = nullptr,
+                                   void*                   arg  = nullptr) {
+        size_t sent = 0;
+        if (n == 1) [[likely]]
+            sent = send_bytes(views[0].data, views[0].size);
+        else {
+            std::string buffer;
+            size_t      size = 0;
+            for (size_t i = 0; i < n; ++i) size += views[i].size;
+            buffer.reserve(size);
+            for (size_t i = 0; i < n; ++i) buffer.append(views[i].data, views[i].size);
+            sent = send_bytes(buffer.data(), buffer.size());
+        }
+        if (done) done(arg);
+        return sent;
+    }
+
+    // stops sending the views of the last send_views() (e.g. a stuck DMA) and calls its done, the views are no longer
+    // referenced once it returns, transports sending the views before send_views() returns have nothing to stop
+    virtual void abort_views() {}
+
     virtual char        echo(bool only_visible = true)                               = 0;
     virtual char        get_char()                                                   = 0;
     virtual std::size_t get_line(char* buffer, size_t size, const char delim = 0x0d) = 0;
 
     operator bool() const { return _is_present; }
 
+    // a reply sent by more than one call (e.g. a JSON reply flushed in chunks) holds the reply lock, so do the replies
+    // sent from outside the executor, so that whole replies from different tasks are never interleaved
+    virtual const Mutex& get_reply_lock() const { return _reply_lock; }
+
+    // the event is set once data is received, so that the reader could block on it instead of polling, transports
+    // unable to tell the arrival of data (e.g. a serial port polled by its driver) never set it and should be polled
+    inline void set_recv_event(const Event* event) { _recv_event = event; }
+
+    // true if the driver calls notify_recv() once any data is received, so that the reader never polls it
+    virtual bool is_recv_notified() const { return false; }
+
+    // called by the driver once data is received
+    inline void notify_recv() const {
+        if (_recv_event) [[likely]]
+            _recv_event->set();
+    }
+    inline void notify_recv_from_isr() const {
+        if (_recv_event) [[likely]]
+            _recv_event->set_from_isr();
+    }
+
    protected:
-    bool _is_present;
+    bool                  _is_present;
+    const Event* volatile _recv_event;
+
+   private:
+    Mutex _reply_lock;
 };
 
 }  // namespace edgelab
@@ -49,7 +49,7 @@ el_err_code_t SerialEsp::init() {
         return EL_EPERM;
 
     if (!this->_rb_rx) [[likely]]
-        this->_rb_rx = new lwRingBuffer{_size};
+        this->_rb_rx = new lwRingBufferSPSC{_size};
 
     EL_ASSERT(this->_rb_rx);
 
@@ -85,11 +85,14 @@ char SerialEsp::get_char() {
 std::size_t SerialEsp::get_line(char* buffer, size_t size, const char delim) {
     if (!this->_is_present) return 0;
 
+    // the driver is drained in bulk to the free region of the ring buffer in place
     size_t rlen = 0;
-    char rbuf[32] = {0}; // Most commands are less than 32 bytes long
     do {
-        rlen = usb_serial_jtag_read_bytes(rbuf, sizeof(rbuf), 1 / portTICK_PERIOD_MS);
-        this->_rb_rx->put(rbuf, rlen);
+        size_t free = 0;
+        char*  data = this->_rb_rx->reserve(&free);
+        if (!free) break;
+        rlen = usb_serial_jtag_read_bytes(data, free, 1 / portTICK_PERIOD_MS);
+        this->_rb_rx->commit(rlen);
     } while (rlen > 0);
 
     return this->_rb_rx->extract(delim, buffer, size);
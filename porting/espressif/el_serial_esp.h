@@ -53,8 +53,8 @@ class SerialEsp final : public Serial {
     usb_serial_jtag_driver_config_t _driver_config;
     Mutex                           _send_lock;
 
-    std::size_t   _size;
-    lwRingBuffer* _rb_rx;
+    std::size_t       _size;
+    lwRingBufferSPSC* _rb_rx;
 };
 
 }  // namespace edgelab
@@ -76,6 +76,10 @@
 
 #define CONFIG_EL_HAS_ACCELERATED_JPEG_CODEC    1
 
+#define CONFIG_EL_TRANSPORT_DIRECT_SEND_SIZE_MIN 1024  // larger views are sent by DMA from the buffer of the caller
+#define CONFIG_EL_TRANSPORT_RECV_BLOCK_SIZE      256   // bytes received by DMA per interrupt at most
+#define CONFIG_EL_TRANSPORT_RECV_IDLE_MS         2     // a partially received block is flushed every ms while receiving
+
 #define CONFIG_EL_LIB_FLASHDB                   1
 #define CONFIG_EL_LIB_JPEGENC                   0
 
@@ -88,6 +92,13 @@
 #define CONFIG_EL_STORAGE_PARTITION_FS_SIZE_0   (256 * 1024)
 #define CONFIG_EL_STORAGE_KEY_SIZE_MAX          (128)
 
+// the time series partition follows the storage partition on the same flash device, below the models at 0x00400000
+#define CONFIG_EL_TSDB                          1
+#define CONFIG_EL_TSDB_NAME                     "sscma_tsdb"
+#define CONFIG_EL_TSDB_PATH                     "tsdb0"
+#define CONFIG_EL_TSDB_PARTITION_SIZE           (128 * 1024)
+#define CONFIG_EL_TSDB_LOG_SIZE_MAX             (1024)
+
 #if CONFIG_EL_LIB_FLASHDB
     #include "third_party/FlashDB/fal_def.h"
 
@@ -107,6 +118,12 @@ extern const struct fal_flash_dev _el_flash_db_nor_flash0;
                  0,                                     \
                  CONFIG_EL_STORAGE_PARTITION_FS_SIZE_0, \
                  0},                                    \
+                {FAL_PART_MAGIC_WORD,                   \
+                 CONFIG_EL_TSDB_PATH,                   \
+                 NOR_FLASH_DEV_NAME,                    \
+                 CONFIG_EL_STORAGE_PARTITION_FS_SIZE_0, \
+                 CONFIG_EL_TSDB_PARTITION_SIZE,         \
+                 0},                                    \
             }
     #endif
 
@@ -115,6 +132,9 @@ extern const struct fal_flash_dev _el_flash_db_nor_flash0;
         #define FDB_KV_AUTO_UPDATE
     #endif
 
+    #define FDB_USING_TSDB
+    #define FDB_USING_TIMESTAMP_64BIT
+
     #define FDB_USING_FAL_MODE
     #define FDB_WRITE_GRAN (32)
     #define FDB_BLOCK_SIZE (8 * 1024)
@@ -133,10 +153,4 @@ extern const struct fal_flash_dev _el_flash_db_nor_flash0;
 extern void __on_algo_preprocess_done();
 #define EL_ON_ALGO_PREPROCESS_DONE __on_algo_preprocess_done();
 
-#include "drivers/drv_shared_cfg.h"
-
-#define SSCMA_SHARED_BASE64_BUFFER      1
-#define SSCMA_SHARED_BASE64_BUFFER_BASE SRAM_2_START_ADDR_FREE
-#define SSCMA_SHARED_BASE64_BUFFER_SIZE SRAM_2_SIZE_FREE
-
 #endif
@@ -98,8 +98,12 @@ void el_flash_mmap_deinit(uint32_t*) { _el_flash_deinit(); }
 
 #ifdef CONFIG_EL_LIB_FLASHDB
 
+// the device holds the storage partition and the time series partition after it
+const static size_t _el_flash_db_partition_size  = CONFIG_EL_STORAGE_PARTITION_FS_SIZE_0 + CONFIG_EL_TSDB_PARTITION_SIZE;
 const static size_t _el_flash_db_partition_begin = 0x00300000;
-const static size_t _el_flash_db_partition_end   = 0x00300000 + CONFIG_EL_STORAGE_PARTITION_FS_SIZE_0;
+const static size_t _el_flash_db_partition_end   = 0x00300000 + _el_flash_db_partition_size;
+
+static_assert(_el_flash_db_partition_end <= 0x00400000, "the database partitions overlap the models");
 
 
 static int _el_flash_db_init(void) {
@@ -190,7 +194,7 @@ static int _el_flash_db_erase(long offset, size_t size) {
 extern "C" const struct fal_flash_dev _el_flash_db_nor_flash0 = {
   .name       = CONFIG_EL_STORAGE_PARTITION_MOUNT_POINT,
   .addr       = _el_flash_db_partition_begin,
-  .len        = CONFIG_EL_STORAGE_PARTITION_FS_SIZE_0,
+  .len        = _el_flash_db_partition_size,
   .blk_size   = FDB_BLOCK_SIZE,
   .ops        = {_el_flash_db_init, _el_flash_db_read, _el_flash_db_write, _el_flash_db_erase},
   .write_gran = FDB_WRITE_GRAN,
@@ -35,6 +35,7 @@ extern "C" {
 
 #include "core/el_debug.h"
 #include "core/el_types.h"
+#include "core/utils/el_heap.h"
 #include "el_config_porting.h"
 #include "porting/el_misc.h"
 
@@ -75,13 +76,7 @@ EL_ATTR_WEAK int el_printf(const char* fmt, ...) {
 
 EL_ATTR_WEAK int el_putchar(char c) { return 0; }
 
-EL_ATTR_WEAK void* el_malloc(size_t size) {
-#if CONFIG_EL_HAS_FREERTOS_SUPPORT
-    return pvPortMalloc(size);
-#else
-    return malloc(size);
-#endif
-}
+EL_ATTR_WEAK void* el_malloc(size_t size) { return edgelab::el_heap_malloc(size); }
 
 EL_ATTR_WEAK void* el_aligned_malloc_once(size_t align, size_t size) {
     constexpr static const size_t elHeapSize = 1098 * 1024;
@@ -98,21 +93,20 @@ EL_ATTR_WEAK void* el_aligned_malloc_once(size_t align, size_t size) {
     return aligned;
 }
 
-EL_ATTR_WEAK void* el_calloc(size_t nmemb, size_t size) {
-#if CONFIG_EL_HAS_FREERTOS_SUPPORT
-    return pvPortMalloc(nmemb * size);
-#else
-    return calloc(nmemb, size);
-#endif
-}
+EL_ATTR_WEAK void* el_calloc(size_t nmemb, size_t size) { return edgelab::el_heap_calloc(nmemb, size); }
+
+EL_ATTR_WEAK void el_free(void* ptr) { edgelab::el_heap_free(ptr); }
 
-EL_ATTR_WEAK void el_free(void* ptr) {
 #if CONFIG_EL_HAS_FREERTOS_SUPPORT
-    vPortFree(ptr);
-#else
-    free(ptr);
+// the el_malloc family and the counted C++ allocations are taken from the FreeRTOS heap
+namespace edgelab {
+
+void* el_heap_port_malloc(size_t size) { return pvPortMalloc(size); }
+
+void el_heap_port_free(void* ptr) { vPortFree(ptr); }
+
+}  // namespace edgelab
 #endif
-}
 
 EL_ATTR_WEAK void el_reset(void) { __NVIC_SystemReset(); }
 
@@ -35,23 +35,20 @@ extern "C" {
 #include <cstdint>
 
 #include "el_config_porting.h"
+#include "el_uart_rx_we2.h"
 
 namespace edgelab {
 
 namespace porting {
 
-static lwRingBuffer*              _rb_rx = nullptr;
 static lwRingBuffer*              _rb_tx = nullptr;
-static char                       _buf_rx[32]{};
+static UartRxWE2                  _rx{};
 static char                       _buf_tx[4096]{};
 volatile static bool              _tx_busy  = false;
 volatile static SemaphoreHandle_t _mutex_tx = nullptr;
 volatile static DEV_UART*         _uart     = nullptr;
 
-static void _uart_dma_recv(void*) {
-    _rb_rx->put(_buf_rx[0]);
-    _uart->uart_read_udma(_buf_rx, 1, (void*)_uart_dma_recv);
-}
+static void _uart_dma_recv(void*) { _rx.on_recv(); }
 
 static void _uart_dma_send(void*) {
     size_t remain = _rb_tx->size() < 4095 ? _rb_tx->size() : 4095;
@@ -84,20 +81,17 @@ el_err_code_t Serial2WE2::init() {
 
     _console_uart->uart_open(UART_BAUDRATE_921600);
 
-    if (!_rb_rx) [[likely]]
-        _rb_rx = new lwRingBuffer{8192};
-
     if (!_rb_tx) [[likely]]
         _rb_tx = new lwRingBuffer{32768};
 
     _mutex_tx = xSemaphoreCreateMutex();
 
-    EL_ASSERT(_rb_rx);
     EL_ASSERT(_rb_tx);
     EL_ASSERT(_mutex_tx);
 
     _uart = _console_uart;
-    _uart->uart_read_udma(_buf_rx, 1, (void*)_uart_dma_recv);
+    if (_rx.init(_console_uart, 8192, _uart_dma_recv, this) != EL_OK) [[unlikely]]
+        return EL_ENOMEM;
 
     this->_is_present = _console_uart != nullptr;
     _tx_busy          = false;
@@ -111,11 +105,10 @@ el_err_code_t Serial2WE2::deinit() {
 
     this->_is_present = !hx_drv_uart_deinit(USE_DW_UART_1) ? false : true;
 
-    delete _rb_rx;
+    _rx.deinit();
     delete _rb_tx;
     vSemaphoreDelete(_mutex_tx);
 
-    _rb_rx    = nullptr;
     _rb_tx    = nullptr;
     _mutex_tx = nullptr;
 
@@ -138,14 +131,16 @@ char Serial2WE2::get_char() {
     if (!this->_is_present) [[unlikely]]
         return '\0';
 
-    return porting::_rb_rx->get();
+    _rx.poll();
+    return _rx.get_buffer()->get();
 }
 
 std::size_t Serial2WE2::get_line(char* buffer, size_t size, const char delim) {
     if (!this->_is_present) [[unlikely]]
         return 0;
 
-    return porting::_rb_rx->extract(delim, buffer, size);
+    _rx.poll();
+    return _rx.get_buffer()->extract(delim, buffer, size);
 }
 
 std::size_t Serial2WE2::read_bytes(char* buffer, size_t size) {
@@ -157,9 +152,10 @@ std::size_t Serial2WE2::read_bytes(char* buffer, size_t size) {
     size_t pos_of_bytes{0};
 
     while (size) {
-        pos_of_bytes = _rb_rx->size();
+        _rx.poll();
+        pos_of_bytes = _rx.get_buffer()->size();
         if (pos_of_bytes) {
-            read += _rb_rx->get(buffer + read, size);
+            read += _rx.get_buffer()->get(buffer + read, size);
             size -= read;
         }
         if (el_get_time_ms() - time_start > 3000) {
@@ -34,31 +34,105 @@ extern "C" {
 #include <cstdint>
 
 #include "el_config_porting.h"
+#include "el_uart_rx_we2.h"
 namespace edgelab {
 
 namespace porting {
 
-static lwRingBuffer*              _rb_rx = nullptr;
-static lwRingBuffer*              _rb_tx = nullptr;
-static char                       _buf_rx[32]{};
-static char                       _buf_tx[4095]{};
-volatile static bool              _tx_busy  = false;
-volatile static SemaphoreHandle_t _mutex_tx = nullptr;
-volatile static DEV_UART*         _uart     = nullptr;
+static lwRingBufferSPSC*          _rb_tx = nullptr;
+static UartRxWE2                  _rx{};
+volatile static size_t            _tx_chunk     = 0;
+volatile static bool              _tx_busy      = false;
+volatile static SemaphoreHandle_t _mutex_tx     = nullptr;
+volatile static DEV_UART*         _uart         = nullptr;
+static const char*                _tx_view      = nullptr;
+volatile static size_t            _tx_view_size = 0;
+volatile static el_send_done_cb_t _tx_done      = nullptr;
+static void*                      _tx_done_arg  = nullptr;
 
-void _uart_dma_recv(void*) {
-    _rb_rx->put(_buf_rx[0]);
-    _uart->uart_read_udma(_buf_rx, 1, (void*)_uart_dma_recv);
-}
+void _uart_dma_recv(void*) { _rx.on_recv(); }
 
+// the chunks are sent by DMA from the ring buffer in place, a chunk is released once its DMA is done
 void _uart_dma_send(void*) {
-    size_t     remaind                  = _rb_tx->size() < 4095 ? _rb_tx->size() : 4095;
-    _tx_busy                            = remaind != 0;
+    _rb_tx->consume(_tx_chunk);
+    size_t      remaind = 0;
+    const char* data    = _rb_tx->peek(&remaind);
+    remaind             = remaind < 4095 ? remaind : 4095;
+    _tx_chunk           = remaind;
+    _tx_busy            = remaind != 0;
     if (remaind != 0) {
-        _rb_tx->get(_buf_tx, remaind);
-        SCB_CleanDCache_by_Addr((volatile void*)_buf_tx, remaind);
-        _uart->uart_write_udma(_buf_tx, remaind, (void*)_uart_dma_send);
+        SCB_CleanDCache_by_Addr((volatile void*)data, remaind);
+        _uart->uart_write_udma((void*)data, remaind, (void*)_uart_dma_send);
+    }
+}
+
+void _uart_tx_done() {
+    el_send_done_cb_t done = _tx_done;
+    _tx_done               = nullptr;
+    if (done) done(_tx_done_arg);
+}
+
+// sends the view from the buffer of the caller directly, chunked by the size limit of a DMA transfer, the bytes queued
+// to the ring buffer meanwhile are sent after the view
+void _uart_dma_send_view(void*) {
+    size_t remaind = _tx_view_size < 4095 ? _tx_view_size : 4095;
+    if (remaind == 0) {
+        _uart_tx_done();
+        _uart_dma_send(nullptr);
+        return;
+    }
+    const char* data = _tx_view;
+    _tx_view += remaind;
+    _tx_view_size -= remaind;
+    _uart->uart_write_udma((void*)data, remaind, (void*)_uart_dma_send_view);
+}
+
+// the DMA in flight is aborted before its buffers are released, the bytes queued to the ring buffer are dropped with it
+void _uart_abort_tx() {
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    _uart->uart_control(UART_CMD_ABORT_TX, nullptr);
+    _rb_tx->clear();
+    _tx_chunk     = 0;
+    _tx_view_size = 0;
+    _tx_busy      = false;
+    __set_PRIMASK(primask);
+    _uart_tx_done();
+}
+
+size_t _uart_send_ring(const char* buffer, size_t size) {
+    size_t time_start = el_get_time_ms();
+    size_t bytes_to_send{0};
+    size_t sent = 0;
+
+    while (size) {
+        bytes_to_send = _rb_tx->put(buffer + sent, size);
+        size -= bytes_to_send;
+        sent += bytes_to_send;
+        if (!_tx_busy) {
+            _uart_dma_send(nullptr);
+        }
+        if (el_get_time_ms() - time_start > 3000) {
+            el_printf("\ntimeout\n");
+            _uart_abort_tx();
+            break;
+        }
+    }
+
+    return sent;
+}
+
+bool _uart_wait_tx_done() {
+    size_t time_start = el_get_time_ms();
+    while (_tx_busy) {
+        if (el_get_time_ms() - time_start > 3000) {
+            el_printf("\ntimeout\n");
+            _uart_abort_tx();
+            return false;
+        }
+        el_sleep(1);
     }
+    return true;
 }
 }  // namespace porting
 
@@ -75,23 +149,21 @@ el_err_code_t SerialWE2::init() {
     _console_uart = hx_drv_uart_get_dev((USE_DW_UART_E)0);
     _console_uart->uart_open(UART_BAUDRATE_921600);
 
-    if (!_rb_rx) [[likely]]
-        _rb_rx = new lwRingBuffer{8192};
-
     if (!_rb_tx) [[likely]]
-        _rb_tx = new lwRingBuffer{32768};
+        _rb_tx = new lwRingBufferSPSC{32768};
 
     _mutex_tx = xSemaphoreCreateMutex();
 
-    EL_ASSERT(_rb_rx);
     EL_ASSERT(_rb_tx);
     EL_ASSERT(_mutex_tx);
 
     _uart = _console_uart;
-    _uart->uart_read_udma(_buf_rx, 1, (void*)_uart_dma_recv);
+    if (_rx.init(_console_uart, 8192, _uart_dma_recv, this) != EL_OK) [[unlikely]]
+        return EL_ENOMEM;
 
     this->_is_present = _console_uart != nullptr;
     _tx_busy          = false;
+    _tx_chunk         = 0;
 
     return this->_is_present ? EL_OK : EL_EIO;
 }
@@ -102,11 +174,10 @@ el_err_code_t SerialWE2::deinit() {
 
     this->_is_present = !hx_drv_uart_deinit((USE_DW_UART_E)0) ? false : true;
 
-    delete _rb_rx;
+    _rx.deinit();
     delete _rb_tx;
     vSemaphoreDelete(_mutex_tx);
 
-    _rb_rx = nullptr;
     _rb_tx = nullptr;
     _mutex_tx = nullptr;
 
@@ -129,14 +200,16 @@ char SerialWE2::get_char() {
     if (!this->_is_present) [[unlikely]]
         return '\0';
 
-    return porting::_rb_rx->get();
+    _rx.poll();
+    return _rx.get_buffer()->get();
 }
 
 std::size_t SerialWE2::get_line(char* buffer, size_t size, const char delim) {
     if (!this->_is_present) [[unlikely]]
         return 0;
 
-    return porting::_rb_rx->extract(delim, buffer, size);
+    _rx.poll();
+    return _rx.get_buffer()->extract(delim, buffer, size);
 }
 
 std::size_t SerialWE2::read_bytes(char* buffer, size_t size) {
@@ -148,9 +221,10 @@ std::size_t SerialWE2::read_bytes(char* buffer, size_t size) {
     size_t pos_of_bytes{0};
 
     while (size) {
-        pos_of_bytes = _rb_rx->size();
+        _rx.poll();
+        pos_of_bytes = _rx.get_buffer()->size();
         if (pos_of_bytes) {
-            read += _rb_rx->get(buffer + read, size);
+            read += _rx.get_buffer()->get(buffer + read, size);
             size -= read;
         }
         if (el_get_time_ms() - time_start > 3000) {
@@ -165,34 +239,62 @@ std::size_t SerialWE2::send_bytes(const char* buffer, size_t size) {
     if (!this->_is_present) [[unlikely]]
         return 0;
 
-    size_t time_start = el_get_time_ms();
-    size_t bytes_to_send{0};
-    size_t sent = 0;
     xSemaphoreTake(_mutex_tx, portMAX_DELAY);
+    size_t sent = _uart_send_ring(buffer, size);
+    xSemaphoreGive(_mutex_tx);
 
-    //el_printf("\nsend: %d %d\n", size, _rb_tx->size());
+    return sent;
+}
 
-    while (size) {
-        bytes_to_send = _rb_tx->put(buffer + sent, size);
-        //el_printf("\nput: %d\n", bytes_to_send);
-        size -= bytes_to_send;
-        sent += bytes_to_send;
-        if (!_tx_busy) {
-            _tx_busy = true;
-            bytes_to_send = _rb_tx->size() < 4095 ? _rb_tx->size() : 4095;
-            _rb_tx->get(_buf_tx, bytes_to_send);
-            SCB_CleanDCache_by_Addr((volatile void*)_buf_tx, bytes_to_send);
-            _uart->uart_write_udma(_buf_tx, bytes_to_send, (void*)_uart_dma_send);
+// small views are queued to the ring buffer, large views (e.g. an encoded image) are sent by DMA from the views once
+// the ring buffer is drained, it returns once the last large view is started and done is called once its DMA is done,
+// if the ring buffer is not drained in time the DMA is aborted and the rest of the views is not sent, so that less
+// bytes than the views are returned and the caller could tell the truncated reply
+std::size_t SerialWE2::send_views(const el_buffer_view_t* views, size_t n, el_send_done_cb_t done, void* arg) {
+    if (!this->_is_present) [[unlikely]] {
+        if (done) done(arg);
+        return 0;
+    }
+
+    size_t last = n;
+    for (size_t i = 0; i < n; ++i)
+        if (views[i].size >= CONFIG_EL_TRANSPORT_DIRECT_SEND_SIZE_MIN) last = i;
+
+    size_t sent    = 0;
+    bool   pending = false;
+    xSemaphoreTake(_mutex_tx, portMAX_DELAY);
+
+    for (size_t i = 0; i < n; ++i) {
+        if (views[i].size < CONFIG_EL_TRANSPORT_DIRECT_SEND_SIZE_MIN) {
+            sent += _uart_send_ring(views[i].data, views[i].size);
+            continue;
         }
-        if (el_get_time_ms() - time_start > 3000) {
-            el_printf("\ntimeout\n");
-            _tx_busy = false;
+        if (!_uart_wait_tx_done()) [[unlikely]]
             break;
-        }
+        pending       = i == last;
+        _tx_done      = pending ? done : nullptr;
+        _tx_done_arg  = arg;
+        _tx_view      = views[i].data;
+        _tx_view_size = views[i].size;
+        _tx_busy      = true;
+        SCB_CleanDCache_by_Addr((volatile void*)_tx_view, _tx_view_size);
+        _uart_dma_send_view(nullptr);
+        sent += views[i].size;
     }
 
     xSemaphoreGive(_mutex_tx);
+
+    if (!pending && done) done(arg);  // no view is referenced
     return sent;
 }
 
+void SerialWE2::abort_views() {
+    if (!this->_is_present) [[unlikely]]
+        return;
+
+    xSemaphoreTake(_mutex_tx, portMAX_DELAY);
+    if (_tx_busy) _uart_abort_tx();
+    xSemaphoreGive(_mutex_tx);
+}
+
 }  // namespace edgelab
\ No newline at end of file
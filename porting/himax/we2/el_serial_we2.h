@@ -48,6 +48,13 @@ class SerialWE2 final : public Serial {
 
     std::size_t read_bytes(char* buffer, size_t size) override;
     std::size_t send_bytes(const char* buffer, size_t size) override;
+    std::size_t send_views(const el_buffer_view_t* views,
+                           size_t                  n,
+                           el_send_done_cb_t       done = nullptr,
+                           void*                   arg  = nullptr) override;
+    void        abort_views() override;
+
+    bool is_recv_notified() const override { return true; }
 
    private:
     DEV_UART* _console_uart;
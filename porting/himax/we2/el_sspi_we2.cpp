@@ -45,7 +45,12 @@ static void sspi_txcb(void* param) {
     //     el_printf("0x%02x%s", sspi_ptr->tx_buffer[i], ((i + 1) % 16) ? " " : "\n");
     // }
     memset(sspi_ptr->tx_buffer, 0, sizeof(sspi_ptr->tx_buffer));
-    if (sspi_ptr->tx_ring_buffer->isEmpty()) {
+    if (sspi_ptr->tx_view_chunk) {
+        sspi_ptr->tx_view += sspi_ptr->tx_view_chunk;
+        sspi_ptr->tx_view_size -= sspi_ptr->tx_view_chunk;
+        sspi_ptr->tx_view_chunk = 0;
+    }
+    if (sspi_ptr->tx_ring_buffer->isEmpty() && !sspi_ptr->tx_view_size) {
         hx_drv_gpio_set_output(CONFIG_EL_SPI_CTRL_PIN, GPIO_OUT_LOW);
     }
     sspi_ptr->sspi_read_enable(sizeof(sspi_ptr->rx_buffer));
@@ -71,8 +76,13 @@ static void sspi_rxcb(void* param) {
     case FEATURE_TRANSPORT_CMD_WRITE:
         sspi_ptr->rx_ring_buffer->put((char*)&sspi_ptr->rx_buffer[4], len);
         sspi_ptr->sspi_read_enable(sizeof(sspi_ptr->rx_buffer));
+        sspi_ptr->notify_recv_from_isr();
         break;
     case FEATURE_TRANSPORT_CMD_READ:
+        if (sspi_ptr->tx_view_size && sspi_ptr->tx_ring_buffer->isEmpty()) {
+            sspi_ptr->sspi_write_view_enable(len);
+            break;
+        }
         if (len > sspi_ptr->tx_ring_buffer->size()) {
             len = sspi_ptr->tx_ring_buffer->size();
         }
@@ -80,14 +90,20 @@ static void sspi_rxcb(void* param) {
         sspi_ptr->tx_ring_buffer->get((char*)&sspi_ptr->tx_buffer[0], len);
         sspi_ptr->sspi_write_enable(len);
         break;
-    case FEATURE_TRANSPORT_CMD_AVAILABLE:
-        sspi_ptr->tx_buffer[0] = (sspi_ptr->tx_ring_buffer->size() >> 8) & 0xff;
-        sspi_ptr->tx_buffer[1] = sspi_ptr->tx_ring_buffer->size() & 0xff;
+    case FEATURE_TRANSPORT_CMD_AVAILABLE: {
+        size_t available = sspi_ptr->tx_ring_buffer->size() + sspi_ptr->tx_view_size;
+        available        = available > 0xffff ? 0xffff : available;
+
+        sspi_ptr->tx_buffer[0] = (available >> 8) & 0xff;
+        sspi_ptr->tx_buffer[1] = available & 0xff;
         sspi_ptr->sspi_write_enable(2);
         break;
+    }
     case FEATURE_TRANSPORT_CMD_RESET:
         sspi_ptr->rx_ring_buffer->clear();
         sspi_ptr->tx_ring_buffer->clear();
+        sspi_ptr->tx_view_size  = 0;
+        sspi_ptr->tx_view_chunk = 0;
         sspi_ptr->sspi_read_enable(sizeof(sspi_ptr->rx_buffer));
         hx_drv_gpio_set_output(CONFIG_EL_SPI_CTRL_PIN, GPIO_OUT_LOW);
         break;
@@ -101,7 +117,7 @@ static void sspi_rxcb(void* param) {
 
 using namespace porting;
 
-sspiWE2::sspiWE2() {}
+sspiWE2::sspiWE2() : tx_view(nullptr), tx_view_size(0), tx_view_chunk(0) {}
 
 sspiWE2::~sspiWE2() { deinit(); }
 
@@ -205,6 +221,52 @@ size_t sspiWE2::send_bytes(const char* buffer, size_t size) {
     return len;
 }
 
+// small views are queued to the ring buffer, a large view (e.g. an encoded image) is read by the host from the view
+// once the ring buffer is drained, it returns once the host has read the views
+size_t sspiWE2::send_views(const el_buffer_view_t* views, size_t n, el_send_done_cb_t done, void* arg) {
+    size_t sent = 0;
+    for (size_t i = 0; i < n && this->_is_present; ++i) {
+        if (views[i].size < CONFIG_EL_TRANSPORT_DIRECT_SEND_SIZE_MIN) {
+            sent += send_bytes(views[i].data, views[i].size);
+            continue;
+        }
+        // the host is given up if no bytes are read for a while
+        uint32_t ts   = xTaskGetTickCount();
+        size_t   prev = this->tx_ring_buffer->size();
+        while (!this->tx_ring_buffer->isEmpty()) {
+            if (this->tx_ring_buffer->size() != prev) {
+                prev = this->tx_ring_buffer->size();
+                ts   = xTaskGetTickCount();
+            }
+            if (xTaskGetTickCount() - ts > 1000) goto Timeout;
+            el_sleep(5);
+        }
+        hx_CleanDCache_by_Addr((void*)views[i].data, views[i].size);
+        this->tx_view      = views[i].data;
+        this->tx_view_size = views[i].size;
+        hx_drv_gpio_set_output(CONFIG_EL_SPI_CTRL_PIN, GPIO_OUT_HIGH);
+        ts   = xTaskGetTickCount();
+        prev = this->tx_view_size;
+        while (this->tx_view_size) {
+            if (this->tx_view_size != prev) {
+                prev = this->tx_view_size;
+                ts   = xTaskGetTickCount();
+            }
+            if (xTaskGetTickCount() - ts > 1000) goto Timeout;
+            el_sleep(5);
+        }
+        sent += views[i].size;
+    }
+    if (done) done(arg);
+    return sent;
+
+Timeout:
+    EL_LOGW("TX view not read by host, cannot send data\n");
+    this->sspi_abort_view();
+    if (done) done(arg);
+    return sent;
+}
+
 void sspiWE2::sspi_read_enable(size_t size) {
     // el_printf("re: %d\n", size);
     memset(this->rx_buffer, 0, sizeof(this->rx_buffer));
@@ -219,4 +281,26 @@ void sspiWE2::sspi_write_enable(size_t size) {
     this->spi->spi_write_dma(this->tx_buffer, size, (void*)sspi_txcb);
 }
 
+// the DMA reading the view (if any) is aborted before the view is released, the slave is armed again to receive the next
+// command since the callback of the aborted DMA never comes
+void sspiWE2::sspi_abort_view() {
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    bool is_writing = this->tx_view_chunk != 0;
+    if (is_writing) this->spi->spi_control(SPI_CMD_ABORT_TX, nullptr);
+    this->tx_view_size  = 0;
+    this->tx_view_chunk = 0;
+    this->tx_ring_buffer->clear();
+    __set_PRIMASK(primask);
+
+    hx_drv_gpio_set_output(CONFIG_EL_SPI_CTRL_PIN, GPIO_OUT_LOW);
+    if (is_writing) this->sspi_read_enable(sizeof(this->rx_buffer));
+}
+
+// the view is cleaned from the cache once before being read
+void sspiWE2::sspi_write_view_enable(size_t size) {
+    this->tx_view_chunk = size > this->tx_view_size ? this->tx_view_size : size;
+    this->spi->spi_write_dma((void*)this->tx_view, this->tx_view_chunk, (void*)sspi_txcb);
+}
+
 }  // namespace edgelab
@@ -67,17 +67,30 @@ class sspiWE2 final : public SSPI {
 
     size_t read_bytes(char* buffer, size_t size) override;
     size_t send_bytes(const char* buffer, size_t size) override;
+    size_t send_views(const el_buffer_view_t* views,
+                      size_t                  n,
+                      el_send_done_cb_t       done = nullptr,
+                      void*                   arg  = nullptr) override;
 
     size_t available() override;
 
+    bool is_recv_notified() const override { return true; }
+
     uint8_t       rx_buffer[SPI_READ_PL_LEN];
     uint8_t       tx_buffer[SPI_WRITE_PL_LEN];
     lwRingBuffer* rx_ring_buffer;
     lwRingBuffer* tx_ring_buffer;
     DEV_SPI_PTR   spi;
 
+    // a large view read by the host directly from the buffer of the caller once the ring buffer is drained
+    const char*     tx_view;
+    volatile size_t tx_view_size;
+    volatile size_t tx_view_chunk;  // bytes of the view being read, the view is advanced once they are read
+
     void sspi_read_enable(size_t size);
     void sspi_write_enable(size_t size);
+    void sspi_write_view_enable(size_t size);
+    void sspi_abort_view();
 };
 
 }  // namespace edgelab
@@ -0,0 +1,240 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2023 Seeed Technology Co.,Ltd
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#include "el_uart_rx_we2.h"
+
+#include <cstring>
+
+#include "el_config_porting.h"
+
+namespace edgelab {
+
+namespace {
+
+// the blocks are whole data cache lines of the Cortex-M55, so that the lines invalidated for a block are never shared
+// with other data
+constexpr size_t cache_line_size = 32u;
+
+static_assert(CONFIG_EL_TRANSPORT_RECV_BLOCK_SIZE % cache_line_size == 0);
+
+inline size_t align_down(size_t size) { return size & ~(cache_line_size - 1u); }
+
+}  // namespace
+
+UartRxWE2::UartRxWE2()
+    : _uart(nullptr),
+      _rb(nullptr),
+      _recv(nullptr),
+      _transport(nullptr),
+      _idle_timer(nullptr),
+      _block(nullptr),
+      _block_size(0),
+      _block_read(0),
+      _wake_at(0),
+      _is_armed(false),
+      _is_waking(false) {}
+
+UartRxWE2::~UartRxWE2() { deinit(); }
+
+el_err_code_t UartRxWE2::init(DEV_UART* uart, size_t size, void (*recv)(void*), const Transport* transport) {
+    // the blocks are reserved from the tail, which is kept aligned by committing whole blocks only
+    if (!_rb) [[likely]]
+        _rb = new lwRingBufferSPSC{size < cache_line_size ? cache_line_size : size, cache_line_size};
+    if (!_rb) [[unlikely]]
+        return EL_ENOMEM;
+
+    _uart      = uart;
+    _recv      = recv;
+    _transport = transport;
+    _is_armed  = false;
+
+    // the timer is started by the first byte received
+    if (!_idle_timer) [[likely]] {
+        TickType_t period = pdMS_TO_TICKS(CONFIG_EL_TRANSPORT_RECV_IDLE_MS);
+        _idle_timer       = xTimerCreate("uart#rx", period ? period : 1, pdFALSE, this, &UartRxWE2::m_on_idle);
+        if (!_idle_timer) [[unlikely]]
+            return EL_ENOMEM;
+    }
+
+    m_arm(true);
+
+    return EL_OK;
+}
+
+void UartRxWE2::deinit() {
+    if (_idle_timer) [[likely]] {
+        xTimerDelete(_idle_timer, portMAX_DELAY);
+        _idle_timer = nullptr;
+    }
+
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    bool is_armed = _is_armed;
+    _is_armed     = false;
+    __set_PRIMASK(primask);
+
+    // the armed block is written by DMA until the transfer is aborted, the ring buffer is kept for the next init() if
+    // the transfer could not be aborted
+    if (is_armed && _uart && _uart->uart_control(UART_CMD_ABORT_RX, nullptr) != 0) [[unlikely]] {
+        _uart      = nullptr;
+        _transport = nullptr;
+        return;
+    }
+    _uart      = nullptr;
+    _transport = nullptr;
+
+    delete _rb;
+    _rb = nullptr;
+}
+
+void UartRxWE2::on_recv() {
+    if (!_is_armed) [[unlikely]]
+        return;
+
+    // the first byte after an idle line, the rest of the block is read unless the byte is the last one of the block
+    if (_is_waking) {
+        _is_waking = false;
+        if (_wake_at + 1 < _block_size) [[likely]] {
+            _uart->uart_read_udma(_block + _wake_at + 1, _block_size - _wake_at - 1, (void*)_recv);
+            m_start_timer_from_isr();
+            return;
+        }
+    }
+
+    // the rest of the block is not yet published by poll()
+    size_t from = align_down(_block_read);
+    SCB_InvalidateDCache_by_Addr((volatile void*)(_block + from), _block_size - from);
+    _rb->commit(_block_size - _block_read);
+    _is_armed = false;
+
+    m_arm(false);
+    m_start_timer_from_isr();
+    if (_transport) [[likely]]
+        _transport->notify_recv_from_isr();
+}
+
+void UartRxWE2::poll() {
+    if (!_rb) [[unlikely]]
+        return;
+
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+
+    bool is_armed = _is_armed;
+    if (is_armed) [[likely]]
+        m_flush();
+    else
+        m_arm(false);  // the ring buffer was full when the last block is done
+
+    __set_PRIMASK(primask);
+
+    // the timer flushes the new block until the line is idle
+    if (!is_armed && _is_armed && _idle_timer) [[unlikely]]
+        xTimerReset(_idle_timer, 0);
+}
+
+// the bytes written so far are found by the first '\0' of the fill (the commands are text)
+size_t UartRxWE2::m_flush() {
+    char*  data = _block + _block_read;
+    size_t size = _block_size - _block_read;
+    size_t from = align_down(_block_read);
+    SCB_InvalidateDCache_by_Addr((volatile void*)(_block + from), _block_size - from);
+    const char* end = static_cast<const char*>(std::memchr(data, '\0', size));
+    size_t      len = end ? end - data : size;
+    _rb->commit(len);
+    _block_read += len;
+    return len;
+}
+
+void UartRxWE2::m_start_timer_from_isr() {
+    BaseType_t is_woken = pdFALSE;
+    if (_idle_timer) [[likely]]
+        xTimerResetFromISR(_idle_timer, &is_woken);
+    portYIELD_FROM_ISR(is_woken);
+}
+
+// runs on the timer task, the reader is woken up only if any byte is flushed, the timer is started again until a flush
+// finds nothing, then the transfer is aborted and the rest of the block is re-armed to wake up on the next byte
+void UartRxWE2::m_on_idle(TimerHandle_t timer) {
+    auto* rx = static_cast<UartRxWE2*>(pvTimerGetTimerID(timer));
+
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    size_t len      = rx->_is_armed ? rx->m_flush() : 0;
+    bool   is_idle  = !len && rx->_is_armed && !rx->_is_waking;
+    bool   is_again = len;
+    if (is_idle) [[unlikely]]
+        rx->_is_armed = false;  // the callback of the aborted transfer is ignored
+    __set_PRIMASK(primask);
+
+    if (is_idle) [[unlikely]] {
+        bool is_aborted = rx->_uart->uart_control(UART_CMD_ABORT_RX, nullptr) == 0;
+
+        __disable_irq();
+        rx->_is_armed = true;
+        len           = rx->m_flush();  // bytes written before the transfer is aborted
+        is_again      = len || !is_aborted;
+        // the timer tries again if the transfer is still running
+        if (is_aborted) [[likely]] {
+            if (rx->_block_read < rx->_block_size) [[likely]]
+                rx->m_read(!len);
+            else {
+                rx->_is_armed = false;
+                rx->m_arm(!len);
+            }
+        }
+        __set_PRIMASK(primask);
+    }
+
+    if (is_again) [[unlikely]]
+        xTimerReset(timer, 0);
+    if (len && rx->_transport) [[unlikely]]
+        rx->_transport->notify_recv();
+}
+
+void UartRxWE2::m_arm(bool is_waking) {
+    size_t size = 0;
+    char*  data = _rb->reserve(&size);
+    size        = align_down(size < CONFIG_EL_TRANSPORT_RECV_BLOCK_SIZE ? size : CONFIG_EL_TRANSPORT_RECV_BLOCK_SIZE);
+    if (size == 0 || !_uart) [[unlikely]]
+        return;
+
+    std::memset(data, '\0', size);
+    SCB_CleanDCache_by_Addr((volatile void*)data, size);
+
+    _block      = data;
+    _block_size = size;
+    _block_read = 0;
+    _is_armed   = true;
+    m_read(is_waking);
+}
+
+void UartRxWE2::m_read(bool is_waking) {
+    _is_waking = is_waking;
+    _wake_at   = _block_read;
+    _uart->uart_read_udma(_block + _block_read, is_waking ? 1 : _block_size - _block_read, (void*)_recv);
+}
+
+}  // namespace edgelab
@@ -0,0 +1,101 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2023 Seeed Technology Co.,Ltd
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#ifndef _EL_UART_RX_WE2_H_
+#define _EL_UART_RX_WE2_H_
+
+extern "C" {
+#include <hx_drv_uart.h>
+}
+
+#include <FreeRTOS.h>
+#include <timers.h>
+
+#include <cstddef>
+
+#include "core/utils/el_ringbuffer.hpp"
+#include "porting/el_transport.h"
+
+namespace edgelab {
+
+// receives by DMA in blocks written in place to the free region of the ring buffer, a block is re-armed from the DMA
+// callback once it is done, the bytes of a partially received block are published by poll() on the reader side, the
+// block is filled with '\0' before armed and the bytes written by DMA so far are found by the first '\0' (the commands
+// are text), so that an idle line is flushed without waiting for the block to be done, the driver takes one read at a
+// time, so instead of double buffering the next block is armed from the callback in the free region of the ring buffer,
+// which buffers the bytes until they are read, the blocks and the ring buffer are aligned to the data cache lines, the
+// driver has no RX timeout interrupt for DMA reads, so while bytes are arriving a partially received block is flushed
+// by a one-shot timer which notifies the transport, once a flush finds nothing the line is idle, the transfer is
+// aborted and the rest of the block is read by a single byte transfer first, whose callback starts the timer again, so
+// that a short command wakes up the reader and nothing runs while the line is idle
+class UartRxWE2 {
+   public:
+    UartRxWE2();
+    ~UartRxWE2();
+
+    UartRxWE2(const UartRxWE2&)            = delete;
+    UartRxWE2& operator=(const UartRxWE2&) = delete;
+
+    // recv is passed to the DMA as the callback and should call on_recv(), the transport is notified once a block is done
+    el_err_code_t init(DEV_UART* uart, size_t size, void (*recv)(void*), const Transport* transport);
+    void          deinit();
+
+    // called from the DMA callback (ISR)
+    void on_recv();
+
+    // called by the reader before reading the ring buffer
+    void poll();
+
+    inline lwRingBufferSPSC* get_buffer() { return _rb; }
+
+   protected:
+    void m_arm(bool is_waking);
+    // reads the rest of the armed block, only one byte if waking up from an idle line
+    void m_read(bool is_waking);
+    // publishes the bytes of the armed block written by DMA so far, returns the number of bytes published
+    size_t m_flush();
+
+    void m_start_timer_from_isr();
+
+    static void m_on_idle(TimerHandle_t timer);
+
+   private:
+    DEV_UART*         _uart;
+    lwRingBufferSPSC* _rb;
+    void (*_recv)(void*);
+    const Transport* _transport;
+    TimerHandle_t    _idle_timer;
+
+    char* volatile _block;
+    volatile size_t _block_size;
+    volatile size_t _block_read;
+    volatile size_t _wake_at;
+    volatile bool   _is_armed;
+    volatile bool   _is_waking;
+};
+
+}  // namespace edgelab
+
+#endif
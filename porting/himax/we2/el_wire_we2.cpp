@@ -88,6 +88,7 @@ static void i2c_s_callback_fun_rx(void* param) {
         wire->rx_ring_buffer->put((char*)&wire->rx_buffer[4], len);
         // }
         wire->wire_read_enable(sizeof(wire->rx_buffer));
+        wire->notify_recv_from_isr();
         break;
     case FEATURE_TRANSPORT_CMD_READ:
         if (len > wire->tx_ring_buffer->size()) {
@@ -81,6 +81,8 @@ class WireWE2 final : public Wire {
 
     size_t available() override;
 
+    bool is_recv_notified() const override { return true; }
+
    public:
     void wire_read_enable(size_t size);
     void wire_write_enable(size_t size);
@@ -0,0 +1,67 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2023 Seeed Technology Co.,Ltd
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#ifndef _EL_BENCHMARK_COMMON_H_
+#define _EL_BENCHMARK_COMMON_H_
+
+#include <cstddef>
+
+#include "core/el_types.h"
+
+// helpers shared by the host benchmarks
+namespace edgelab::benchmark {
+
+inline const char* format_name(el_pixel_format_t format) {
+    switch (format) {
+    case EL_PIXEL_FORMAT_RGB888:
+        return "rgb888";
+    case EL_PIXEL_FORMAT_RGB565:
+        return "rgb565";
+    case EL_PIXEL_FORMAT_YUV422:
+        return "yuv422";
+    case EL_PIXEL_FORMAT_GRAYSCALE:
+        return "gray";
+    case EL_PIXEL_FORMAT_JPEG:
+        return "jpeg";
+    default:
+        return "unknown";
+    }
+}
+
+inline std::size_t bytes_per_pixel(el_pixel_format_t format) {
+    switch (format) {
+    case EL_PIXEL_FORMAT_RGB888:
+        return 3;
+    case EL_PIXEL_FORMAT_RGB565:
+    case EL_PIXEL_FORMAT_YUV422:
+        return 2;
+    default:
+        return 1;
+    }
+}
+
+}  // namespace edgelab::benchmark
+
+#endif
@@ -0,0 +1,326 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2023 Seeed Technology Co.,Ltd
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+// microbenchmarks of the core/utils kernels on host, inputs are synthetic and generated from a fixed seed so that the
+// numbers are comparable between commits, the results are printed to stdout as JSON
+//
+//   el_benchmark_kernels [filter] [min_time_ms=200]
+//
+// only the benchmarks whose name contains filter are run, e.g. "nms" or "convert/rgb565"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <forward_list>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "core/el_types.h"
+#include "core/utils/el_base64.h"
+#include "core/utils/el_cv.h"
+#include "core/utils/el_hash.h"
+#include "core/utils/el_nms.h"
+#include "core/utils/el_ringbuffer.hpp"
+#include "el_benchmark_common.h"
+#include "sscma/callback/extension/results_filter.hpp"
+
+using namespace edgelab;
+using namespace edgelab::benchmark;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr uint32_t SEED = 0x5eed;
+
+const char* _filter      = "";
+uint64_t    _min_time_ns = 200'000'000;
+bool        _first       = true;
+
+inline uint64_t _ns(Clock::duration d) { return std::chrono::duration_cast<std::chrono::nanoseconds>(d).count(); }
+
+// keeps the compiler from optimizing out the benchmarked calls
+template <typename T> inline void _keep(T const& v) { asm volatile("" : : "r,m"(v) : "memory"); }
+
+void report(const char* name, uint64_t iterations, uint64_t total_ns, double units, const char* unit) {
+    double ns_per_iter = static_cast<double>(total_ns) / iterations;
+    std::printf("%s\n    {\"name\": \"%s\", \"iterations\": %llu, \"ns_per_iter\": %.1f, \"%s_per_s\": %.1f}",
+                _first ? "" : ",",
+                name,
+                static_cast<unsigned long long>(iterations),
+                ns_per_iter,
+                unit,
+                units * 1e9 / ns_per_iter);
+    std::fflush(stdout);
+    _first = false;
+}
+
+inline bool selected(const std::string& name) { return name.find(_filter) != std::string::npos; }
+
+// runs fn in batches until the minimal time is reached, units are the bytes or items processed per call
+template <typename Fn> void bench(const std::string& name, double units, const char* unit, Fn&& fn) {
+    if (!selected(name)) return;
+    fn();  // warm up
+    uint64_t iterations = 0, batch = 1, elapsed = 0;
+    while (elapsed < _min_time_ns) {
+        auto start = Clock::now();
+        for (uint64_t i = 0; i < batch; ++i) fn();
+        elapsed += _ns(Clock::now() - start);
+        iterations += batch;
+        if (batch < (1u << 20)) batch <<= 1;
+    }
+    report(name.c_str(), iterations, elapsed, units, unit);
+}
+
+// same as bench() but setup is called untimed before each call of fn, for kernels that consume their input
+template <typename Setup, typename Fn>
+void bench_each(const std::string& name, double units, const char* unit, Setup&& setup, Fn&& fn) {
+    if (!selected(name)) return;
+    uint64_t iterations = 0, elapsed = 0;
+    while (elapsed < _min_time_ns) {
+        setup();
+        auto start = Clock::now();
+        fn();
+        elapsed += _ns(Clock::now() - start);
+        ++iterations;
+    }
+    report(name.c_str(), iterations, elapsed, units, unit);
+}
+
+// a gradient with noise, so that JPEG does not degenerate on flat or pure noise input
+std::vector<uint8_t> make_image(uint16_t width, uint16_t height, el_pixel_format_t format, std::mt19937& rng) {
+    std::vector<uint8_t> data(width * height * bytes_per_pixel(format));
+    std::uniform_int_distribution<int> noise(-16, 16);
+    for (std::size_t i = 0; i < data.size(); ++i) {
+        std::size_t pixel = i / bytes_per_pixel(format);
+        int         v     = static_cast<int>((pixel % width) * 255 / width + (pixel / width) * 255 / height) / 2;
+        data[i]           = static_cast<uint8_t>(std::clamp(v + noise(rng), 0, 255));
+    }
+    return data;
+}
+
+std::forward_list<el_box_t> make_boxes(std::size_t count, bool dense, std::mt19937& rng) {
+    std::forward_list<el_box_t>             boxes;
+    std::uniform_int_distribution<uint16_t> x(0, 639), y(0, 479), size(20, 60), jitter(0, 8);
+    std::uniform_int_distribution<uint16_t> score(10, 100), target(0, 3);
+    // dense boxes are clustered around 8 centers, so that most of them overlap
+    std::vector<std::pair<uint16_t, uint16_t>> centers;
+    for (int i = 0; i < 8; ++i) centers.emplace_back(x(rng), y(rng));
+    for (std::size_t i = 0; i < count; ++i) {
+        el_box_t box{};
+        if (dense) {
+            auto& c = centers[i % centers.size()];
+            box.x   = c.first + jitter(rng);
+            box.y   = c.second + jitter(rng);
+            box.w   = 40 + jitter(rng);
+            box.h   = 40 + jitter(rng);
+        } else {
+            box.x = x(rng);
+            box.y = y(rng);
+            box.w = size(rng);
+            box.h = size(rng);
+        }
+        box.score  = static_cast<uint8_t>(score(rng));
+        box.target = target(rng);
+        boxes.emplace_front(box);
+    }
+    return boxes;
+}
+
+void bench_convert(std::mt19937& rng) {
+    static const el_pixel_format_t formats[] = {
+      EL_PIXEL_FORMAT_RGB888, EL_PIXEL_FORMAT_RGB565, EL_PIXEL_FORMAT_GRAYSCALE};
+    static const el_pixel_rotate_t rotates[] = {
+      EL_PIXEL_ROTATE_0, EL_PIXEL_ROTATE_90, EL_PIXEL_ROTATE_180, EL_PIXEL_ROTATE_270};
+    static const unsigned scales[] = {1, 2, 4};
+
+    constexpr uint16_t width = 640, height = 480;
+
+    for (auto src_format : formats) {
+        auto     src_data = make_image(width, height, src_format, rng);
+        el_img_t src{.data   = src_data.data(),
+                     .size   = src_data.size(),
+                     .width  = width,
+                     .height = height,
+                     .format = src_format,
+                     .rotate = EL_PIXEL_ROTATE_0};
+        for (auto dst_format : formats)
+            for (auto rotate : rotates)
+                for (auto scale : scales) {
+                    uint16_t w = width / scale, h = height / scale;
+                    if (rotate == EL_PIXEL_ROTATE_90 || rotate == EL_PIXEL_ROTATE_270) std::swap(w, h);
+                    std::vector<uint8_t> dst_data(w * h * bytes_per_pixel(dst_format));
+                    el_img_t             dst{.data   = dst_data.data(),
+                                             .size   = dst_data.size(),
+                                             .width  = w,
+                                             .height = h,
+                                             .format = dst_format,
+                                             .rotate = rotate};
+                    src.rotate = rotate;
+                    bench(std::string("convert/") + format_name(src_format) + "/" + format_name(dst_format) +
+                            "/rot" + std::to_string(static_cast<int>(rotate) * 90) + "/1:" + std::to_string(scale),
+                          src.size,
+                          "bytes",
+                          [&] { el_img_convert(&src, &dst); });
+                }
+    }
+}
+
+void bench_nms(std::mt19937& rng) {
+    for (std::size_t count : {16, 128, 1024})
+        for (bool dense : {false, true}) {
+            auto                        boxes = make_boxes(count, dense, rng);
+            std::forward_list<el_box_t> work;
+            bench_each(std::string("nms/") + (dense ? "dense/" : "sparse/") + std::to_string(count),
+                       count,
+                       "boxes",
+                       [&] { work = boxes; },
+                       [&] { _keep(el_nms(work, 45, 50)); });
+        }
+}
+
+void bench_base64(std::mt19937& rng) {
+    for (std::size_t size : {48, 4096, 65536}) {
+        std::vector<uint8_t> in(size);
+        std::vector<char>    out(((size + 2) / 3) * 4 + 1);
+        for (auto& b : in) b = static_cast<uint8_t>(rng());
+        bench("base64/" + std::to_string(size), size, "bytes", [&] {
+            el_base64_encode(in.data(), static_cast<int>(in.size()), out.data());
+            _keep(out[0]);
+        });
+    }
+}
+
+void bench_crc16(std::mt19937& rng) {
+    for (std::size_t size : {64, 4096, 65536}) {
+        std::vector<uint8_t> in(size);
+        for (auto& b : in) b = static_cast<uint8_t>(rng());
+        bench("crc16_maxim/" + std::to_string(size), size, "bytes", [&] { _keep(el_crc16_maxim(in.data(), size)); });
+    }
+}
+
+void bench_jpeg(std::mt19937& rng) {
+    static const el_pixel_format_t formats[] = {
+      EL_PIXEL_FORMAT_RGB888, EL_PIXEL_FORMAT_RGB565, EL_PIXEL_FORMAT_GRAYSCALE};
+
+    constexpr uint16_t width = 320, height = 240;
+
+    for (auto format : formats) {
+        auto                 src_data = make_image(width, height, format, rng);
+        std::vector<uint8_t> dst_data(src_data.size());
+        el_img_t             src{.data   = src_data.data(),
+                                 .size   = src_data.size(),
+                                 .width  = width,
+                                 .height = height,
+                                 .format = format,
+                                 .rotate = EL_PIXEL_ROTATE_0};
+        for (uint8_t quality : {EL_JPEG_QUALITY_HIGH, EL_JPEG_QUALITY_LOW})
+            for (uint8_t subsample : {EL_JPEG_SUBSAMPLE_444, EL_JPEG_SUBSAMPLE_420}) {
+                el_jpeg_config_t config{.quality = quality, .subsample = subsample, .max_size = 0};
+                bench(std::string("jpeg/") + format_name(format) + "/q" + std::to_string(quality) +
+                        (subsample == EL_JPEG_SUBSAMPLE_420 ? "/420" : "/444"),
+                      src.size,
+                      "bytes",
+                      [&] {
+                          el_img_t dst{.data   = dst_data.data(),
+                                       .size   = dst_data.size(),
+                                       .width  = width,
+                                       .height = height,
+                                       .format = EL_PIXEL_FORMAT_JPEG,
+                                       .rotate = EL_PIXEL_ROTATE_0};
+                          _keep(el_img_encode_jpeg(&src, &dst, &config));
+                      });
+            }
+    }
+}
+
+template <typename RingBufferType> void bench_ringbuffer(const std::string& prefix, std::mt19937& rng) {
+    RingBufferType rb{8192};
+    char           chunk[64]{};
+    for (auto& c : chunk) c = static_cast<char>('a' + rng() % 26);
+
+    bench(prefix + "/put_get/64", sizeof(chunk), "bytes", [&] {
+        rb.put(chunk, sizeof(chunk));
+        _keep(rb.get(chunk, sizeof(chunk)));
+    });
+
+    // AT command lines as they arrive from a transport
+    const char line[] = "AT+INVOKE=1,0,1\r\n";
+    char       out[64]{};
+    bench(prefix + "/put_extract/line", sizeof(line) - 1, "bytes", [&] {
+        rb.put(line, sizeof(line) - 1);
+        _keep(rb.extract('\n', out, sizeof(out)));
+    });
+
+    // extract scans the whole buffered data when there is no delimiter yet
+    rb.clear();
+    for (std::size_t i = 0; i + sizeof(chunk) < rb.capacity(); i += sizeof(chunk)) rb.put(chunk, sizeof(chunk));
+    bench(prefix + "/extract_miss/8k", rb.size(), "bytes", [&] { _keep(rb.extract('\n', out, sizeof(out))); });
+}
+
+void bench_results_filter(std::mt19937& rng) {
+    for (std::size_t count : {8, 64}) {
+        auto boxes   = make_boxes(count, false, rng);
+        auto changed = boxes;
+        changed.front().x += 100;
+
+        sscma::extension::ResultsFilter<el_box_t> same_filter(boxes);
+        bench("results_filter/same/" + std::to_string(count), count, "items", [&] {
+            _keep(same_filter.compare_and_update(boxes));
+        });
+
+        sscma::extension::ResultsFilter<el_box_t> changed_filter(boxes);
+        bool                                      flip = false;
+        bench("results_filter/changed/" + std::to_string(count), count, "items", [&] {
+            _keep(changed_filter.compare_and_update((flip = !flip) ? changed : boxes));
+        });
+    }
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    if (argc > 1) _filter = argv[1];
+    if (argc > 2) _min_time_ns = std::strtoull(argv[2], nullptr, 10) * 1'000'000;
+
+    std::mt19937 rng{SEED};
+
+    std::printf("{\n  \"seed\": %u,\n  \"benchmarks\": [", SEED);
+    bench_convert(rng);
+    bench_nms(rng);
+    bench_base64(rng);
+    bench_crc16(rng);
+    bench_jpeg(rng);
+    bench_ringbuffer<lwRingBuffer>("ringbuffer", rng);
+    bench_ringbuffer<lwRingBufferSPSC>("ringbuffer_spsc", rng);
+    bench_results_filter(rng);
+    std::printf("\n  ]\n}\n");
+
+    return 0;
+}
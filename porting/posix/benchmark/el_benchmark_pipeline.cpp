@@ -0,0 +1,264 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2023 Seeed Technology Co.,Ltd
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+// end-to-end benchmark of the algorithm pipeline on host, the results are printed to stdout as JSON
+//
+//   el_benchmark_pipeline <model.tflite> <frames> [iterations=100] [arena_kb=2048]
+//
+// frames is a PPM or raw frame file or a directory of them (see CameraPosix), every algorithm that accepts the model is
+// benchmarked, followed by the el_img_convert matrix of formats, rotations and scales on the first frame, allocations
+// and the heap peak above the live bytes are counted per frame by el_heap
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "core/algorithm/el_algorithm_delegate.h"
+#include "core/el_types.h"
+#include "core/engine/el_engine_tflite.h"
+#include "core/utils/el_cv.h"
+#include "core/utils/el_heap.h"
+#include "el_benchmark_common.h"
+#include "el_camera_posix.h"
+#include "porting/el_misc.h"
+
+#if !CONFIG_EL_HEAP_ACCOUNTING
+    #error "allocations are counted by el_heap, build the benchmark with CONFIG_EL_HEAP_ACCOUNTING=1"
+#endif
+
+using namespace edgelab;
+using namespace edgelab::benchmark;
+
+namespace {
+
+struct Stats {
+    std::vector<uint32_t> samples;
+
+    void add(uint32_t v) { samples.push_back(v); }
+
+    uint32_t percentile(std::vector<uint32_t>& sorted, unsigned p) const {
+        return sorted.empty() ? 0 : sorted[std::min(sorted.size() - 1, sorted.size() * p / 100u)];
+    }
+
+    // {"min":..,"p50":..,"p90":..,"p99":..,"max":..,"mean":..}
+    std::string to_json() const {
+        auto     sorted = samples;
+        uint64_t sum    = 0;
+        std::sort(sorted.begin(), sorted.end());
+        for (auto v : sorted) sum += v;
+        char buf[160]{};
+        std::snprintf(buf,
+                      sizeof(buf),
+                      "{\"min\": %u, \"p50\": %u, \"p90\": %u, \"p99\": %u, \"max\": %u, \"mean\": %llu}",
+                      sorted.empty() ? 0 : sorted.front(),
+                      percentile(sorted, 50),
+                      percentile(sorted, 90),
+                      percentile(sorted, 99),
+                      sorted.empty() ? 0 : sorted.back(),
+                      static_cast<unsigned long long>(sorted.empty() ? 0 : sum / sorted.size()));
+        return buf;
+    }
+};
+
+template <typename AlgorithmType>
+void benchmark_algorithm(const char* name, EngineTFLite* engine, CameraPosix* camera, int iterations, bool& first) {
+    if (!AlgorithmType::is_model_valid(engine)) return;
+
+    Stats       preprocess, run, postprocess, total, results, allocs;
+    std::size_t heap_peak = 0;
+    int         errors    = 0;
+
+    AlgorithmType algorithm{engine};
+
+    for (int i = 0; i < iterations; ++i) {
+        el_img_t img{};
+        if (camera->start_stream() != EL_OK || camera->get_frame(&img) != EL_OK) [[unlikely]] {
+            ++errors;
+            continue;
+        }
+
+        el_heap_frame_stats_t frame{};
+        el_heap_frame_begin();
+        uint64_t start = el_get_time_us();
+        auto     ret   = algorithm.run(&img);
+        uint64_t end   = el_get_time_us();
+        el_heap_frame_end();
+        el_heap_get_frame_stats(&frame);
+        camera->stop_stream();
+
+        if (ret != EL_OK) [[unlikely]] {
+            ++errors;
+            continue;
+        }
+        allocs.add(frame.alloc_count);
+        heap_peak = std::max(heap_peak, frame.peak_bytes);
+        preprocess.add(algorithm.get_preprocess_time_us());
+        run.add(algorithm.get_run_time_us());
+        postprocess.add(algorithm.get_postprocess_time_us());
+        total.add(static_cast<uint32_t>(end - start));
+        const auto& r = algorithm.get_results();
+        results.add(static_cast<uint32_t>(std::distance(r.begin(), r.end())));
+    }
+
+    std::printf("%s\n    {\"algorithm\": \"%s\", \"iterations\": %d, \"errors\": %d, \"time_us\": {\"preprocess\": %s, "
+                "\"run\": %s, \"postprocess\": %s, \"total\": %s}, \"results\": %s, \"allocs_per_frame\": %s, "
+                "\"frame_heap_peak\": %zu, \"arena_used\": %zu}",
+                first ? "" : ",",
+                name,
+                iterations,
+                errors,
+                preprocess.to_json().c_str(),
+                run.to_json().c_str(),
+                postprocess.to_json().c_str(),
+                total.to_json().c_str(),
+                results.to_json().c_str(),
+                allocs.to_json().c_str(),
+                heap_peak,
+                engine->get_arena_used_bytes());
+    first = false;
+}
+
+void benchmark_convert(const el_img_t* frame, int iterations) {
+    static const el_pixel_format_t formats[] = {
+      EL_PIXEL_FORMAT_RGB888, EL_PIXEL_FORMAT_RGB565, EL_PIXEL_FORMAT_GRAYSCALE};
+    static const el_pixel_rotate_t rotates[] = {
+      EL_PIXEL_ROTATE_0, EL_PIXEL_ROTATE_90, EL_PIXEL_ROTATE_180, EL_PIXEL_ROTATE_270};
+    static const unsigned scales[] = {1, 2, 4};  // dst is 1/n of src on each side
+
+    bool first = true;
+    for (auto src_format : formats) {
+        // the frame is converted to the source format once, at the frame resolution
+        std::vector<uint8_t> src_data(frame->width * frame->height * bytes_per_pixel(src_format));
+        el_img_t             src{.data   = src_data.data(),
+                                 .size   = src_data.size(),
+                                 .width  = frame->width,
+                                 .height = frame->height,
+                                 .format = src_format,
+                                 .rotate = EL_PIXEL_ROTATE_0};
+        if (el_img_convert(frame, &src) != EL_OK) [[unlikely]]
+            continue;
+
+        for (auto dst_format : formats) {
+            for (auto rotate : rotates) {
+                for (auto scale : scales) {
+                    uint16_t width  = frame->width / scale;
+                    uint16_t height = frame->height / scale;
+                    if (rotate == EL_PIXEL_ROTATE_90 || rotate == EL_PIXEL_ROTATE_270) std::swap(width, height);
+
+                    std::vector<uint8_t> dst_data(width * height * bytes_per_pixel(dst_format));
+                    el_img_t             dst{.data   = dst_data.data(),
+                                             .size   = dst_data.size(),
+                                             .width  = width,
+                                             .height = height,
+                                             .format = dst_format,
+                                             .rotate = rotate};
+                    src.rotate = rotate;
+
+                    Stats time;
+                    for (int i = 0; i < iterations; ++i) {
+                        uint64_t start = el_get_time_us();
+                        el_img_convert(&src, &dst);
+                        time.add(static_cast<uint32_t>(el_get_time_us() - start));
+                    }
+                    std::printf("%s\n    {\"src\": \"%s\", \"dst\": \"%s\", \"rotate\": %d, \"src_size\": [%u, %u], "
+                                "\"dst_size\": [%u, %u], \"time_us\": %s}",
+                                first ? "" : ",",
+                                format_name(src_format),
+                                format_name(dst_format),
+                                static_cast<int>(rotate) * 90,
+                                src.width,
+                                src.height,
+                                dst.width,
+                                dst.height,
+                                time.to_json().c_str());
+                    first = false;
+                }
+            }
+        }
+    }
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    if (argc < 3) {
+        std::fprintf(stderr, "usage: %s <model.tflite> <frames> [iterations=100] [arena_kb=2048]\n", argv[0]);
+        return 1;
+    }
+
+    int         iterations = argc > 3 ? std::atoi(argv[3]) : 100;
+    std::size_t arena_size = (argc > 4 ? std::strtoul(argv[4], nullptr, 10) : 2048) << 10;
+
+    std::ifstream        file(argv[1], std::ios::binary);
+    std::vector<uint8_t> model{std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+    if (model.empty()) {
+        std::fprintf(stderr, "failed to read %s\n", argv[1]);
+        return 1;
+    }
+
+    setenv("SSCMA_CAMERA", argv[2], 1);
+    static CameraPosix camera{};
+    if (camera.init(0) != EL_OK) {
+        std::fprintf(stderr, "failed to open frames %s\n", argv[2]);
+        return 1;
+    }
+
+    static EngineTFLite engine{};
+    if (engine.init(arena_size) != EL_OK || engine.load_model(model.data(), model.size()) != EL_OK) {
+        std::fprintf(stderr, "failed to load %s with %zu bytes of arena\n", argv[1], arena_size);
+        return 1;
+    }
+
+    std::printf("{\n  \"model\": \"%s\",\n  \"model_size\": %zu,\n  \"arena_size\": %zu,\n  \"arena_used\": %zu,\n"
+                "  \"algorithms\": [",
+                argv[1],
+                model.size(),
+                arena_size,
+                engine.get_arena_used_bytes());
+
+    bool first = true;
+    benchmark_algorithm<AlgorithmYOLO>("yolo", &engine, &camera, iterations, first);
+    benchmark_algorithm<AlgorithmFOMO>("fomo", &engine, &camera, iterations, first);
+    benchmark_algorithm<AlgorithmIMCLS>("imcls", &engine, &camera, iterations, first);
+    benchmark_algorithm<AlgorithmPFLD>("pfld", &engine, &camera, iterations, first);
+    benchmark_algorithm<AlgorithmYOLOPOSE>("yolo_pose", &engine, &camera, iterations, first);
+    benchmark_algorithm<AlgorithmYOLOV8>("yolov8", &engine, &camera, iterations, first);
+    benchmark_algorithm<AlgorithmNvidiaDet>("nvidia_det", &engine, &camera, iterations, first);
+
+    std::printf("\n  ],\n  \"convert\": [");
+    el_img_t frame{};
+    if (camera.start_stream() == EL_OK && camera.get_frame(&frame) == EL_OK) {
+        benchmark_convert(&frame, iterations);
+        camera.stop_stream();
+    }
+    std::printf("\n  ]\n}\n");
+
+    return 0;
+}
@@ -0,0 +1,260 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2023 Seeed Technology Co.,Ltd
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#include "el_camera_posix.h"
+
+#include <dirent.h>
+#include <sys/stat.h>
+
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+
+#include "core/el_debug.h"
+#include "el_config_porting.h"
+
+namespace edgelab {
+
+namespace porting {
+
+static inline bool _read_ppm_token(std::FILE* file, unsigned long& value) {
+    int c = std::fgetc(file);
+    // skip whitespaces and comments
+    while (c != EOF && (std::isspace(c) || c == '#')) {
+        if (c == '#')
+            while (c != EOF && c != '\n') c = std::fgetc(file);
+        c = std::fgetc(file);
+    }
+    if (c == EOF || !std::isdigit(c)) [[unlikely]]
+        return false;
+    for (value = 0; c != EOF && std::isdigit(c); c = std::fgetc(file)) value = value * 10 + (c - '0');
+    return true;
+}
+
+// raw frames have no header, the format is taken from the extension and the resolution from the name, e.g.
+// "frame_0001_240x240.rgb565"
+static inline bool _parse_raw_name(const std::string& path, el_pixel_format_t& format, unsigned long& width,
+                                   unsigned long& height) {
+    auto dot = path.rfind('.');
+    if (dot == std::string::npos) [[unlikely]]
+        return false;
+    auto ext = path.substr(dot + 1);
+    if (ext == "rgb888")
+        format = EL_PIXEL_FORMAT_RGB888;
+    else if (ext == "rgb565")
+        format = EL_PIXEL_FORMAT_RGB565;
+    else if (ext == "gray")
+        format = EL_PIXEL_FORMAT_GRAYSCALE;
+    else
+        return false;
+
+    auto sep = path.rfind('_', dot);
+    if (sep == std::string::npos) [[unlikely]]
+        return false;
+    return std::sscanf(path.c_str() + sep + 1, "%lux%lu.", &width, &height) == 2;
+}
+
+static inline bool _is_frame_name(const std::string& name) {
+    el_pixel_format_t format{};
+    unsigned long     width  = 0;
+    unsigned long     height = 0;
+    return (name.size() > 4 && name.compare(name.size() - 4, 4, ".ppm") == 0) ||
+           _parse_raw_name(name, format, width, height);
+}
+
+}  // namespace porting
+
+CameraPosix::CameraPosix() : Camera(0b00000111), _paths(), _index(0), _frame(), _img() {}
+
+el_err_code_t CameraPosix::init(SensorOptIdType opt_id) {
+    if (!((1 << opt_id) & 0b00000111)) [[unlikely]]
+        return EL_EINVAL;
+
+    const char* path = std::getenv("SSCMA_CAMERA");
+    if (!path || !*path) path = CONFIG_EL_POSIX_CAMERA_PATH;
+
+    _paths.clear();
+    _index = 0;
+
+    struct stat st {};
+    if (stat(path, &st) != 0) [[unlikely]] {
+        EL_LOGW("[Camera] %s not found", path);
+        return EL_EIO;
+    }
+    if (S_ISDIR(st.st_mode)) {
+        DIR* dir = opendir(path);
+        if (!dir) [[unlikely]]
+            return EL_EIO;
+        for (auto* ent = readdir(dir); ent; ent = readdir(dir)) {
+            std::string name{ent->d_name};
+            if (porting::_is_frame_name(name))
+                _paths.emplace_back(std::string(path) + "/" + name);
+        }
+        closedir(dir);
+        std::sort(_paths.begin(), _paths.end());
+    } else
+        _paths.emplace_back(path);
+
+    if (_paths.empty()) [[unlikely]] {
+        EL_LOGW("[Camera] no frames in %s", path);
+        return EL_EIO;
+    }
+
+    this->_current_opt_id = opt_id;
+    this->_is_present     = true;
+
+    return EL_OK;
+}
+
+el_err_code_t CameraPosix::deinit() {
+    _paths.clear();
+    _frame.clear();
+    _frame.shrink_to_fit();
+    this->_is_present = false;
+    return EL_OK;
+}
+
+el_err_code_t CameraPosix::start_stream() {
+    if (!this->_is_present) [[unlikely]]
+        return EL_EIO;
+
+    auto ret = load_frame(_paths[_index]);
+    _index   = (_index + 1) % _paths.size();
+    if (ret != EL_OK) [[unlikely]] {
+        EL_ELOG("[Camera] capture failed");
+        return ret;
+    }
+
+    this->_is_streaming = true;
+    return EL_OK;
+}
+
+el_err_code_t CameraPosix::stop_stream() {
+    if (this->_is_streaming) [[likely]] {
+        this->_is_streaming = false;
+        return EL_OK;
+    }
+    return EL_ELOG;
+}
+
+el_err_code_t CameraPosix::get_frame(el_img_t* img) {
+    if (!this->_is_streaming) [[unlikely]]
+        return EL_EIO;
+    *img = _img;
+    return EL_OK;
+}
+
+el_err_code_t CameraPosix::get_processed_frame(el_img_t*) { return EL_ENOTSUP; }
+
+el_err_code_t CameraPosix::load_frame(const std::string& path) {
+    el_pixel_format_t format = EL_PIXEL_FORMAT_UNKNOWN;
+    unsigned long     width  = 0;
+    unsigned long     height = 0;
+    if (porting::_parse_raw_name(path, format, width, height)) return load_raw_frame(path, format, width, height);
+    return load_ppm_frame(path);
+}
+
+el_err_code_t CameraPosix::load_raw_frame(const std::string& path,
+                                          el_pixel_format_t  format,
+                                          unsigned long      width,
+                                          unsigned long      height) {
+    if (!width || !height || width > UINT16_MAX || height > UINT16_MAX) [[unlikely]]
+        return EL_EINVAL;
+
+    std::FILE* file = std::fopen(path.c_str(), "rb");
+    if (!file) [[unlikely]]
+        return EL_EIO;
+
+    std::size_t bytes_per_pixel = format == EL_PIXEL_FORMAT_RGB888 ? 3 : format == EL_PIXEL_FORMAT_RGB565 ? 2 : 1;
+    std::size_t size            = width * height * bytes_per_pixel;
+    _frame.resize(size);
+    bool is_read = std::fread(_frame.data(), 1, size, file) == size;
+    std::fclose(file);
+    if (!is_read) [[unlikely]]
+        return EL_EIO;
+
+    _img = el_img_t{.data   = _frame.data(),
+                    .size   = size,
+                    .width  = static_cast<uint16_t>(width),
+                    .height = static_cast<uint16_t>(height),
+                    .format = format,
+                    .rotate = EL_PIXEL_ROTATE_0};
+    return EL_OK;
+}
+
+el_err_code_t CameraPosix::load_ppm_frame(const std::string& path) {
+    std::FILE* file = std::fopen(path.c_str(), "rb");
+    if (!file) [[unlikely]]
+        return EL_EIO;
+
+    el_err_code_t     ret    = EL_OK;
+    unsigned long     width  = 0;
+    unsigned long     height = 0;
+    unsigned long     maxval = 0;
+    el_pixel_format_t format = EL_PIXEL_FORMAT_UNKNOWN;
+    std::size_t       size   = 0;
+    char              magic[2]{};
+
+    if (std::fread(magic, 1, sizeof(magic), file) != sizeof(magic) || magic[0] != 'P') [[unlikely]] {
+        ret = EL_EINVAL;
+        goto CameraPosixLoadFrameExit;
+    }
+    if (magic[1] == '6')
+        format = EL_PIXEL_FORMAT_RGB888;
+    else if (magic[1] == '5')
+        format = EL_PIXEL_FORMAT_GRAYSCALE;
+    else [[unlikely]] {
+        ret = EL_ENOTSUP;
+        goto CameraPosixLoadFrameExit;
+    }
+    // the single whitespace after maxval is consumed by the token reader
+    if (!porting::_read_ppm_token(file, width) || !porting::_read_ppm_token(file, height) ||
+        !porting::_read_ppm_token(file, maxval) || maxval != 255 || !width || !height || width > UINT16_MAX ||
+        height > UINT16_MAX) [[unlikely]] {
+        ret = EL_EINVAL;
+        goto CameraPosixLoadFrameExit;
+    }
+
+    size = width * height * (format == EL_PIXEL_FORMAT_RGB888 ? 3 : 1);
+    _frame.resize(size);
+    if (std::fread(_frame.data(), 1, size, file) != size) [[unlikely]] {
+        ret = EL_EIO;
+        goto CameraPosixLoadFrameExit;
+    }
+
+    _img = el_img_t{.data   = _frame.data(),
+                    .size   = size,
+                    .width  = static_cast<uint16_t>(width),
+                    .height = static_cast<uint16_t>(height),
+                    .format = format,
+                    .rotate = EL_PIXEL_ROTATE_0};
+
+CameraPosixLoadFrameExit:
+    std::fclose(file);
+    return ret;
+}
+
+}  // namespace edgelab
@@ -0,0 +1,73 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2023 Seeed Technology Co.,Ltd
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#ifndef _EL_CAMERA_POSIX_H_
+#define _EL_CAMERA_POSIX_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "core/el_types.h"
+#include "porting/el_camera.h"
+
+namespace edgelab {
+
+// camera replays PPM (P6 RGB888 / P5 grayscale) or raw (.rgb888 / .rgb565 / .gray, the resolution is in the name as
+// "<name>_<width>x<height>.<ext>") frames from a file or a directory, frames of a directory are played in name order
+// and looped, the resolution of the frames is kept as is regardless of the selected option, JPEG frames are not
+// supported as there is no decoder in the tree
+class CameraPosix final : public Camera {
+   public:
+    CameraPosix();
+    ~CameraPosix() = default;
+
+    el_err_code_t init(SensorOptIdType opt_id) override;
+    el_err_code_t deinit() override;
+
+    el_err_code_t start_stream() override;
+    el_err_code_t stop_stream() override;
+
+    el_err_code_t get_frame(el_img_t* img) override;
+    el_err_code_t get_processed_frame(el_img_t* img) override;
+
+   protected:
+    el_err_code_t load_frame(const std::string& path);
+    el_err_code_t load_raw_frame(const std::string& path,
+                                 el_pixel_format_t  format,
+                                 unsigned long      width,
+                                 unsigned long      height);
+    el_err_code_t load_ppm_frame(const std::string& path);
+
+   private:
+    std::vector<std::string> _paths;
+    std::size_t              _index;
+    std::vector<uint8_t>     _frame;
+    el_img_t                 _img;
+};
+
+}  // namespace edgelab
+
+#endif
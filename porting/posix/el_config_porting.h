@@ -0,0 +1,119 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2023 Seeed Technology Co.,Ltd
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#ifndef _EL_CONFIG_PORTING_H_
+#define _EL_CONFIG_PORTING_H_
+
+#define PRODUCT_NAME_PREFIX            "posix"
+#define PRODUCT_NAME_SUFFIX            "host"
+#define PORT_DEVICE_NAME               "POSIX Host"
+
+// runtime paths and ports, could be overridden by the environment variables in the comments
+#define CONFIG_EL_POSIX_SERIAL_PATH    ""            // SSCMA_SERIAL, a pty or a fifo, empty for stdin/stdout
+#define CONFIG_EL_POSIX_TCP_PORT       0             // SSCMA_TCP_PORT, 0 to disable the TCP transport
+#define CONFIG_EL_POSIX_CAMERA_PATH    "frames"      // SSCMA_CAMERA, a frame file or a directory of frame files
+#define CONFIG_EL_POSIX_MODELS_PATH    "models.bin"  // SSCMA_MODELS, a models image as it is in the flash
+
+#define SSCMA_HAS_NATIVE_NETWORKING    0
+
+#define CONFIG_EL_DEBUG                3
+
+#define CONFIG_EL_PORTING_POSIX        1
+#define CONFIG_EL_HAS_FREERTOS_SUPPORT 0
+
+#define CONFIG_EL_TFLITE
+#define CONFIG_EL_TFLITE_OP_CONV_2D
+#define CONFIG_EL_TFLITE_OP_RESHAPE
+#define CONFIG_EL_TFLITE_OP_SHAPE
+#define CONFIG_EL_TFLITE_OP_PACK
+#define CONFIG_EL_TFLITE_OP_PAD
+#define CONFIG_EL_TFLITE_OP_PADV2
+#define CONFIG_EL_TFLITE_OP_SUB
+#define CONFIG_EL_TFLITE_OP_ADD
+#define CONFIG_EL_TFLITE_OP_RELU
+#define CONFIG_EL_TFLITE_OP_MAX_POOL_2D
+#define CONFIG_EL_TFLITE_OP_SPLIT
+#define CONFIG_EL_TFLITE_OP_CONCATENATION
+#define CONFIG_EL_TFLITE_OP_FULLY_CONNECTED
+#define CONFIG_EL_TFLITE_OP_RESIZE_NEAREST_NEIGHBOR
+#define CONFIG_EL_TFLITE_OP_QUANTIZE
+#define CONFIG_EL_TFLITE_OP_TRANSPOSE
+#define CONFIG_EL_TFLITE_OP_LOGISTIC
+#define CONFIG_EL_TFLITE_OP_MUL
+#define CONFIG_EL_TFLITE_OP_SPLIT_V
+#define CONFIG_EL_TFLITE_OP_STRIDED_SLICE
+#define CONFIG_EL_TFLITE_OP_MEAN
+#define CONFIG_EL_TFLITE_OP_SOFTMAX
+#define CONFIG_EL_TFLITE_OP_DEPTHWISE_CONV_2D
+#define CONFIG_EL_TFLITE_OP_LEAKY_RELU
+
+#define CONFIG_EL_MODEL                         1
+#define CONFIG_EL_MODEL_TFLITE_MAGIC            0x54464C33
+#define CONFIG_EL_MODEL_HEADER_MAGIC            0x004C4854
+#define CONFIG_EL_MODEL_PARTITION_NAME          "models"
+#define CONFIG_EL_MODEL_SEEK_STEP_BYTES         1024
+
+#define CONFIG_EL_HAS_ACCELERATED_JPEG_CODEC    0
+
+#define CONFIG_EL_LIB_FLASHDB                   1
+#define CONFIG_EL_LIB_JPEGENC                   1
+
+#define CONFIG_EL_STORAGE                       1
+#define CONFIG_EL_STORAGE_NAME                  "edgelab_db"
+#define CONFIG_EL_STORAGE_PATH                  "kvdb0"  // directory of the database files
+#define CONFIG_EL_STORAGE_PARTITION_NAME        "db"
+#define CONFIG_EL_STORAGE_PARTITION_MOUNT_POINT "nor_flash0"
+#define CONFIG_EL_STORAGE_PARTITION_FS_NAME_0   "kvdb0"
+#define CONFIG_EL_STORAGE_PARTITION_FS_SIZE_0   (192 * 1024)
+#define CONFIG_EL_STORAGE_KEY_SIZE_MAX          (64)
+
+#define CONFIG_EL_TSDB                          1
+#define CONFIG_EL_TSDB_NAME                     "edgelab_tsdb"
+#define CONFIG_EL_TSDB_PATH                     "tsdb0"  // directory of the database files
+#define CONFIG_EL_TSDB_PARTITION_SIZE           (64 * 1024)
+#define CONFIG_EL_TSDB_LOG_SIZE_MAX             (1024)
+
+#if CONFIG_EL_LIB_FLASHDB
+    #define FDB_USING_KVDB
+    #ifdef FDB_USING_KVDB
+        #define FDB_KV_AUTO_UPDATE
+    #endif
+
+    #define FDB_USING_TSDB
+    #define FDB_USING_TIMESTAMP_64BIT
+
+    // FlashDB stores the database in files instead of a FAL partition
+    #define FDB_USING_FILE_POSIX_MODE
+    #define FDB_WRITE_GRAN (1)
+    #define FDB_BLOCK_SIZE (8 * 1024)
+
+    #if CONFIG_EL_DEBUG == 0
+        #define FDB_PRINT(...)
+    #elif CONFIG_EL_DEBUG >= 1
+        #define FDB_DEBUG_ENABLE
+    #endif
+#endif
+
+#endif
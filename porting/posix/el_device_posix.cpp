@@ -0,0 +1,103 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2023 Seeed Technology Co.,Ltd
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#include "el_device_posix.h"
+
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstdint>
+#include <cstdlib>
+
+#include "el_camera_posix.h"
+#include "el_config_porting.h"
+#include "el_serial_posix.h"
+#include "porting/el_misc.h"
+
+namespace edgelab {
+
+namespace porting {
+
+static inline uint32_t _device_id_from_host() {
+    uint32_t id = static_cast<uint32_t>(gethostid());
+
+    // Fowler–Noll–Vo hash function
+    uint32_t hash  = 0x811c9dc5;
+    uint32_t prime = 0x1000193;
+    for (size_t i = 0; i < sizeof(id); ++i) {
+        uint8_t value = (id >> (i << 3)) & 0xff;
+        hash          = hash ^ value;
+        hash *= prime;
+    }
+
+    return hash;
+}
+
+static inline const char* _getenv_or(const char* name, const char* fallback) {
+    const char* value = std::getenv(name);
+    return value && *value ? value : fallback;
+}
+
+}  // namespace porting
+
+DevicePosix::DevicePosix() { init(); }
+
+void DevicePosix::init() {
+    this->_device_name = PORT_DEVICE_NAME;
+    this->_device_id   = porting::_device_id_from_host();
+    this->_revision_id = 0;
+
+    // FlashDB file mode keeps the database files in this directory
+    mkdir(CONFIG_EL_STORAGE_PATH, 0755);
+    #if CONFIG_EL_TSDB
+    mkdir(CONFIG_EL_TSDB_PATH, 0755);
+    #endif
+
+    static uint8_t sensor_id = 0;
+
+    static CameraPosix camera{};
+    this->_camera = &camera;
+    this->_registered_sensors.emplace_front(el_sensor_info_t{
+      .id = ++sensor_id, .type = el_sensor_type_t::EL_SENSOR_TYPE_CAM, .state = el_sensor_state_t::EL_SENSOR_STA_REG});
+
+    static SerialPosix serial{porting::_getenv_or("SSCMA_SERIAL", CONFIG_EL_POSIX_SERIAL_PATH)};
+    this->_transports.emplace_front(&serial);
+
+    auto port = std::strtoul(porting::_getenv_or("SSCMA_TCP_PORT", ""), nullptr, 10);
+    if (!port) port = CONFIG_EL_POSIX_TCP_PORT;
+    if (port && port <= UINT16_MAX) {
+        static SerialTcpPosix serial_tcp{static_cast<uint16_t>(port)};
+        this->_transports.emplace_front(&serial_tcp);
+    }
+}
+
+void DevicePosix::reset() { el_reset(); }
+
+Device* Device::get_device() {
+    static DevicePosix device{};
+    return &device;
+}
+
+}  // namespace edgelab
@@ -0,0 +1,88 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2023 Seeed Technology Co.,Ltd
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstdlib>
+
+#include "core/el_debug.h"
+#include "core/el_types.h"
+#include "el_config_porting.h"
+#include "porting/el_flash.h"
+
+namespace edgelab {
+
+namespace porting {
+
+static const uint8_t* _el_flash_mmap_addr = nullptr;
+static uint32_t       _el_flash_mmap_size = 0;
+
+// the models image is mapped read-only as the models partition, the handler is the file descriptor
+bool el_flash_mmap_init(uint32_t* flash_addr, uint32_t* size, const uint8_t** mmap, uint32_t* handler) {
+    const char* path = std::getenv("SSCMA_MODELS");
+    if (!path) path = CONFIG_EL_POSIX_MODELS_PATH;
+
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) [[unlikely]] {
+        EL_LOGW("[Flash] failed to open models image %s", path);
+        return false;
+    }
+
+    struct stat st {};
+    if (fstat(fd, &st) != 0 || st.st_size <= 0) [[unlikely]]
+        goto Err;
+
+    *mmap = static_cast<const uint8_t*>(::mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0));
+    if (*mmap == MAP_FAILED) [[unlikely]]
+        goto Err;
+
+    *flash_addr         = 0;
+    *size               = static_cast<uint32_t>(st.st_size);
+    *handler            = static_cast<uint32_t>(fd);
+    _el_flash_mmap_addr = *mmap;
+    _el_flash_mmap_size = *size;
+
+    return true;
+
+Err:
+    *mmap = nullptr;
+    close(fd);
+    return false;
+}
+
+void el_flash_mmap_deinit(uint32_t* handler) {
+    if (_el_flash_mmap_addr) [[likely]]
+        munmap(const_cast<uint8_t*>(_el_flash_mmap_addr), _el_flash_mmap_size);
+    close(static_cast<int>(*handler));
+    _el_flash_mmap_addr = nullptr;
+    _el_flash_mmap_size = 0;
+}
+
+}  // namespace porting
+
+}  // namespace edgelab
@@ -0,0 +1,74 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2023 Seeed Technology Co.,Ltd
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#include <time.h>
+#include <unistd.h>
+
+#include <cstdarg>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+
+#include "core/el_compiler.h"
+#include "core/utils/el_heap.h"
+#include "el_config_porting.h"
+#include "porting/el_misc.h"
+
+EL_ATTR_WEAK void el_sleep(uint32_t ms) { usleep(static_cast<useconds_t>(ms) * 1000u); }
+
+EL_ATTR_WEAK uint64_t el_get_time_ms(void) { return el_get_time_us() / 1000u; }
+
+EL_ATTR_WEAK uint64_t el_get_time_us(void) {
+    struct timespec ts {};
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<uint64_t>(ts.tv_sec) * 1000000u + static_cast<uint64_t>(ts.tv_nsec) / 1000u;
+}
+
+// logs are printed to stderr, so that stdout is left for the AT replies
+EL_ATTR_WEAK int el_printf(const char* fmt, ...) {
+    va_list args;
+    int     n;
+    va_start(args, fmt);
+    n = vfprintf(stderr, fmt, args);
+    va_end(args);
+    return n;
+}
+
+EL_ATTR_WEAK int el_putchar(char c) { return fputc(c, stderr); }
+
+EL_ATTR_WEAK void* el_malloc(size_t size) { return edgelab::el_heap_malloc(size); }
+
+EL_ATTR_WEAK void* el_aligned_malloc_once(size_t align, size_t size) {
+    void* p = nullptr;
+    return posix_memalign(&p, align, size) == 0 ? p : nullptr;
+}
+
+EL_ATTR_WEAK void* el_calloc(size_t nmemb, size_t size) { return edgelab::el_heap_calloc(nmemb, size); }
+
+EL_ATTR_WEAK void el_free(void* ptr) { edgelab::el_heap_free(ptr); }
+
+EL_ATTR_WEAK void el_reset(void) { exit(0); }
+
+EL_ATTR_WEAK void el_status_led(bool on) { (void)on; }
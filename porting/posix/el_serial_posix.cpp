@@ -0,0 +1,262 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2023 Seeed Technology Co.,Ltd
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#include "el_serial_posix.h"
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <signal.h>
+#include <sys/socket.h>
+#include <termios.h>
+#include <unistd.h>
+
+#include <cctype>
+
+#include "core/el_debug.h"
+#include "porting/el_misc.h"
+
+namespace edgelab {
+
+namespace porting {
+
+static inline bool _fd_readable(int fd, int timeout_ms = 0) {
+    if (fd < 0) [[unlikely]]
+        return false;
+    struct pollfd pfd {
+        .fd = fd, .events = POLLIN, .revents = 0
+    };
+    return poll(&pfd, 1, timeout_ms) > 0 && (pfd.revents & (POLLIN | POLLHUP | POLLERR));
+}
+
+}  // namespace porting
+
+SerialPosix::SerialPosix(const char* path, std::size_t rx_buffer_size)
+    : _path(path ? path : ""), _size(rx_buffer_size), _rx_fd(-1), _tx_fd(-1), _send_lock(), _rb_rx(nullptr) {
+    this->type = EL_TRANSPORT_UART;
+}
+
+SerialPosix::~SerialPosix() { deinit(); }
+
+el_err_code_t SerialPosix::init() {
+    if (this->_is_present) [[unlikely]]
+        return EL_OK;
+
+    if (_path.empty()) {
+        _rx_fd = STDIN_FILENO;
+        _tx_fd = STDOUT_FILENO;
+    } else {
+        _rx_fd = open(_path.c_str(), O_RDWR | O_NOCTTY);
+        if (_rx_fd < 0) [[unlikely]] {
+            EL_LOGW("[Serial] failed to open %s", _path.c_str());
+            return EL_EIO;
+        }
+        // raw mode if it is a terminal (pty)
+        struct termios tio {};
+        if (tcgetattr(_rx_fd, &tio) == 0) {
+            cfmakeraw(&tio);
+            tcsetattr(_rx_fd, TCSANOW, &tio);
+        }
+        _tx_fd = _rx_fd;
+    }
+
+    if (!this->_rb_rx) [[likely]]
+        this->_rb_rx = new lwRingBuffer{_size};
+
+    EL_ASSERT(this->_rb_rx);
+
+    this->_is_present = true;
+
+    return EL_OK;
+}
+
+el_err_code_t SerialPosix::deinit() {
+    if (!_path.empty() && _rx_fd >= 0) close(_rx_fd);
+    _rx_fd = -1;
+    _tx_fd = -1;
+
+    delete this->_rb_rx;
+    this->_rb_rx = nullptr;
+
+    this->_is_present = false;
+
+    return EL_OK;
+}
+
+void SerialPosix::poll_rx() {
+    char rbuf[256]{};
+    while (this->_rb_rx->free() && porting::_fd_readable(_rx_fd)) {
+        ssize_t rlen = read(_rx_fd, rbuf, std::min(sizeof(rbuf), this->_rb_rx->free()));
+        if (rlen <= 0) [[unlikely]] {
+            // input is closed (e.g. piped commands), replies are still sent to the output
+            if (_rx_fd != _tx_fd) _rx_fd = -1;
+            break;
+        }
+        this->_rb_rx->put(rbuf, rlen);
+    }
+}
+
+char SerialPosix::echo(bool only_visible) {
+    if (!this->_is_present) return '\0';
+
+    char c{get_char()};
+    if (only_visible && !std::isprint(c)) return c;
+    send_bytes(&c, sizeof(c));
+    return c;
+}
+
+char SerialPosix::get_char() {
+    if (!this->_is_present) return '\0';
+
+    while (this->_rb_rx->isEmpty()) {
+        poll_rx();
+        if (this->_rb_rx->isEmpty()) el_sleep(1);
+    }
+    return this->_rb_rx->get();
+}
+
+std::size_t SerialPosix::get_line(char* buffer, size_t size, const char delim) {
+    if (!this->_is_present) return 0;
+
+    poll_rx();
+
+    return this->_rb_rx->extract(delim, buffer, size);
+}
+
+std::size_t SerialPosix::read_bytes(char* buffer, size_t size) {
+    if (!this->_is_present) return 0;
+
+    size_t read{0};
+    while (read < size) {
+        poll_rx();
+        read += this->_rb_rx->get(buffer + read, size - read);
+        if (read < size) el_sleep(1);
+    }
+
+    return read;
+}
+
+std::size_t SerialPosix::send_bytes(const char* buffer, size_t size) {
+    if (!this->_is_present) return 0;
+
+    const Guard<Mutex> guard(_send_lock);
+
+    size_t sent{0};
+    while (sent < size && _tx_fd >= 0) {
+        ssize_t n = write(_tx_fd, buffer + sent, size - sent);
+        if (n <= 0) [[unlikely]]
+            break;
+        sent += n;
+    }
+
+    return sent;
+}
+
+SerialTcpPosix::SerialTcpPosix(uint16_t port, std::size_t rx_buffer_size)
+    : SerialPosix("", rx_buffer_size), _port(port), _server_fd(-1) {}
+
+SerialTcpPosix::~SerialTcpPosix() { deinit(); }
+
+el_err_code_t SerialTcpPosix::init() {
+    if (this->_is_present) [[unlikely]]
+        return EL_OK;
+
+    // writing to a closed connection should not terminate the process
+    signal(SIGPIPE, SIG_IGN);
+
+    _server_fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (_server_fd < 0) [[unlikely]]
+        return EL_EIO;
+
+    int opt = 1;
+    setsockopt(_server_fd, SOL_SOCKET, SO_REUSEADDR, &opt, sizeof(opt));
+
+    struct sockaddr_in addr {};
+    addr.sin_family      = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_ANY);
+    addr.sin_port        = htons(_port);
+    if (bind(_server_fd, reinterpret_cast<struct sockaddr*>(&addr), sizeof(addr)) != 0 ||
+        listen(_server_fd, 1) != 0) [[unlikely]] {
+        EL_LOGW("[Serial] failed to listen on TCP port %u", _port);
+        close(_server_fd);
+        _server_fd = -1;
+        return EL_EIO;
+    }
+
+    if (!this->_rb_rx) [[likely]]
+        this->_rb_rx = new lwRingBuffer{_size};
+
+    EL_ASSERT(this->_rb_rx);
+
+    this->_is_present = true;
+
+    return EL_OK;
+}
+
+el_err_code_t SerialTcpPosix::deinit() {
+    close_client();
+    if (_server_fd >= 0) close(_server_fd);
+    _server_fd = -1;
+
+    delete this->_rb_rx;
+    this->_rb_rx = nullptr;
+
+    this->_is_present = false;
+
+    return EL_OK;
+}
+
+void SerialTcpPosix::poll_rx() {
+    if (porting::_fd_readable(_server_fd)) {
+        int fd = accept(_server_fd, nullptr, nullptr);
+        if (fd >= 0) [[likely]] {
+            close_client();
+            const Guard<Mutex> guard(_send_lock);
+            _rx_fd = fd;
+            _tx_fd = fd;
+        }
+    }
+
+    char rbuf[256]{};
+    while (this->_rb_rx->free() && porting::_fd_readable(_rx_fd)) {
+        ssize_t rlen = read(_rx_fd, rbuf, std::min(sizeof(rbuf), this->_rb_rx->free()));
+        if (rlen <= 0) [[unlikely]] {
+            close_client();
+            break;
+        }
+        this->_rb_rx->put(rbuf, rlen);
+    }
+}
+
+void SerialTcpPosix::close_client() {
+    const Guard<Mutex> guard(_send_lock);
+    if (_rx_fd >= 0) close(_rx_fd);
+    _rx_fd = -1;
+    _tx_fd = -1;
+    if (this->_rb_rx) this->_rb_rx->clear();
+}
+
+}  // namespace edgelab
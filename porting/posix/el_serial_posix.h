@@ -0,0 +1,87 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2023 Seeed Technology Co.,Ltd
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#ifndef _EL_SERIAL_POSIX_H_
+#define _EL_SERIAL_POSIX_H_
+
+#include <cstdint>
+#include <string>
+
+#include "core/synchronize/el_guard.hpp"
+#include "core/synchronize/el_mutex.hpp"
+#include "porting/el_serial.h"
+
+namespace edgelab {
+
+// serial over file descriptors, a pty or a fifo if the path is specified, otherwise stdin/stdout
+class SerialPosix : public Serial {
+   public:
+    explicit SerialPosix(const char* path = "", std::size_t rx_buffer_size = 8192);
+    ~SerialPosix() override;
+
+    el_err_code_t init() override;
+    el_err_code_t deinit() override;
+
+    char        echo(bool only_visible = true) override;
+    char        get_char() override;
+    std::size_t get_line(char* buffer, size_t size, const char delim = 0x0d) override;
+
+    std::size_t read_bytes(char* buffer, size_t size) override;
+    std::size_t send_bytes(const char* buffer, size_t size) override;
+
+   protected:
+    // moves the pending input to the rx ring buffer without blocking
+    virtual void poll_rx();
+
+    std::string   _path;
+    std::size_t   _size;
+    int           _rx_fd;
+    int           _tx_fd;
+    Mutex         _send_lock;
+    lwRingBuffer* _rb_rx;
+};
+
+// serial over a TCP connection, one client is served at a time and a new client replaces the old one
+class SerialTcpPosix final : public SerialPosix {
+   public:
+    explicit SerialTcpPosix(uint16_t port, std::size_t rx_buffer_size = 8192);
+    ~SerialTcpPosix() override;
+
+    el_err_code_t init() override;
+    el_err_code_t deinit() override;
+
+   protected:
+    void poll_rx() override;
+
+   private:
+    void close_client();
+
+    uint16_t _port;
+    int      _server_fd;
+};
+
+}  // namespace edgelab
+
+#endif
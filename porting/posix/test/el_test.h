@@ -0,0 +1,47 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2023 Seeed Technology Co.,Ltd
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#ifndef _EL_TEST_H_
+#define _EL_TEST_H_
+
+#include <cstdio>
+
+// checks of the host tests, unlike assert they are kept in release builds, a test returns the number of failed checks
+namespace edgelab::test {
+
+inline int failures = 0;
+
+inline void check(bool cond, const char* expr, const char* file, int line) {
+    if (cond) [[likely]]
+        return;
+    std::fprintf(stderr, "%s:%d: check failed: %s\n", file, line, expr);
+    ++failures;
+}
+
+}  // namespace edgelab::test
+
+#define EL_TEST_CHECK(expr) edgelab::test::check(static_cast<bool>(expr), #expr, __FILE__, __LINE__)
+
+#endif
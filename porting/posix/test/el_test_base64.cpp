@@ -0,0 +1,105 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2023 Seeed Technology Co.,Ltd
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+// base64 encoders, the RFC 4648 vectors and inputs of each length modulo 3 around the 24 bytes unrolled step, the
+// padded tail of 1 and 2 bytes is checked on both the buffer and the character output encoders
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "core/utils/el_base64.h"
+#include "el_test.h"
+
+using namespace edgelab;
+
+namespace {
+
+std::string output;
+
+int put_output(int c) {
+    output.push_back(static_cast<char>(c));
+    return c;
+}
+
+std::string encode(const std::string& in) {
+    std::string out(((in.size() + 2) / 3) * 4, '\0');
+    el_base64_encode(reinterpret_cast<const unsigned char*>(in.data()), static_cast<int>(in.size()), out.data());
+    return out;
+}
+
+std::string encode_output(const std::string& in) {
+    output.clear();
+    el_base64_encode_output(reinterpret_cast<const unsigned char*>(in.data()), static_cast<int>(in.size()), put_output);
+    return output;
+}
+
+// bit by bit reference
+std::string encode_reference(const std::string& in) {
+    static const char* table = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    std::string        out;
+    uint32_t           bits = 0;
+    int                n    = 0;
+    for (unsigned char c : in) {
+        bits = (bits << 8) | c;
+        n += 8;
+        while (n >= 6) {
+            n -= 6;
+            out.push_back(table[(bits >> n) & 0x3f]);
+        }
+    }
+    if (n) out.push_back(table[(bits << (6 - n)) & 0x3f]);
+    while (out.size() % 4) out.push_back('=');
+    return out;
+}
+
+}  // namespace
+
+int main() {
+    const char* vectors[][2] = {
+      {"", ""},
+      {"f", "Zg=="},
+      {"fo", "Zm8="},
+      {"foo", "Zm9v"},
+      {"foob", "Zm9vYg=="},
+      {"fooba", "Zm9vYmE="},
+      {"foobar", "Zm9vYmFy"},
+    };
+    for (const auto& v : vectors) {
+        EL_TEST_CHECK(encode(v[0]) == v[1]);
+        EL_TEST_CHECK(encode_output(v[0]) == v[1]);
+    }
+
+    // high bits in the tail, a tail taken from the wrong index encodes a different character
+    std::string in;
+    for (std::size_t size = 0; size <= 52; ++size) {
+        in.push_back(static_cast<char>(0xff - size * 37));
+        EL_TEST_CHECK(encode(in) == encode_reference(in));
+        EL_TEST_CHECK(encode_output(in) == encode_reference(in));
+    }
+
+    return edgelab::test::failures;
+}
@@ -0,0 +1,85 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2023 Seeed Technology Co.,Ltd
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+// replies of the batches, a batch released early (e.g. by a reply too large to be held) never ends the next batch
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "el_test.h"
+#include "sscma/interface/transport/batch.hpp"
+
+using namespace edgelab;
+
+namespace {
+
+class SinkTransport final : public Transport {
+   public:
+    SinkTransport() { _is_present = true; }
+
+    std::size_t read_bytes(char*, size_t) override { return 0; }
+    std::size_t send_bytes(const char* buffer, size_t size) override {
+        sent.append(buffer, size);
+        return size;
+    }
+    char        echo(bool) override { return 0; }
+    char        get_char() override { return 0; }
+    std::size_t get_line(char*, size_t, const char) override { return 0; }
+
+    std::string sent;
+};
+
+}  // namespace
+
+int main() {
+    SinkTransport           sink;
+    sscma::transport::Batch batch(&sink);
+
+    EL_TEST_CHECK(batch.get_due_ms() == UINT32_MAX);
+
+    uint32_t first = batch.begin();
+    EL_TEST_CHECK(batch.get_due_ms() > 0 && batch.get_due_ms() <= SSCMA_BATCH_REPLY_HOLD_MS + 1);
+    batch.send_bytes("a", 1);
+    EL_TEST_CHECK(sink.sent.empty());
+
+    // released before its end()
+    std::string large(SSCMA_BATCH_REPLY_SIZE_MAX + 1, 'x');
+    batch.send_bytes(large.data(), large.size());
+    EL_TEST_CHECK(sink.sent == "a" + large);
+    sink.sent.clear();
+
+    uint32_t second = batch.begin();
+    EL_TEST_CHECK(second != first);
+    batch.send_bytes("b", 1);
+    batch.end(first);  // late end() of the released batch
+    EL_TEST_CHECK(sink.sent.empty());
+    batch.send_bytes("c", 1);
+    batch.end(second);
+    EL_TEST_CHECK(sink.sent == "bc");
+    EL_TEST_CHECK(batch.get_due_ms() == UINT32_MAX);
+
+    return edgelab::test::failures;
+}
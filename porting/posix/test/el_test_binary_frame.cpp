@@ -0,0 +1,247 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2023 Seeed Technology Co.,Ltd
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+// round trip of the binary event frames, frames are written by BinaryFrameWriter and parsed by the host decoder
+
+#include <cstdint>
+#include <forward_list>
+#include <string>
+
+// a frame stuck in the transport is aborted without waiting the default 3 s
+#define SSCMA_FRAME_SEND_WAIT_MS 10U
+
+#include "el_test.h"
+#include "sscma/callback/extension/binary_frame.hpp"
+#include "sscma/protocol/host/binary_decoder.hpp"
+
+using namespace sscma::extension;
+
+namespace host = sscma::protocol::binary::host;
+
+namespace {
+
+std::string frame_bytes(const BinaryFrameWriter& writer, std::size_t n_views) {
+    std::string bytes;
+    for (std::size_t i = 0; i < n_views; ++i) bytes.append(writer.get_views()[i].data, writer.get_views()[i].size);
+    return bytes;
+}
+
+void test_results_round_trip() {
+    std::forward_list<el_box_t>   boxes{{1, 2, 3, 4, 50, 7}, {10, 20, 30, 40, 90, 300}};
+    std::forward_list<el_point_t> points{{5, 6, 70, 8}};
+    std::forward_list<el_class_t> classes{{99, 1000}};
+
+    std::forward_list<el_keypoint_t> keypoints{
+      el_keypoint_t{{5, 6, 7, 8, 9, 10}, {{1, 2, 3, 4}, {5, 6, 7, 8}}, 77, 3}
+    };
+
+    uint8_t jpeg[100];
+    for (std::size_t i = 0; i < sizeof(jpeg); ++i) jpeg[i] = static_cast<uint8_t>(i);
+    el_img_t img{jpeg, sizeof(jpeg), 640, 480, EL_PIXEL_FORMAT_JPEG, EL_PIXEL_ROTATE_0};
+
+    BinaryFrameWriter writer;
+    writer.begin(MSG_TYPE_EVENT);
+    writer.put_name("1@INVOKE");
+    writer.put_u8(0);
+    writer.put_u32(42);
+    writer.put_perf(1, 2, 3);
+    writer.put_results(boxes);
+    writer.put_results(points);
+    writer.put_results(classes);
+    writer.put_results(keypoints);
+    writer.put_resolution(&img);
+    writer.put_image(&img);
+    auto frame = frame_bytes(writer, writer.end());
+
+    // a frame between text and split at any offset is still decoded
+    std::string stream = "\r{\"type\": 0}\n" + frame + "junk\xa5" + frame;
+    for (std::size_t split = 0; split <= stream.size(); split += 17) {
+        host::Decoder decoder;
+        decoder.feed(reinterpret_cast<const uint8_t*>(stream.data()), split);
+        decoder.feed(reinterpret_cast<const uint8_t*>(stream.data()) + split, stream.size() - split);
+
+        int n = 0;
+        for (auto f = host::Frame{}; decoder.next(f); ++n) {
+            host::Event e;
+            EL_TEST_CHECK(host::parse_event(f, e));
+            EL_TEST_CHECK(e.name == "1@INVOKE" && e.code == 0 && e.count == 42);
+            EL_TEST_CHECK(e.has_perf && e.perf[0] == 1 && e.perf[1] == 2 && e.perf[2] == 3);
+            EL_TEST_CHECK(e.has_resolution && e.width == 640 && e.height == 480);
+            EL_TEST_CHECK(e.boxes.size() == 2 && e.boxes[1].x == 10 && e.boxes[1].h == 40);
+            EL_TEST_CHECK(e.boxes.size() == 2 && e.boxes[1].score == 90 && e.boxes[1].target == 300);
+            EL_TEST_CHECK(e.points.size() == 1 && e.points[0].score == 70 && e.points[0].target == 8);
+            EL_TEST_CHECK(e.classes.size() == 1 && e.classes[0].score == 99 && e.classes[0].target == 1000);
+            EL_TEST_CHECK(e.keypoints.size() == 1 && e.keypoints[0].box.target == 10);
+            EL_TEST_CHECK(e.keypoints.size() == 1 && e.keypoints[0].score == 77 && e.keypoints[0].target == 3);
+            EL_TEST_CHECK(e.keypoints.size() == 1 && e.keypoints[0].pts.size() == 2 &&
+                          e.keypoints[0].pts[1].target == 8);
+            EL_TEST_CHECK(e.image.size() == sizeof(jpeg) && e.image[99] == 99);
+        }
+        EL_TEST_CHECK(n == 2);
+        EL_TEST_CHECK(decoder.take_text() == "\r{\"type\": 0}\njunk\xa5");
+        EL_TEST_CHECK(decoder.dropped() == 0);
+    }
+
+    // a corrupted frame is dropped
+    frame[10] ^= 1;
+    host::Decoder decoder;
+    decoder.feed(reinterpret_cast<const uint8_t*>(frame.data()), frame.size());
+    auto f = host::Frame{};
+    EL_TEST_CHECK(!decoder.next(f));
+    EL_TEST_CHECK(decoder.dropped() == 1);
+}
+
+void test_delta_round_trip() {
+    std::forward_list<el_box_t> last{{10, 10, 5, 5, 80, 1}, {100, 100, 5, 5, 80, 1}, {200, 10, 5, 5, 80, 2}};
+    std::forward_list<el_box_t> next{{10, 10, 5, 5, 80, 1}, {120, 100, 5, 5, 80, 1}, {300, 300, 5, 5, 80, 3}};
+
+    ResultsFilter<el_box_t> filter;
+    filter.compare_and_update(last);
+
+    BinaryFrameWriter writer;
+    writer.begin(MSG_TYPE_EVENT);
+    writer.put_name("INVOKE");
+    writer.put_u8(0);
+    writer.put_u32(1);
+    writer.put_results(last);
+    writer.put_ids(filter);
+    auto keyframe = frame_bytes(writer, writer.end());
+
+    EL_TEST_CHECK(filter.compare_and_update(next));
+    writer.begin(MSG_TYPE_EVENT);
+    writer.put_name("INVOKE");
+    writer.put_u8(0);
+    writer.put_u32(2);
+    writer.put_delta(filter);
+    auto delta = frame_bytes(writer, writer.end());
+
+    host::Decoder decoder;
+    decoder.feed(reinterpret_cast<const uint8_t*>(keyframe.data()), keyframe.size());
+    decoder.feed(reinterpret_cast<const uint8_t*>(delta.data()), delta.size());
+
+    auto        f = host::Frame{};
+    host::Event e;
+    EL_TEST_CHECK(decoder.next(f) && host::parse_event(f, e));
+    EL_TEST_CHECK(!e.has_delta && e.boxes.size() == 3 && e.ids.size() == 3);
+    EL_TEST_CHECK(e.ids.size() == 3 && e.ids[0] == 1 && e.ids[1] == 2 && e.ids[2] == 3);
+
+    EL_TEST_CHECK(decoder.next(f) && host::parse_event(f, e));
+    EL_TEST_CHECK(e.has_delta && e.added == 1 && e.moved == 1);
+    EL_TEST_CHECK(e.boxes.size() == 2 && e.ids.size() == 2);
+    EL_TEST_CHECK(e.boxes.size() == 2 && e.boxes[0].x == 300 && e.boxes[1].x == 120);
+    EL_TEST_CHECK(e.ids.size() == 2 && e.ids[0] == 4 && e.ids[1] == 2);
+    EL_TEST_CHECK(e.removed.size() == 1 && e.removed[0] == 3);
+}
+
+// a keyframe reports the current positions, the kept results are compared with them instead of the older ones
+void test_keyframe_commit() {
+    std::forward_list<el_box_t> boxes{{10, 10, 5, 5, 80, 1}};
+
+    ResultsFilter<el_box_t> filter(boxes);
+    boxes.front().x = 14;
+    EL_TEST_CHECK(!filter.compare_and_update(boxes));
+    filter.commit();
+
+    boxes.front().x = 18;
+    EL_TEST_CHECK(!filter.compare_and_update(boxes));
+    boxes.front().x = 20;
+    EL_TEST_CHECK(filter.compare_and_update(boxes));
+    EL_TEST_CHECK(filter.get_changes().size() == 1 && filter.get_changes()[0].kind == RESULT_MOVED);
+    EL_TEST_CHECK(filter.get_changes().size() == 1 && filter.get_changes()[0].id == 1);
+}
+
+// a transport sending the views later (e.g. by DMA), it either truncates or holds them until they are aborted
+class LaterTransport final : public Transport {
+   public:
+    std::size_t read_bytes(char*, size_t) override { return 0; }
+    std::size_t send_bytes(const char*, size_t size) override { return size; }
+    std::size_t send_views(const el_buffer_view_t* views, size_t n, el_send_done_cb_t done, void* arg) override {
+        std::size_t size = 0;
+        for (std::size_t i = 0; i < n; ++i) size += views[i].size;
+        if (truncate && !hold) {
+            done(arg);
+            return size - 1;
+        }
+        _done = done;
+        _arg  = arg;
+        return truncate ? size - 1 : size;
+    }
+    void abort_views() override {
+        ++aborted;
+        if (_done) _done(_arg);
+        _done = nullptr;
+    }
+    char        echo(bool) override { return 0; }
+    char        get_char() override { return 0; }
+    std::size_t get_line(char*, size_t, const char) override { return 0; }
+
+    bool              truncate = false;
+    bool              hold     = false;  // the truncated views are held until aborted
+    int               aborted  = 0;
+    el_send_done_cb_t _done    = nullptr;
+    void*             _arg     = nullptr;
+};
+
+void test_lost_frames() {
+    LaterTransport    transport;
+    BinaryFrameWriter writer;
+
+    writer.begin(MSG_TYPE_EVENT);
+    writer.end();
+    EL_TEST_CHECK(writer.send(&transport));
+    EL_TEST_CHECK(!writer.take_lost());
+
+    // the frame is never sent, its buffers are released by aborting it before the next frame
+    writer.begin(MSG_TYPE_EVENT);
+    EL_TEST_CHECK(transport.aborted == 1);
+    EL_TEST_CHECK(writer.take_lost());
+    EL_TEST_CHECK(!writer.take_lost());
+    writer.end();
+
+    // a truncated frame is aborted at once, the next frame is never waiting on it
+    transport.truncate = true;
+    EL_TEST_CHECK(!writer.send(&transport));
+    EL_TEST_CHECK(transport.aborted == 2);
+    EL_TEST_CHECK(writer.take_lost());
+    writer.wait();
+    EL_TEST_CHECK(transport.aborted == 2);
+
+    transport.hold = true;
+    EL_TEST_CHECK(!writer.send(&transport));
+    EL_TEST_CHECK(transport.aborted == 3 && !transport._done);
+    writer.begin(MSG_TYPE_EVENT);
+    EL_TEST_CHECK(transport.aborted == 3);
+    EL_TEST_CHECK(writer.take_lost());
+}
+
+}  // namespace
+
+int main() {
+    test_results_round_trip();
+    test_delta_round_trip();
+    test_keyframe_commit();
+    test_lost_frames();
+    return edgelab::test::failures;
+}
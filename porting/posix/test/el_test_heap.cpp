@@ -0,0 +1,121 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2023 Seeed Technology Co.,Ltd
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+// heap accounting of the host build, the C++ allocations and the el_malloc family are counted by the same counters and
+// taken from the heap of the porting layer
+
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+
+#include "core/utils/el_heap.h"
+#include "el_test.h"
+#include "porting/el_misc.h"
+
+using namespace edgelab;
+
+namespace {
+
+// keeps the compiler from eliding the paired new and delete
+void* volatile _sink = nullptr;
+
+// blocks taken from the heap of the porting layer
+std::size_t _port_blocks = 0;
+
+void test_frame_counts() {
+    el_heap_set_budget(0);
+
+    el_heap_frame_begin();
+    auto* p = new uint32_t[16];
+    _sink   = p;
+    void* q = el_malloc(100);
+    auto* r = static_cast<uint8_t*>(el_calloc(10, 10));
+    EL_TEST_CHECK(p && q && r && r[0] == 0 && r[99] == 0);
+    delete[] p;
+    el_free(q);
+    el_free(r);
+    el_heap_frame_end();
+
+    el_heap_frame_stats_t frame{};
+    el_heap_get_frame_stats(&frame);
+    EL_TEST_CHECK(frame.frames == 1);
+    EL_TEST_CHECK(frame.alloc_count == 3);
+    EL_TEST_CHECK(frame.alloc_bytes == 16 * sizeof(uint32_t) + 100 + 100);
+    EL_TEST_CHECK(frame.peak_bytes == frame.alloc_bytes);
+}
+
+void test_live_bytes() {
+    el_heap_stats_t before{};
+    el_heap_stats_t during{};
+    el_heap_stats_t after{};
+
+    el_heap_get_stats(&before);
+    {
+        std::vector<uint8_t> v(1000);
+        void*                p = el_malloc(24);
+        _sink                  = v.data();
+        el_heap_get_stats(&during);
+        el_free(p);
+    }
+    el_heap_get_stats(&after);
+
+    EL_TEST_CHECK(during.live_bytes == before.live_bytes + 1000 + 24);
+    EL_TEST_CHECK(after.live_bytes == before.live_bytes);
+    EL_TEST_CHECK(after.alloc_count - before.alloc_count == after.free_count - before.free_count);
+    EL_TEST_CHECK(el_calloc(SIZE_MAX, 2) == nullptr);
+}
+
+void test_port_heap() {
+    std::size_t before = _port_blocks;
+    auto*       p      = new uint32_t[4];
+    _sink              = p;
+    void* q            = el_malloc(8);
+    EL_TEST_CHECK(_port_blocks == before + 2);
+    delete[] p;
+    el_free(q);
+    EL_TEST_CHECK(_port_blocks == before);
+}
+
+}  // namespace
+
+// overrides the weak heap of the porting layer
+void* edgelab::el_heap_port_malloc(size_t size) {
+    ++_port_blocks;
+    return std::malloc(size);
+}
+
+void edgelab::el_heap_port_free(void* ptr) {
+    if (ptr) --_port_blocks;
+    std::free(ptr);
+}
+
+int main() {
+#if CONFIG_EL_HEAP_ACCOUNTING
+    test_frame_counts();
+    test_live_bytes();
+    test_port_heap();
+#endif
+    return edgelab::test::failures;
+}
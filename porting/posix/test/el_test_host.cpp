@@ -0,0 +1,112 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2023 Seeed Technology Co.,Ltd
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+// smoke test of the host firmware, an AT command is sent to its stdin and the reply is expected on its stdout, the
+// host is run in a temporary directory so that it starts from an empty storage
+
+#include <fcntl.h>
+#include <poll.h>
+#include <signal.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <cstdlib>
+#include <string>
+
+#include "el_test.h"
+
+namespace {
+
+constexpr int kReplyTimeoutMs = 10000;
+
+// reads the output until the expected text is seen, the host is never expected to close its output
+bool wait_for(int fd, std::string& out, const char* expected) {
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(kReplyTimeoutMs);
+    while (out.find(expected) == std::string::npos) {
+        auto left = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now());
+        if (left.count() <= 0) [[unlikely]]
+            return false;
+        struct pollfd pfd {
+            .fd = fd, .events = POLLIN, .revents = 0
+        };
+        if (poll(&pfd, 1, static_cast<int>(left.count())) <= 0) continue;
+        char    buf[256];
+        ssize_t len = read(fd, buf, sizeof(buf));
+        if (len <= 0) [[unlikely]]
+            return false;
+        out.append(buf, len);
+    }
+    return true;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    if (argc < 2) [[unlikely]] {
+        std::fprintf(stderr, "usage: %s <sscma_host>\n", argv[0]);
+        return 1;
+    }
+
+    char dir[] = "/tmp/sscma_host_XXXXXX";
+    EL_TEST_CHECK(mkdtemp(dir) != nullptr);
+
+    int to_host[2], from_host[2];
+    EL_TEST_CHECK(pipe(to_host) == 0 && pipe(from_host) == 0);
+
+    pid_t pid = fork();
+    if (pid == 0) {
+        dup2(to_host[0], STDIN_FILENO);
+        dup2(from_host[1], STDOUT_FILENO);
+        close(to_host[1]);
+        close(from_host[0]);
+        if (chdir(dir) != 0) _exit(127);
+        unsetenv("SSCMA_SERIAL");
+        unsetenv("SSCMA_TCP_PORT");
+        execl(argv[1], argv[1], static_cast<char*>(nullptr));
+        _exit(127);
+    }
+    EL_TEST_CHECK(pid > 0);
+    close(to_host[0]);
+    close(from_host[1]);
+
+    // the command may be sent before the AT server is ready, it is read once the server polls the transport
+    const char cmd[] = "AT+NAME?\r";
+    EL_TEST_CHECK(write(to_host[1], cmd, sizeof(cmd) - 1) == static_cast<ssize_t>(sizeof(cmd) - 1));
+
+    std::string out;
+    EL_TEST_CHECK(wait_for(from_host[0], out, "\"name\": \"NAME?\", \"code\": 0, \"data\": \"POSIX Host\""));
+
+    kill(pid, SIGTERM);
+    waitpid(pid, nullptr, 0);
+    close(to_host[1]);
+    close(from_host[0]);
+
+    std::string rm = std::string("rm -rf ") + dir;
+    EL_TEST_CHECK(std::system(rm.c_str()) == 0);
+
+    if (edgelab::test::failures) std::fprintf(stderr, "host output:\n%s\n", out.c_str());
+    return edgelab::test::failures;
+}
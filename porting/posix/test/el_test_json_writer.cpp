@@ -0,0 +1,114 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2023 Seeed Technology Co.,Ltd
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+// replies of the JSON writer, streamed in chunks to a byte oriented transport and sent at once to a message oriented
+// one (MQTT), whose reply buffer is sized once for a base64 payload
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "core/utils/el_heap.h"
+#include "el_test.h"
+#include "sscma/json_writer.hpp"
+
+using namespace edgelab;
+using namespace sscma::utility;
+
+namespace {
+
+class SinkTransport final : public Transport {
+   public:
+    explicit SinkTransport(el_transport_type_t t) {
+        type        = t;
+        _is_present = true;
+    }
+
+    std::size_t read_bytes(char*, size_t) override { return 0; }
+    std::size_t send_bytes(const char* buffer, size_t size) override {
+        sent.append(buffer, size);
+        ++sends;
+        return size;
+    }
+    char        echo(bool) override { return 0; }
+    char        get_char() override { return 0; }
+    std::size_t get_line(char*, size_t, const char) override { return 0; }
+
+    std::string sent;
+    int         sends = 0;
+};
+
+void write_reply(JsonWriter& w, const std::vector<uint8_t>& image) {
+    w << "\r{\"type\": 1, \"name\": \"SAMPLE\", \"code\": " << 0 << ", \"data\": {\"image\": \"";
+    w.base64(image.data(), image.size());
+    w << "\"}}\n";
+}
+
+}  // namespace
+
+int main() {
+    std::vector<uint8_t> image(16 * 1024 + 1);
+    for (std::size_t i = 0; i < image.size(); ++i) image[i] = static_cast<uint8_t>(i * 31u);
+
+    std::string expected;
+    {
+        JsonWriter w(&expected);
+        write_reply(w, image);
+    }
+    EL_TEST_CHECK(expected.size() > ((image.size() + 2) / 3) * 4);
+
+    SinkTransport uart(EL_TRANSPORT_UART);
+    {
+        JsonWriter w(&uart);
+        write_reply(w, image);
+    }
+    EL_TEST_CHECK(uart.sent == expected);
+    EL_TEST_CHECK(uart.sends > 1);
+
+    SinkTransport mqtt(EL_TRANSPORT_MQTT);
+    {
+        JsonWriter w(&mqtt);
+        write_reply(w, image);
+    }
+    EL_TEST_CHECK(mqtt.sent == expected);
+    EL_TEST_CHECK(mqtt.sends == 1);
+
+#if CONFIG_EL_HEAP_ACCOUNTING
+    // the reply buffer is allocated once for the payload and the tail of the reply
+    el_heap_stats_t before{}, after{};
+    el_heap_get_stats(&before);
+    std::string str;
+    {
+        JsonWriter w(&str);
+        write_reply(w, image);
+    }
+    el_heap_get_stats(&after);
+    EL_TEST_CHECK(str == expected);
+    EL_TEST_CHECK(after.alloc_count - before.alloc_count == 1);
+#endif
+
+    return edgelab::test::failures;
+}
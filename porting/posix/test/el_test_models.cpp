@@ -0,0 +1,125 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2023 Seeed Technology Co.,Ltd
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+// the persisted model index is taken only if the models image tag is unchanged, an image written with a new tag makes
+// the index stale, an image without a tag is scanned every time
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+#include "core/data/el_data_models.h"
+#include "core/utils/el_hash.h"
+#include "el_test.h"
+
+using namespace edgelab;
+
+namespace {
+
+constexpr std::size_t image_size = 256u * 1024u;
+
+// packed model header without the extended header, fields are big-endian
+void put_model(std::vector<uint8_t>& image, std::size_t offset, uint8_t id, uint8_t type, uint32_t size) {
+    image[offset]     = (CONFIG_EL_MODEL_HEADER_MAGIC >> 16) & 0xff;
+    image[offset + 1] = (CONFIG_EL_MODEL_HEADER_MAGIC >> 8) & 0xff;
+    image[offset + 2] = CONFIG_EL_MODEL_HEADER_MAGIC & 0xff;
+    image[offset + 3] = static_cast<uint8_t>(id << 4 | type);
+    image[offset + 4] = (size >> 16) & 0xff;
+    image[offset + 5] = (size >> 8) & 0xff;
+    image[offset + 6] = size & 0xff;
+    image[offset + 7] = 0;
+    for (std::size_t i = 0; i < size; ++i) image[offset + sizeof(el_model_header_t) + i] = static_cast<uint8_t>(i);
+}
+
+// the tag at the end of the partition, fields are big-endian
+void put_tag(std::vector<uint8_t>& image, uint32_t generation) {
+    uint8_t tag[sizeof(el_models_image_tag_t)]{};
+    for (std::size_t i = 0; i < 4; ++i) {
+        tag[i]     = (CONFIG_EL_MODEL_IMAGE_TAG_MAGIC >> (24 - i * 8)) & 0xff;
+        tag[4 + i] = (generation >> (24 - i * 8)) & 0xff;
+    }
+    uint32_t crc = el_crc32(tag, 8);
+    for (std::size_t i = 0; i < 4; ++i) tag[8 + i] = (crc >> (24 - i * 8)) & 0xff;
+    std::copy(tag, tag + sizeof(tag), image.end() - sizeof(tag));
+}
+
+bool write_image(const std::string& path, const std::vector<uint8_t>& image) {
+    FILE* file = std::fopen(path.c_str(), "wb");
+    if (!file) return false;
+    bool ok = std::fwrite(image.data(), 1, image.size(), file) == image.size();
+    return std::fclose(file) == 0 && ok;
+}
+
+}  // namespace
+
+int main() {
+    char path[] = "/tmp/el_test_models_XXXXXX";
+    int  fd     = mkstemp(path);
+    EL_TEST_CHECK(fd >= 0);
+    if (fd < 0) return edgelab::test::failures;
+    close(fd);
+    setenv("SSCMA_MODELS", path, 1);
+
+    std::vector<uint8_t> image(image_size, 0xff);
+    put_model(image, 0u, 1u, EL_ALGO_TYPE_YOLO, 2048u);
+    put_tag(image, 1u);
+    EL_TEST_CHECK(write_image(path, image));
+
+    auto* models = Models::get_ptr();
+    EL_TEST_CHECK(models->init(EL_MODEL_FMT_PACKED_TFLITE) == EL_OK);
+    EL_TEST_CHECK(models->get_all_model_info_size() == 1u);
+    const auto index = models->get_index();
+    EL_TEST_CHECK(models->load_index(index, EL_MODEL_FMT_PACKED_TFLITE));
+    models->deinit();
+
+    // a small model written with a new image, anywhere in the partition
+    put_model(image, 70u * 1024u, 2u, EL_ALGO_TYPE_FOMO, 512u);
+    put_tag(image, 2u);
+    EL_TEST_CHECK(write_image(path, image));
+
+    EL_TEST_CHECK(models->init(index, EL_MODEL_FMT_PACKED_TFLITE) == EL_OK);
+    EL_TEST_CHECK(!models->load_index(index, EL_MODEL_FMT_PACKED_TFLITE));
+    EL_TEST_CHECK(models->has_model(1u));
+    EL_TEST_CHECK(models->has_model(2u));
+    EL_TEST_CHECK(models->get_all_model_info_size() == 2u);
+    EL_TEST_CHECK(models->load_index(models->get_index(), EL_MODEL_FMT_PACKED_TFLITE));
+    models->deinit();
+
+    // the index of an image without a tag is never taken
+    std::fill(image.end() - sizeof(el_models_image_tag_t), image.end(), 0xff);
+    EL_TEST_CHECK(write_image(path, image));
+
+    EL_TEST_CHECK(models->init(EL_MODEL_FMT_PACKED_TFLITE) == EL_OK);
+    EL_TEST_CHECK(models->get_all_model_info_size() == 2u);
+    EL_TEST_CHECK(!models->load_index(models->get_index(), EL_MODEL_FMT_PACKED_TFLITE));
+    models->deinit();
+
+    unlink(path);
+    return edgelab::test::failures;
+}
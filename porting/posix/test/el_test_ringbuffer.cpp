@@ -0,0 +1,72 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2023 Seeed Technology Co.,Ltd
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+// lines of the SPSC ring buffer, a line filling the whole buffer without its delimiter never stalls the buffer
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+#include "core/utils/el_ringbuffer.hpp"
+#include "el_test.h"
+
+using namespace edgelab;
+
+int main() {
+    lwRingBufferSPSC rb(64);
+    char             out[32]{};
+
+    EL_TEST_CHECK(rb.put("AT+ID?\r", 7) == 7);
+    EL_TEST_CHECK(rb.extract('\r', out, sizeof(out)) == 7);
+    EL_TEST_CHECK(std::memcmp(out, "AT+ID?\r", 7) == 0);
+
+    // a line too long for the buffer, the producer is blocked once it is full
+    std::string noise(rb.capacity(), 'x');
+    EL_TEST_CHECK(rb.put(noise.data(), noise.size()) == rb.capacity());
+    EL_TEST_CHECK(rb.isFull());
+    EL_TEST_CHECK(rb.extract('\r', out, sizeof(out)) == 0);
+    EL_TEST_CHECK(rb.isEmpty());
+
+    // the rest of the long line is dropped with it, the next line is taken
+    EL_TEST_CHECK(rb.put("xxxx\rAT+VER?\r", 13) == 13);
+    EL_TEST_CHECK(rb.extract('\r', out, sizeof(out)) == 0);
+    EL_TEST_CHECK(rb.extract('\r', out, sizeof(out)) == 8);
+    EL_TEST_CHECK(std::memcmp(out, "AT+VER?\r", 8) == 0);
+
+    // a line longer than the output is dropped as before
+    EL_TEST_CHECK(rb.put(noise.data(), sizeof(out) + 1) == sizeof(out) + 1);
+    EL_TEST_CHECK(rb.put("\rAT\r", 4) == 4);
+    EL_TEST_CHECK(rb.extract('\r', out, sizeof(out)) == 0);
+    EL_TEST_CHECK(rb.extract('\r', out, sizeof(out)) == 3);
+
+    // regions written by DMA are aligned to the cache lines
+    lwRingBufferSPSC aligned(100, 32);
+    std::size_t      free = 0;
+    EL_TEST_CHECK(aligned.capacity() == 128);
+    EL_TEST_CHECK(reinterpret_cast<std::uintptr_t>(aligned.reserve(&free)) % 32 == 0);
+    EL_TEST_CHECK(free == 128);
+
+    return edgelab::test::failures;
+}
@@ -15,15 +15,14 @@ void get_available_algorithms(const std::string& cmd, void* caller) {
     const auto& registered_algorithms = static_resource->algorithm_delegate->get_all_algorithm_info();
     const char* delim                 = "";
 
-    auto ss{
-      concat_strings("\r{\"type\": 0, \"name\": \"", cmd, "\", \"code\": ", std::to_string(EL_OK), ", \"data\": [")};
+    JsonWriter w(static_cast<Transport*>(caller));
+    w << "\r{\"type\": 0, \"name\": \"" << cmd << "\", \"code\": " << EL_OK << ", \"data\": [";
     for (const auto& i : registered_algorithms) {
-        ss += concat_strings(delim, algorithm_info_2_json_str(i));
+        w << delim;
+        algorithm_info_2_json(w, i);
         delim = ", ";
     }
-    ss += "]}\n";
-
-    static_cast<Transport*>(caller)->send_bytes(ss.c_str(), ss.size());
+    w << "]}\n";
 }
 
 void set_algorithm(const std::string&  cmd,
@@ -41,30 +40,21 @@ void set_algorithm(const std::string&  cmd,
             ret = static_resource->storage->emplace(el_make_storage_kv_from_type(algorithm_info.type)) ? EL_OK : EL_EIO;
     }
 
-    auto ss{concat_strings("\r{\"type\": ",
-                           called_by_event ? "1" : "0",
-                           ", \"name\": \"",
-                           cmd,
-                           "\", \"code\": ",
-                           std::to_string(ret),
-                           ", \"data\": ",
-                           algorithm_info_2_json_str(&algorithm_info),
-                           "}\n")};
-    static_cast<Transport*>(caller)->send_bytes(ss.c_str(), ss.size());
+    JsonWriter w(static_cast<Transport*>(caller));
+    w << "\r{\"type\": " << (called_by_event ? 1 : 0) << ", \"name\": \"" << cmd << "\", \"code\": " << ret
+      << ", \"data\": ";
+    algorithm_info_2_json(w, &algorithm_info);
+    w << "}\n";
 }
 
 void get_algorithm_info(const std::string& cmd, void* caller) {
     const auto& algorithm_info =
       static_resource->algorithm_delegate->get_algorithm_info(static_resource->current_algorithm_type);
 
-    auto ss{concat_strings("\r{\"type\": 0, \"name\": \"",
-                           cmd,
-                           "\", \"code\": ",
-                           std::to_string(EL_OK),
-                           ", \"data\": ",
-                           algorithm_info_2_json_str(&algorithm_info),
-                           "}\n")};
-    static_cast<Transport*>(caller)->send_bytes(ss.c_str(), ss.size());
+    JsonWriter w(static_cast<Transport*>(caller));
+    w << "\r{\"type\": 0, \"name\": \"" << cmd << "\", \"code\": " << EL_OK << ", \"data\": ";
+    algorithm_info_2_json(w, &algorithm_info);
+    w << "}\n";
 }
 
 }  // namespace sscma::callback
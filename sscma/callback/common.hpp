@@ -4,6 +4,7 @@
 #include <string>
 
 #include "core/el_version.h"
+#include "core/utils/el_heap.h"
 #include "sscma/definations.hpp"
 #include "sscma/static_resource.hpp"
 #include "sscma/utility.hpp"
@@ -50,6 +51,9 @@ void get_device_name(const std::string& cmd, void* caller) {
 }
 
 void get_device_status(const std::string& cmd, void* caller) {
+    const auto& profile = static_resource->boot_profile;
+    const char* delim   = "";
+
     auto ss{concat_strings("\r{\"type\": 0, \"name\": \"",
                            cmd,
                            "\", \"code\": ",
@@ -58,7 +62,24 @@ void get_device_status(const std::string& cmd, void* caller) {
                            std::to_string(static_resource->boot_count),
                            ", \"is_ready\": ",
                            std::to_string(static_resource->is_ready.load() ? 1 : 0),
-                           "}}\n")};
+                           ", \"boot\": {\"ready\": ",
+                           std::to_string(profile.get_ready()),
+                           ", \"stages\": [")};
+    for (int i = 0; i < BOOT_STAGE_COUNT; ++i) {
+        auto stage = static_cast<boot_stage_e>(i);
+        ss += concat_strings(delim,
+                             "{\"name\": \"",
+                             BootProfile::get_name(stage),
+                             "\", \"state\": ",
+                             std::to_string(profile.get_state(stage)),
+                             ", \"begin\": ",
+                             std::to_string(profile.get_begin(stage)),
+                             ", \"time\": ",
+                             std::to_string(profile.get_time(stage)),
+                             "}");
+        delim = ", ";
+    }
+    ss += "]}}}\n";
     static_cast<Transport*>(caller)->send_bytes(ss.c_str(), ss.size());
 }
 
@@ -99,4 +120,86 @@ void task_status(const std::string& cmd, bool sta, void* caller) {
     static_cast<Transport*>(caller)->send_bytes(ss.c_str(), ss.size());
 }
 
+void set_reply_format(const std::string& cmd, int format, void* caller) {
+    auto ret = (format == REPLY_FMT_JSON) | (format == REPLY_FMT_BINARY) ? EL_OK : EL_EINVAL;
+    if (ret == EL_OK) [[likely]]
+        static_resource->reply_formats[static_resource->get_origin(caller)] = static_cast<reply_fmt_e>(format);
+
+    // operation replies are always in JSON, only event replies are affected
+    auto ss{concat_strings("\r{\"type\": 0, \"name\": \"",
+                           cmd,
+                           "\", \"code\": ",
+                           std::to_string(ret),
+                           ", \"data\": ",
+                           std::to_string(static_resource->get_reply_format(caller)),
+                           "}\n")};
+    static_cast<Transport*>(caller)->send_bytes(ss.c_str(), ss.size());
+}
+
+void get_reply_format(const std::string& cmd, void* caller) {
+    auto ss{concat_strings("\r{\"type\": 0, \"name\": \"",
+                           cmd,
+                           "\", \"code\": ",
+                           std::to_string(EL_OK),
+                           ", \"data\": ",
+                           std::to_string(static_resource->get_reply_format(caller)),
+                           "}\n")};
+    static_cast<Transport*>(caller)->send_bytes(ss.c_str(), ss.size());
+}
+
+// the combined reply of a batch ends with it, the failed commands are the ones rejected before being executed
+void get_batch_status(const std::string& cmd, std::size_t count, std::size_t failed, void* caller) {
+    auto ss{concat_strings("\r{\"type\": 0, \"name\": \"",
+                           cmd,
+                           "\", \"code\": ",
+                           std::to_string(failed ? EL_EINVAL : EL_OK),
+                           ", \"data\": {\"count\": ",
+                           std::to_string(count),
+                           ", \"failed\": ",
+                           std::to_string(failed),
+                           "}}\n")};
+    static_cast<Transport*>(caller)->send_bytes(ss.c_str(), ss.size());
+}
+
+void get_heap_status(const std::string& cmd, void* caller) {
+    el_heap_stats_t       stats{};
+    el_heap_frame_stats_t frame{};
+    el_heap_get_stats(&stats);
+    el_heap_get_frame_stats(&frame);
+
+    JsonWriter w(static_cast<Transport*>(caller));
+    w << "\r{\"type\": 0, \"name\": \"" << cmd << "\", \"code\": "
+      << (CONFIG_EL_HEAP_ACCOUNTING ? EL_OK : EL_ENOTSUP) << ", \"data\": {\"alloc_count\": " << stats.alloc_count
+      << ", \"free_count\": " << stats.free_count << ", \"alloc_bytes\": " << stats.alloc_bytes
+      << ", \"live_bytes\": " << stats.live_bytes << ", \"peak_bytes\": " << stats.peak_bytes
+      << ", \"frame\": {\"frames\": " << frame.frames << ", \"alloc_count\": " << frame.alloc_count
+      << ", \"alloc_bytes\": " << frame.alloc_bytes << ", \"peak_bytes\": " << frame.peak_bytes
+      << ", \"budget\": " << frame.budget << ", \"over_budget\": " << frame.over_budget << ", \"tags\": {";
+    for (std::size_t i = 0; i < EL_HEAP_TAG_COUNT; ++i) {
+        if (i) w << ", ";
+        w << "\"" << el_heap_tag_name(static_cast<el_heap_tag_t>(i))
+          << "\": {\"alloc_count\": " << frame.tag_alloc_count[i] << ", \"alloc_bytes\": " << frame.tag_alloc_bytes[i]
+          << "}";
+    }
+    w << "}}}}\n";
+}
+
+void set_heap_budget(const std::string& cmd, int budget, void* caller) {
+    auto ret = CONFIG_EL_HEAP_ACCOUNTING ? (budget >= 0 ? EL_OK : EL_EINVAL) : EL_ENOTSUP;
+    if (ret == EL_OK) [[likely]]
+        el_heap_set_budget(static_cast<uint32_t>(budget));
+
+    el_heap_frame_stats_t frame{};
+    el_heap_get_frame_stats(&frame);
+
+    auto ss{concat_strings("\r{\"type\": 0, \"name\": \"",
+                           cmd,
+                           "\", \"code\": ",
+                           std::to_string(ret),
+                           ", \"data\": ",
+                           std::to_string(frame.budget),
+                           "}\n")};
+    static_cast<Transport*>(caller)->send_bytes(ss.c_str(), ss.size());
+}
+
 }  // namespace sscma::callback
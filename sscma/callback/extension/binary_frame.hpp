@@ -0,0 +1,316 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <forward_list>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "core/el_types.h"
+#include "core/synchronize/el_guard.hpp"
+#include "core/utils/el_hash.h"
+#include "porting/el_misc.h"
+#include "porting/el_transport.h"
+#include "sscma/callback/extension/results_filter.hpp"
+#include "sscma/definations.hpp"
+#include "sscma/protocol/binary.hpp"
+
+namespace sscma::extension {
+
+using namespace edgelab;
+
+using namespace sscma::protocol::binary;
+
+// writes a binary frame into a reusable buffer, the buffer is kept between frames to avoid reallocations, the image of
+// a frame is referenced instead of being copied into the buffer, so that it is sent from the encoder output directly
+class BinaryFrameWriter {
+   public:
+    BinaryFrameWriter()
+        : _buffer{},
+          _section_offset{0},
+          _image{},
+          _image_offset{0},
+          _views{},
+          _n_views{0},
+          _transport{nullptr},
+          _is_sending{false},
+          _is_lost{false} {}
+
+    ~BinaryFrameWriter() { wait(); }
+
+    BinaryFrameWriter(const BinaryFrameWriter&)            = delete;
+    BinaryFrameWriter& operator=(const BinaryFrameWriter&) = delete;
+
+    void begin(msg_type_e type) {
+        wait();
+        _buffer.clear();
+        _image        = el_buffer_view_t{};
+        _image_offset = 0;
+        _n_views      = 0;
+        _buffer.append(reinterpret_cast<const char*>(FRAME_MAGIC), sizeof(FRAME_MAGIC));
+        put_u8(FRAME_VERSION);
+        put_u8(type);
+        put_u32(0);  // payload length, patched by end()
+    }
+
+    // returns the number of views of the frame, the image must be kept until the views are sent
+    std::size_t end() {
+        patch_u32(4, static_cast<uint32_t>(_buffer.size() + _image.size - FRAME_HEADER_SIZE));
+
+        const auto* data   = reinterpret_cast<const uint8_t*>(_buffer.data());
+        std::size_t offset = _image.size ? _image_offset : _buffer.size();
+        uint16_t    crc    = el_crc16_maxim(data + sizeof(FRAME_MAGIC), offset - sizeof(FRAME_MAGIC));
+        if (_image.size) {
+            crc = el_crc16_maxim(reinterpret_cast<const uint8_t*>(_image.data), _image.size, crc);
+            crc = el_crc16_maxim(data + offset, _buffer.size() - offset, crc);
+        }
+        put_u16(crc);
+
+        if (!_image.size) {
+            _views[0] = el_buffer_view_t{.data = _buffer.data(), .size = _buffer.size()};
+            _n_views  = 1;
+        } else {
+            _views[0] = el_buffer_view_t{.data = _buffer.data(), .size = offset};
+            _views[1] = _image;
+            _views[2] = el_buffer_view_t{.data = _buffer.data() + offset, .size = _buffer.size() - offset};
+            _n_views  = 3;
+        }
+        return _n_views;
+    }
+
+    inline const el_buffer_view_t* get_views() const { return _views; }
+
+    // the transport may return before the views are sent, the frame and its image are referenced until then, returns
+    // false if the frame is truncated by the transport, a truncated frame is aborted at once, so that the next frame
+    // never waits on it
+    bool send(Transport* transport) {
+        std::size_t size = 0;
+        for (std::size_t i = 0; i < _n_views; ++i) size += _views[i].size;
+        _transport = transport;
+        _is_sending.store(true);
+        const Guard<Mutex> guard(transport->get_reply_lock());
+        if (transport->send_views(_views, _n_views, &BinaryFrameWriter::on_sent, this) == size) [[likely]]
+            return true;
+        transport->abort_views();
+        _is_sending.store(false);
+        _is_lost.store(true);
+        return false;
+    }
+
+    // blocks until the last frame is sent, called before the image of the last frame is reused (e.g. by the camera), a
+    // frame not sent in time is aborted by the transport, so that its buffers are never reused while being sent
+    void wait() {
+        const auto time_start = el_get_time_ms();
+        while (_is_sending.load() && el_get_time_ms() - time_start < SSCMA_FRAME_SEND_WAIT_MS) el_sleep(1);
+        if (!_is_sending.load()) [[likely]]
+            return;
+        _transport->abort_views();
+        _is_sending.store(false);
+        _is_lost.store(true);
+    }
+
+    // true once after a frame is truncated or aborted, the host may have lost it (e.g. the next frame should be a
+    // keyframe instead of the changes since the lost one)
+    inline bool take_lost() { return _is_lost.exchange(false); }
+
+    inline void reserve(std::size_t size) { _buffer.reserve(size); }
+
+    inline void put_u8(uint8_t v) { _buffer += static_cast<char>(v); }
+
+    inline void put_u16(uint16_t v) {
+        put_u8(v & 0xff);
+        put_u8(v >> 8);
+    }
+
+    inline void put_u32(uint32_t v) {
+        put_u16(v & 0xffff);
+        put_u16(v >> 16);
+    }
+
+    inline void put_bytes(const void* data, std::size_t size) {
+        _buffer.append(reinterpret_cast<const char*>(data), size);
+    }
+
+    // the name is truncated to 255 bytes
+    inline void put_name(const std::string& name) {
+        std::size_t len = name.size() > 0xff ? 0xff : name.size();
+        put_u8(len);
+        put_bytes(name.data(), len);
+    }
+
+    inline void begin_section(section_id_e id) {
+        put_u8(id);
+        _section_offset = _buffer.size();
+        put_u32(0);  // section length, patched by end_section()
+    }
+
+    inline void end_section() {
+        patch_u32(_section_offset, static_cast<uint32_t>(_buffer.size() - _section_offset - sizeof(uint32_t)));
+    }
+
+    void put_section(section_id_e id, const void* data, std::size_t size) {
+        put_u8(id);
+        put_u32(size);
+        put_bytes(data, size);
+    }
+
+    void put_perf(uint32_t preprocess, uint32_t run, uint32_t postprocess) {
+        begin_section(SECTION_PERF);
+        put_u32(preprocess);
+        put_u32(run);
+        put_u32(postprocess);
+        end_section();
+    }
+
+    void put_resolution(const el_img_t* img) {
+        begin_section(SECTION_RESOLUTION);
+        put_u16(img->width);
+        put_u16(img->height);
+        end_section();
+    }
+
+    // only one image is referenced by a frame
+    void put_image(const el_img_t* img) {
+        if (!img || !img->data || !img->size || _image.size) [[unlikely]]
+            return;
+        put_u8(SECTION_IMAGE);
+        put_u32(img->size);
+        _image        = el_buffer_view_t{.data = reinterpret_cast<const char*>(img->data), .size = img->size};
+        _image_offset = _buffer.size();
+    }
+
+    template <typename ResultType> void put_results(const std::forward_list<ResultType>& results) {
+        put_records(get_records_section<ResultType>(), results, [this](const ResultType& r) { put_record(r); });
+    }
+
+    // ids of the current results in the order of the results section, the results are matched by the filter
+    template <typename ResultType> void put_ids(const ResultsFilter<ResultType>& filter) {
+        const auto& changes = filter.get_changes();
+        begin_section(SECTION_IDS);
+        put_u16(static_cast<uint16_t>(changes.size() - count_changes(changes, RESULT_REMOVED)));
+        for (const auto& c : changes)
+            if (c.kind != RESULT_REMOVED) put_u32(c.id);
+        end_section();
+    }
+
+    // the added results followed by the moved ones, their ids, and the ids of the removed results
+    template <typename ResultType> void put_delta(const ResultsFilter<ResultType>& filter) {
+        const auto&    changes = filter.get_changes();
+        const uint16_t added   = count_changes(changes, RESULT_ADDED);
+        const uint16_t moved   = count_changes(changes, RESULT_MOVED);
+        const uint16_t removed = count_changes(changes, RESULT_REMOVED);
+
+        begin_section(get_records_section<ResultType>());
+        put_u16(added + moved);
+        for (auto kind : {RESULT_ADDED, RESULT_MOVED})
+            for (const auto& c : changes)
+                if (c.kind == kind) put_record(*c.result);
+        end_section();
+
+        begin_section(SECTION_IDS);
+        put_u16(added + moved);
+        for (auto kind : {RESULT_ADDED, RESULT_MOVED})
+            for (const auto& c : changes)
+                if (c.kind == kind) put_u32(c.id);
+        end_section();
+
+        begin_section(SECTION_DELTA);
+        put_u16(added);
+        put_u16(moved);
+        put_u16(removed);
+        for (const auto& c : changes)
+            if (c.kind == RESULT_REMOVED) put_u32(c.id);
+        end_section();
+    }
+
+   protected:
+    static void on_sent(void* this_pointer) { static_cast<BinaryFrameWriter*>(this_pointer)->_is_sending.store(false); }
+
+    inline void patch_u32(std::size_t offset, uint32_t v) {
+        for (std::size_t i = 0; i < sizeof(uint32_t); ++i) _buffer[offset + i] = static_cast<char>(v >> (i << 3));
+    }
+
+    inline void put_box(const el_box_t& box) {
+        put_u16(box.x);
+        put_u16(box.y);
+        put_u16(box.w);
+        put_u16(box.h);
+        put_u8(box.score);
+        put_u16(box.target);
+    }
+
+    inline void put_point(const el_point_t& point) {
+        put_u16(point.x);
+        put_u16(point.y);
+        put_u8(point.score);
+        put_u8(point.target);
+    }
+
+    inline void put_record(const el_box_t& box) { put_box(box); }
+
+    inline void put_record(const el_point_t& point) { put_point(point); }
+
+    inline void put_record(const el_class_t& cls) {
+        put_u16(cls.score);
+        put_u16(cls.target);
+    }
+
+    inline void put_record(const el_keypoint_t& kp) {
+        put_box(kp.box);
+        put_u8(kp.score);
+        put_u8(kp.target);
+        std::size_t n = kp.pts.size() > 0xff ? 0xff : kp.pts.size();
+        put_u8(n);
+        for (std::size_t i = 0; i < n; ++i) put_point(kp.pts[i]);
+    }
+
+    template <typename ResultType> static constexpr section_id_e get_records_section() {
+        if constexpr (std::is_same_v<ResultType, el_box_t>)
+            return SECTION_BOXES;
+        else if constexpr (std::is_same_v<ResultType, el_point_t>)
+            return SECTION_POINTS;
+        else if constexpr (std::is_same_v<ResultType, el_class_t>)
+            return SECTION_CLASSES;
+        else
+            return SECTION_KEYPOINTS;
+    }
+
+    // the number of results is limited by the algorithms, far below the u16 counts
+    template <typename ChangeType>
+    static inline uint16_t count_changes(const std::vector<ChangeType>& changes, result_change_e kind) {
+        uint16_t n = 0;
+        for (const auto& c : changes) n += c.kind == kind;
+        return n;
+    }
+
+    template <typename ResultType, typename Fn>
+    inline void put_records(section_id_e id, const std::forward_list<ResultType>& results, Fn&& fn) {
+        begin_section(id);
+        std::size_t count_offset = _buffer.size();
+        put_u16(0);  // records count, patched after iteration
+        uint16_t count = 0;
+        for (const auto& r : results) {
+            if (count == 0xffff) [[unlikely]]
+                break;
+            fn(r);
+            ++count;
+        }
+        _buffer[count_offset]     = static_cast<char>(count & 0xff);
+        _buffer[count_offset + 1] = static_cast<char>(count >> 8);
+        end_section();
+    }
+
+   private:
+    std::string       _buffer;
+    std::size_t       _section_offset;
+    el_buffer_view_t  _image;
+    std::size_t       _image_offset;
+    el_buffer_view_t  _views[3];
+    std::size_t       _n_views;
+    Transport*        _transport;
+    std::atomic<bool> _is_sending;
+    std::atomic<bool> _is_lost;
+};
+
+}  // namespace sscma::extension
@@ -0,0 +1,153 @@
+#pragma once
+
+#include "core/el_config_internal.h"
+
+#if CONFIG_EL_TSDB
+
+    #include <algorithm>
+    #include <cstdint>
+    #include <cstring>
+    #include <memory>
+
+    #include "core/data/el_data_timeseries.h"
+    #include "core/el_types.h"
+    #include "sscma/definations.hpp"
+
+namespace sscma::extension {
+
+using namespace edgelab;
+
+constexpr std::size_t RESULT_LOG_CLASSES_MAX = 4;
+
+// summary of the results of a frame, a batch of records is stored as one log timed by the newest record
+typedef struct EL_ATTR_PACKED result_log_record_t {
+    uint32_t age;  // ms before the time of the batch
+    uint8_t  model_id;
+    uint8_t  algorithm_type;
+    uint16_t count;  // number of results
+    uint8_t  max_score;
+    uint8_t  n_classes;
+    uint16_t perf[3];                              // preprocess, run and postprocess time in ms
+    uint16_t classes[RESULT_LOG_CLASSES_MAX][2];  // target and count of the most frequent targets
+} result_log_record_t;
+
+static_assert(sizeof(result_log_record_t) * SSCMA_RESULT_LOG_BATCH_SIZE <= CONFIG_EL_TSDB_LOG_SIZE_MAX);
+
+// records are batched in memory and written once the batch is full or the oldest record is older than the flush
+// interval, so that the flash is written once per batch instead of once per frame
+class ResultLog {
+   public:
+    explicit ResultLog(TimeSeries* time_series)
+        : _time_series(time_series), _flush_interval(0), _size(0), _times{}, _records{} {}
+
+    ~ResultLog() = default;
+
+    ResultLog(const ResultLog&)            = delete;
+    ResultLog& operator=(const ResultLog&) = delete;
+
+    inline void set_flush_interval(uint32_t flush_interval) { _flush_interval = flush_interval; }
+
+    inline std::size_t get_pending() const { return _size; }
+
+    inline int64_t get_time() const { return _time_series->get_time(); }
+
+    inline std::size_t get_count() const { return _time_series->count(0, _time_series->get_last_time()); }
+
+    template <typename AlgorithmType>
+    el_err_code_t append(uint8_t                        model_id,
+                         el_algorithm_type_t            algorithm_type,
+                         std::shared_ptr<AlgorithmType> algorithm) {
+        auto& record          = _records[_size];
+        record                = result_log_record_t{};
+        record.model_id       = model_id;
+        record.algorithm_type = static_cast<uint8_t>(algorithm_type);
+        record.perf[0]        = clamp_u16(algorithm->get_preprocess_time());
+        record.perf[1]        = clamp_u16(algorithm->get_run_time());
+        record.perf[2]        = clamp_u16(algorithm->get_postprocess_time());
+
+        // targets are counted on stack, only the most frequent ones are kept
+        struct {
+            uint16_t target;
+            uint16_t count;
+        } targets[RESULT_LOG_CLASSES_MAX << 2]{};
+        std::size_t n_targets = 0;
+        for (const auto& v : algorithm->get_results()) {
+            if (record.count < UINT16_MAX) [[likely]]
+                ++record.count;
+            if (v.score > record.max_score) record.max_score = v.score > UINT8_MAX ? UINT8_MAX : v.score;
+            std::size_t i = 0;
+            while (i < n_targets && targets[i].target != v.target) ++i;
+            if (i < n_targets)
+                ++targets[i].count;
+            else if (n_targets < (RESULT_LOG_CLASSES_MAX << 2)) [[likely]]
+                targets[n_targets++] = {static_cast<uint16_t>(v.target), 1};
+        }
+        record.n_classes = static_cast<uint8_t>(std::min(n_targets, RESULT_LOG_CLASSES_MAX));
+        std::partial_sort(targets, targets + record.n_classes, targets + n_targets, [](const auto& l, const auto& r) {
+            return l.count > r.count;
+        });
+        for (std::size_t i = 0; i < record.n_classes; ++i) {
+            record.classes[i][0] = targets[i].target;
+            record.classes[i][1] = targets[i].count;
+        }
+
+        _times[_size++] = _time_series->get_time();
+        if (_size < SSCMA_RESULT_LOG_BATCH_SIZE && _times[_size - 1] - _times[0] < _flush_interval) [[likely]]
+            return EL_OK;
+        return flush();
+    }
+
+    el_err_code_t flush() {
+        if (!_size) return EL_OK;
+
+        // time of the logs must be strictly increasing
+        int64_t time = std::max(_times[_size - 1], _time_series->get_last_time() + 1);
+        for (std::size_t i = 0; i < _size; ++i) _records[i].age = static_cast<uint32_t>(time - _times[i]);
+
+        auto ret = _time_series->append(_records, _size * sizeof(result_log_record_t), time);
+        _size    = 0;
+        return ret;
+    }
+
+    // the callable is called with the time and the record of each record in range, returns false to stop
+    template <typename Fn> std::size_t query(int64_t from, int64_t to, Fn&& fn) {
+        flush();
+
+        std::size_t count = 0;
+        int64_t     last  = std::max(from, _time_series->get_last_time());
+        // a batch is timed by its newest record, the batches that end after 'from' are iterated until 'to' is passed
+        _time_series->query(from, last, [&](int64_t time, const uint8_t* data, std::size_t size) {
+            std::size_t n = size / sizeof(result_log_record_t);
+            for (std::size_t i = 0; i < n; ++i) {
+                result_log_record_t record;
+                std::memcpy(&record, data + i * sizeof(result_log_record_t), sizeof(record));
+                int64_t t = time - record.age;
+                if (t < from) continue;
+                if (t > to) return false;
+                ++count;
+                if (!fn(t, record)) return false;
+            }
+            return true;
+        });
+        return count;
+    }
+
+    void clear() {
+        _size = 0;
+        _time_series->clear();
+    }
+
+   protected:
+    static inline uint16_t clamp_u16(uint32_t v) { return v > UINT16_MAX ? UINT16_MAX : static_cast<uint16_t>(v); }
+
+   private:
+    TimeSeries*         _time_series;
+    int64_t             _flush_interval;
+    std::size_t         _size;
+    int64_t             _times[SSCMA_RESULT_LOG_BATCH_SIZE];
+    result_log_record_t _records[SSCMA_RESULT_LOG_BATCH_SIZE];
+};
+
+}  // namespace sscma::extension
+
+#endif
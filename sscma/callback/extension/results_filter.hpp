@@ -2,143 +2,228 @@
 
 #include <algorithm>
 #include <cstdint>
+#include <cstdlib>
 #include <forward_list>
-#include <list>
 #include <utility>
+#include <vector>
 
 #include "core/el_types.h"
-#include "sscma/utility.hpp"
+#include "sscma/definations.hpp"
 
 namespace sscma::extension {
 
-// categorize results by target class
-// the returned view is a list of pairs of target class and a list of pointers to results
-// so the safety of the view is dependent on the lifetime of the input list
-template <typename ResultType>
-inline decltype(auto) get_cls_view_from_results(std::forward_list<ResultType> const& res) {
-    // transform results to pointers view of classes
-    // index view would be safer but std::forward_list doesn't support random access by index efficiently
-    std::forward_list<std::pair<decltype(ResultType::target), std::forward_list<const ResultType*>>> cls_view;
-    for (auto const& i : res) {
-        // if target class is not in the view, add it
-        auto it = std::find_if(cls_view.begin(), cls_view.end(), [&i](auto const& e) { return e.first == i.target; });
-        if (it == cls_view.end())
-            cls_view.push_front({i.target, {&i}});
-        else  // else, add the result to the class view
-            it->second.push_front(&i);
-    }
-    return cls_view;
-}
+// results within the tolerance are the same, results of the same class within the track distance are the same object
+// moved, the score difference is weighted by 1 / (1 << score_shift) in the distance
+struct results_filter_config_t {
+    uint16_t tolerance      = SSCMA_RESULTS_FILTER_TOLERANCE;
+    uint16_t track_distance = SSCMA_RESULTS_FILTER_TRACK_DISTANCE;
+    uint8_t  score_shift    = SSCMA_RESULTS_FILTER_SCORE_SHIFT;
+};
 
-// compare boxes using a euclidean distance like metric
-// we caculate the distance of two boxes by the sum of the absolute value of the difference of each dimension
-// we divide the score difference by 4 to make it less important in the distance calculation
-inline bool compare_result_pair(el_box_t const* l, el_box_t const* r) {
-    auto dx       = l->x - r->x;
-    auto dy       = l->y - r->y;
-    auto dw       = l->w - r->w;
-    auto dh       = l->h - r->h;
-    auto ds       = l->score - r->score;
-    auto distance = std::abs(dx) + std::abs(dy) + std::abs(dw) + std::abs(dh) + (std::abs(ds) >> 2);  // kscore = 1/4
-    return distance > 5;                                                                              // threshold is 5
-}
+typedef enum { RESULT_KEPT = 0, RESULT_ADDED, RESULT_MOVED, RESULT_REMOVED } result_change_e;
+
+// coordinates of a result used for matching, the results are sorted by class and x so that the candidates of a result
+// are found by a binary search
+struct result_key_t {
+    uint16_t target;
+    int32_t  x;
+    int32_t  y;
+    int32_t  w;
+    int32_t  h;
+    int32_t  score;
+};
+
+inline result_key_t get_result_key(el_box_t const& r) { return {r.target, r.x, r.y, r.w, r.h, r.score}; }
+
+inline result_key_t get_result_key(el_point_t const& r) { return {r.target, r.x, r.y, 0, 0, r.score}; }
+
+inline result_key_t get_result_key(el_class_t const& r) { return {r.target, 0, 0, 0, 0, r.score}; }
+
+inline result_key_t get_result_key(el_keypoint_t const& r) { return get_result_key(r.box); }
 
-// compare points using a euclidean distance like metric
-// we caculate the distance of two points by the sum of the absolute value of the difference of each dimension
-// we divide the score difference by 4 to make it less important in the distance calculation
-inline bool compare_result_pair(el_point_t const* l, el_point_t const* r) {
-    auto dx       = l->x - r->x;
-    auto dy       = l->y - r->y;
-    auto ds       = l->score - r->score;
-    auto distance = std::abs(dx) + std::abs(dy) + (std::abs(ds) >> 2);  // kscore = 1/4
-    return distance > 5;                                                // threshold is 5
+// a manhattan like distance, sum of the absolute difference of each dimension
+inline uint32_t get_result_distance(result_key_t const&            l,
+                                    result_key_t const&            r,
+                                    results_filter_config_t const& config) {
+    return std::abs(l.x - r.x) + std::abs(l.y - r.y) + std::abs(l.w - r.w) + std::abs(l.h - r.h) +
+           (std::abs(l.score - r.score) >> config.score_shift);
 }
-// compare classes using a euclidean distance like metric
-// we caculate the distance of two classes by the absolute value of the difference of each dimension
-// we divide the score difference by 4 to make it less important in the distance calculation
-inline bool compare_result_pair(el_class_t const* l, el_class_t const* r) {
-    auto ds       = l->score - r->score;
-    auto distance = std::abs(ds) >> 2;  // kscore = 1/4
-    return distance > 5;                // threshold is 5
+
+template <typename ResultType>
+inline uint32_t get_result_distance(ResultType const& l, ResultType const& r, results_filter_config_t const& config) {
+    return get_result_distance(get_result_key(l), get_result_key(r), config);
 }
 
-// compare keypoints using a euclidean distance like metric
-inline bool compare_result_pair(el_keypoint_t const* l, el_keypoint_t const* r) {
-    auto box_dist = compare_result_pair(&l->box, &r->box);
-    if (box_dist) return true;
-    auto pts_num_min = std::min(l->pts.size(), r->pts.size());
-    for (size_t i = 0; i < pts_num_min; i++) {
-        auto pts_dist = compare_result_pair(&l->pts[i], &r->pts[i]);
-        if (pts_dist) return true;
-    }
-    return false;
+// the distance of keypoints is the largest of their boxes and points
+inline uint32_t get_result_distance(el_keypoint_t const&           l,
+                                    el_keypoint_t const&           r,
+                                    results_filter_config_t const& config) {
+    uint32_t distance    = get_result_distance(l.box, r.box, config);
+    auto     pts_num_min = std::min(l.pts.size(), r.pts.size());
+    for (size_t i = 0; i < pts_num_min; ++i)
+        distance = std::max(distance, get_result_distance(l.pts[i], r.pts[i], config));
+    return distance;
 }
 
-// compare results using a euclidean distance like metric
+// matches the results to the last reported results, each result is given a stable id and reported as kept, added or
+// moved, the last results not matched are reported as removed, the kept results are compared with the last reported
+// position, so that a slowly moving result is reported once it moves out of the tolerance
 template <typename ResultType> class ResultsFilter {
    public:
-    // initialize with a list of results (copy when calling the constructor, its view should bind with itself)
-    ResultsFilter(std::forward_list<ResultType> init) : _last(init), _last_cls_view(get_cls_view_from_results(_last)) {}
+    struct change_t {
+        uint32_t          id;
+        result_change_e   kind;
+        const ResultType* result;  // the current result, or the last reported one if removed
+    };
+
+    explicit ResultsFilter(results_filter_config_t config = {}) : _config(config), _next_id(1) {}
+
+    template <typename Container>
+    explicit ResultsFilter(Container const& init, results_filter_config_t config = {}) : ResultsFilter(config) {
+        compare_and_update(init);
+    }
 
     ~ResultsFilter() = default;
 
-    // compare the input results with the last results (copy on call)
-    bool compare_and_update(std::forward_list<ResultType> current) {
-        // transform results to pointers view of classes (move semantics is required when updating last results)
-        auto current_cls_view{get_cls_view_from_results(current)};
-
-        // if the number of classes is different, the results are different
-        if (std::distance(_last.begin(), _last.end()) != std::distance(current.begin(), current.end()))
-            goto ResultDifferent;
-
-        // if the number of classes is different, the results are different
-        if (std::distance(_last_cls_view.begin(), _last_cls_view.end()) !=
-            std::distance(current_cls_view.begin(), current_cls_view.end()))
-            goto ResultDifferent;
-
-        // compare each class
-        for (const auto& [cls, objs] : _last_cls_view) {
-            // if the class is not in the current results, the results are different
-            auto sub_view = std::find_if(
-              current_cls_view.begin(), current_cls_view.end(), [&cls](auto const& e) { return e.first == cls; });
-            if (sub_view == current_cls_view.end()) goto ResultDifferent;
-
-            // if the number of objects is different, the results are different
-            if (std::distance(objs.begin(), objs.end()) !=
-                std::distance(sub_view->second.begin(), sub_view->second.end()))
-                goto ResultDifferent;
-
-            // create a temporary list for linear removal complexity
-            auto sub_view_objs = std::list(sub_view->second.cbegin(), sub_view->second.cend());
-            for (auto const& i : objs) {
-                // if the object is not in the current results, the results are different
-                auto compare_objs = std::find_if(sub_view_objs.begin(), sub_view_objs.end(), [&i](auto const& e) {
-                    return compare_result_pair(e, i);
-                });
-                if (compare_objs == sub_view_objs.end())
-                    goto ResultDifferent;
-                else  // else, remove the object from the temporary list
-                    sub_view_objs.erase(compare_objs);
+    inline void set_config(results_filter_config_t const& config) { _config = config; }
+
+    // compares the results with the last reported results without copying them, returns true if any result is changed,
+    // the changes are kept until the next call and refer to the results passed in
+    template <typename Container> bool compare_and_update(Container const& current) {
+        _current.clear();
+        for (auto const& r : current) _current.push_back({&r, get_result_key(r), NPOS});
+        return m_update();
+    }
+
+    bool compare_and_update(const ResultType* current, std::size_t size) {
+        _current.clear();
+        for (std::size_t i = 0; i < size; ++i) _current.push_back({current + i, get_result_key(current[i]), NPOS});
+        return m_update();
+    }
+
+    // changes of the current results in the order passed in, followed by the removed results
+    inline std::vector<change_t> const& get_changes() const { return _changes; }
+
+    // takes the current results as the last reported ones, called once all of them are reported (e.g. by a keyframe),
+    // so that the kept results are no longer compared with an older position, the ids and changes are not touched
+    void commit() {
+        _next.clear();
+        for (std::size_t i = 0; i < _current.size(); ++i)
+            _next.push_back({*_current[i].result, _current[i].key, _changes[i].id, false});
+        std::sort(_next.begin(), _next.end(), m_less);
+        std::swap(_last, _next);
+    }
+
+    // the results are reported as added on the next call
+    inline void reset() { _last.clear(); }
+
+   protected:
+    static constexpr std::size_t NPOS = static_cast<std::size_t>(-1);
+
+    struct current_t {
+        const ResultType* result;
+        result_key_t      key;
+        std::size_t       match;
+    };
+
+    struct last_t {
+        ResultType   result;
+        result_key_t key;
+        uint32_t     id;
+        bool         is_matched;
+    };
+
+    static inline bool m_less(last_t const& l, last_t const& r) {
+        return l.key.target < r.key.target || (l.key.target == r.key.target && l.key.x < r.key.x);
+    }
+
+    // the nearest unmatched last result of the same class within the limit
+    std::size_t m_find_nearest(current_t const& c, uint32_t limit) const {
+        const int32_t x_min = c.key.x - static_cast<int32_t>(limit);
+        const int32_t x_max = c.key.x + static_cast<int32_t>(limit);
+        auto          lower =
+          std::lower_bound(_last.begin(), _last.end(), c.key, [x_min](last_t const& l, result_key_t const& k) {
+              return l.key.target < k.target || (l.key.target == k.target && l.key.x < x_min);
+          });
+        std::size_t nearest  = NPOS;
+        uint32_t    distance = limit + 1;
+        for (auto it = lower; it != _last.end() && it->key.target == c.key.target && it->key.x <= x_max; ++it) {
+            if (it->is_matched) continue;
+            uint32_t d = get_result_distance(*c.result, it->result, _config);
+            if (d < distance) {
+                distance = d;
+                nearest  = it - _last.begin();
+            }
+        }
+        return nearest;
+    }
+
+    bool m_update() {
+        bool is_changed = false;
+        _changes.clear();
+        _removed.clear();
+
+        // the same results are matched before the moved ones, so that a moved result does not take a kept one
+        for (auto& c : _current) {
+            c.match = m_find_nearest(c, _config.tolerance);
+            if (c.match != NPOS) _last[c.match].is_matched = true;
+        }
+        for (auto& c : _current) {
+            if (c.match != NPOS) {
+                _changes.push_back({_last[c.match].id, RESULT_KEPT, c.result});
+                continue;
             }
+            is_changed = true;
+            c.match    = m_find_nearest(c, _config.track_distance);
+            if (c.match != NPOS) {
+                _last[c.match].is_matched = true;
+                _changes.push_back({_last[c.match].id, RESULT_MOVED, c.result});
+            } else
+                _changes.push_back({_next_id++, RESULT_ADDED, c.result});
         }
+        for (auto& l : _last) {
+            if (l.is_matched) continue;
+            is_changed = true;
+            _removed.push_back(std::move(l.result));
+            _changes.push_back({l.id, RESULT_REMOVED, nullptr});
+        }
+        // pointers to the removed results are taken once the storage is no longer reallocated
+        for (std::size_t i = 0, j = 0; i < _changes.size(); ++i)
+            if (_changes[i].kind == RESULT_REMOVED) _changes[i].result = &_removed[j++];
+
+        // the kept results keep their last reported position, the others are updated
+        if (!is_changed) [[likely]] {
+            for (auto& l : _last) l.is_matched = false;
+            return false;
+        }
+        _next.clear();
+        for (std::size_t i = 0; i < _current.size(); ++i) {
+            auto const& c = _current[i];
+            if (_changes[i].kind == RESULT_KEPT)
+                _next.push_back(std::move(_last[c.match]));
+            else
+                _next.push_back({*c.result, c.key, _changes[i].id, false});
+            _next.back().is_matched = false;
+        }
+        std::sort(_next.begin(), _next.end(), m_less);
+        std::swap(_last, _next);
 
-        // if the results are the same, return false
-        // move is required to update the last results (because the elements in the view are pointers of the results)
-        _last          = std::move(current);
-        _last_cls_view = std::move(current_cls_view);
-        return false;
-
-    ResultDifferent:
-        // if the results are different, return true
-        // move is required to update the last results (because the elements in the view are pointers of the results)
-        _last          = std::move(current);
-        _last_cls_view = std::move(current_cls_view);
-        return true;
+        return is_changed;
     }
 
    private:
-    std::forward_list<ResultType>                                                                    _last;
-    std::forward_list<std::pair<decltype(ResultType::target), std::forward_list<const ResultType*>>> _last_cls_view;
+    results_filter_config_t _config;
+    uint32_t                _next_id;
+
+    // buffers are reused by each call
+    std::vector<last_t>     _last;
+    std::vector<last_t>     _next;
+    std::vector<current_t>  _current;
+    std::vector<change_t>   _changes;
+    std::vector<ResultType> _removed;
 };
 
+template <typename ResultType>
+ResultsFilter(std::forward_list<ResultType> const&, results_filter_config_t = {}) -> ResultsFilter<ResultType>;
+
 }  // namespace sscma::extension
@@ -7,6 +7,8 @@
 #include <string>
 
 #include "core/algorithm/el_algorithm_delegate.h"
+#include "core/utils/el_heap.h"
+#include "extension/binary_frame.hpp"
 #include "extension/results_filter.hpp"
 #include "sscma/definations.hpp"
 #include "sscma/static_resource.hpp"
@@ -24,7 +26,7 @@ class Invoke final : public std::enable_shared_from_this<Invoke> {
     std::shared_ptr<Invoke> getptr() { return shared_from_this(); }
 
     [[nodiscard]] static std::shared_ptr<Invoke> create(
-      std::string cmd, int32_t n_times, bool differed, bool results_only, void* caller) {
+      std::string cmd, int32_t n_times, invoke_diff_e differed, bool results_only, void* caller) {
         return std::shared_ptr<Invoke>{
           new Invoke{std::move(cmd), n_times, differed, results_only, caller}
         };
@@ -32,13 +34,16 @@ class Invoke final : public std::enable_shared_from_this<Invoke> {
 
     ~Invoke() {
         reset_config_cmds();
+#if CONFIG_EL_TSDB
+        static_resource->result_log->flush();
+#endif
         static_resource->is_invoke = false;
     }
 
     inline void run() { prepare(); }
 
    protected:
-    Invoke(std::string cmd, int32_t n_times, bool differed, bool results_only, void* caller)
+    Invoke(std::string cmd, int32_t n_times, invoke_diff_e differed, bool results_only, void* caller)
         : _cmd{cmd},
           _n_times{n_times},
           _differed{differed},
@@ -50,7 +55,8 @@ class Invoke final : public std::enable_shared_from_this<Invoke> {
           _algorithm_info{},
           _times{0},
           _ret{EL_OK},
-          _action_hash{0} {
+          _action_hash{0},
+          _frame_writer{} {
         static_resource->is_invoke = true;
     }
 
@@ -73,7 +79,7 @@ class Invoke final : public std::enable_shared_from_this<Invoke> {
         return;
 
     Err:
-        direct_reply(algorithm_info_2_json_str(&_algorithm_info));
+        direct_reply([this](JsonWriter& w) { algorithm_info_2_json(w, &_algorithm_info); });
     }
 
     inline void reset_action_hash() { _action_hash = 0; }
@@ -131,31 +137,139 @@ class Invoke final : public std::enable_shared_from_this<Invoke> {
         return true;
     }
 
-    inline void direct_reply(std::string algorithm_config) {
-        auto ss{concat_strings("\r{\"type\": 0, \"name\": \"",
-                               _cmd,
-                               "\", \"code\": ",
-                               std::to_string(_ret),
-                               ", \"data\": {\"model\": ",
-                               model_info_2_json_str(_model_info),
-                               ", \"algorithm\": ",
-                               algorithm_config,
-                               ", \"sensor\": ",
-                               sensor_info_2_json_str(_sensor_info, static_resource->device),
-                               "}}\n")};
-        static_cast<Transport*>(_caller)->send_bytes(ss.c_str(), ss.size());
+    // the algorithm is written by the callable, as its info or its config
+    template <typename AlgorithmWriter> inline void direct_reply(AlgorithmWriter&& algorithm) {
+        JsonWriter w(static_cast<Transport*>(_caller));
+        w << "\r{\"type\": 0, \"name\": \"" << _cmd << "\", \"code\": " << _ret << ", \"data\": {\"model\": ";
+        model_info_2_json(w, _model_info);
+        w << ", \"algorithm\": ";
+        algorithm(w);
+        w << ", \"sensor\": ";
+        sensor_info_2_json(w, _sensor_info, static_resource->device);
+        w << "}}\n";
+    }
+
+    // data is written by the callable, the reply is streamed to the caller without building a string
+    template <typename DataWriter> inline void event_reply(DataWriter&& data) {
+        JsonWriter w(static_cast<Transport*>(_caller));
+        w << "\r{\"type\": 1, \"name\": \"" << _cmd << "\", \"code\": " << _ret << ", \"data\": {\"count\": " << _times;
+        data(w);
+        w << "}}\n";
+    }
+
+    inline void event_frame_begin() {
+        _frame_writer.begin(MSG_TYPE_EVENT);
+        _frame_writer.put_name(_cmd);
+        _frame_writer.put_u8(_ret);
+        _frame_writer.put_u32(_times);
+    }
+
+    inline void event_frame_reply() {
+        _frame_writer.end();
+        _frame_writer.send(static_cast<Transport*>(_caller));
+    }
+
+    template <typename AlgorithmType>
+    inline void event_frame_reply(std::shared_ptr<AlgorithmType> algorithm,
+                                  const el_img_t*                frame,
+                                  const el_img_t*                encoded_frame) {
+        event_frame_begin();
+        _frame_writer.put_perf(
+          algorithm->get_preprocess_time(), algorithm->get_run_time(), algorithm->get_postprocess_time());
+        _frame_writer.put_results(algorithm->get_results());
+        _frame_writer.put_resolution(frame);
+        if (encoded_frame) _frame_writer.put_image(encoded_frame);
+        event_frame_reply();
+    }
+
+    // object ids of the current results, in the order of the results
+    template <typename ResultType>
+    static void results_ids_2_json(JsonWriter& w, const ResultsFilter<ResultType>& filter) {
+        const char* delim = "";
+
+        w << "\"ids\": [";
+        for (const auto& c : filter.get_changes()) {
+            if (c.kind == RESULT_REMOVED) continue;
+            w << delim << c.id;
+            delim = ", ";
+        }
+        w << "]";
+    }
+
+    // changes since the last reported results, the added and moved results are [id, result], the removed ones are ids
+    template <typename ResultType>
+    static void results_delta_2_json(JsonWriter& w, const ResultsFilter<ResultType>& filter) {
+        const auto& changes = filter.get_changes();
+
+        w << "\"delta\": {";
+        for (auto kind : {RESULT_ADDED, RESULT_MOVED}) {
+            const char* delim = "";
+            w << (kind == RESULT_ADDED ? "\"added\": [" : ", \"moved\": [");
+            for (const auto& c : changes) {
+                if (c.kind != kind) continue;
+                w << delim << "[" << c.id << ", ";
+                result_2_json(w, *c.result);
+                w << "]";
+                delim = ", ";
+            }
+            w << "]";
+        }
+        const char* delim = "";
+        w << ", \"removed\": [";
+        for (const auto& c : changes) {
+            if (c.kind != RESULT_REMOVED) continue;
+            w << delim << c.id;
+            delim = ", ";
+        }
+        w << "]}";
     }
 
-    inline void event_reply(std::string data) {
-        auto ss{concat_strings("\r{\"type\": 1, \"name\": \"",
-                               _cmd,
-                               "\", \"code\": ",
-                               std::to_string(_ret),
-                               ", \"data\": {\"count\": ",
-                               std::to_string(_times),
-                               data,
-                               "}}\n")};
-        static_cast<Transport*>(_caller)->send_bytes(ss.c_str(), ss.size());
+    // a keyframe has the full results and their ids, other frames have the changes since the last reply, nothing is
+    // replied if there is no change, the ids are kept by the filter so that the host could track the objects, a binary
+    // frame lost by the transport is followed by a keyframe, so that the host resyncs its results
+    template <typename AlgorithmType, typename ResultType>
+    void event_delta_reply(std::shared_ptr<AlgorithmType> algorithm,
+                           ResultsFilter<ResultType>&     results_filter,
+                           reply_fmt_e                    reply_format,
+                           const el_img_t*                frame,
+                           const el_img_t*                encoded_frame) {
+        const bool is_lost     = reply_format == REPLY_FMT_BINARY && _frame_writer.take_lost();
+        const bool is_changed  = results_filter.compare_and_update(algorithm->get_results());
+        const bool is_keyframe = is_lost || (_times - 1) % SSCMA_INVOKE_DELTA_KEYFRAME_INTERVAL == 0;
+        if (!is_changed && !is_keyframe) [[likely]]
+            return;
+        if (is_keyframe) results_filter.commit();
+
+        const HeapScope heap_scope(EL_HEAP_TAG_REPLY);
+        if (reply_format == REPLY_FMT_BINARY) {
+            event_frame_begin();
+            _frame_writer.put_perf(
+              algorithm->get_preprocess_time(), algorithm->get_run_time(), algorithm->get_postprocess_time());
+            if (is_keyframe) {
+                _frame_writer.put_results(algorithm->get_results());
+                _frame_writer.put_ids(results_filter);
+            } else
+                _frame_writer.put_delta(results_filter);
+            _frame_writer.put_resolution(frame);
+            if (encoded_frame) _frame_writer.put_image(encoded_frame);
+            event_frame_reply();
+        } else
+            event_reply([&](JsonWriter& w) {
+                w << ", \"perf\": [" << algorithm->get_preprocess_time() << ", " << algorithm->get_run_time() << ", "
+                  << algorithm->get_postprocess_time() << "], ";
+                if (is_keyframe) {
+                    results_2_json(w, algorithm->get_results());
+                    w << ", ";
+                    results_ids_2_json(w, results_filter);
+                } else
+                    results_delta_2_json(w, results_filter);
+                w << ", ";
+                img_res_2_json(w, frame);
+                if (encoded_frame) {
+                    w << ", ";
+                    img_2_json(w, encoded_frame);
+                }
+            });
     }
 
     inline void event_loop() {
@@ -164,7 +278,7 @@ class Invoke final : public std::enable_shared_from_this<Invoke> {
             using AlgorithmType = AlgorithmFOMO;
             auto algorithm{std::make_shared<AlgorithmType>(static_resource->engine)};
             register_config_cmds(algorithm);
-            direct_reply(algorithm_config_2_json_str(algorithm));
+            direct_reply([&](JsonWriter& w) { algorithm_config_2_json(w, algorithm); });
             if (is_everything_ok()) [[likely]] {
                 auto results_filter{ResultsFilter(algorithm->get_results())};
                 event_loop_cam(algorithm, std::move(results_filter));
@@ -175,7 +289,7 @@ class Invoke final : public std::enable_shared_from_this<Invoke> {
             using AlgorithmType = AlgorithmPFLD;
             auto algorithm{std::make_shared<AlgorithmType>(static_resource->engine)};
             register_config_cmds(algorithm);
-            direct_reply(algorithm_config_2_json_str(algorithm));
+            direct_reply([&](JsonWriter& w) { algorithm_config_2_json(w, algorithm); });
             if (is_everything_ok()) [[likely]] {
                 auto results_filter{ResultsFilter(algorithm->get_results())};
                 event_loop_cam(algorithm, std::move(results_filter));
@@ -186,7 +300,7 @@ class Invoke final : public std::enable_shared_from_this<Invoke> {
             using AlgorithmType = AlgorithmYOLO;
             auto algorithm{std::make_shared<AlgorithmType>(static_resource->engine)};
             register_config_cmds(algorithm);
-            direct_reply(algorithm_config_2_json_str(algorithm));
+            direct_reply([&](JsonWriter& w) { algorithm_config_2_json(w, algorithm); });
             if (is_everything_ok()) [[likely]] {
                 auto results_filter{ResultsFilter(algorithm->get_results())};
                 event_loop_cam(algorithm, std::move(results_filter));
@@ -197,7 +311,7 @@ class Invoke final : public std::enable_shared_from_this<Invoke> {
             using AlgorithmType = AlgorithmIMCLS;
             auto algorithm{std::make_shared<AlgorithmType>(static_resource->engine)};
             register_config_cmds(algorithm);
-            direct_reply(algorithm_config_2_json_str(algorithm));
+            direct_reply([&](JsonWriter& w) { algorithm_config_2_json(w, algorithm); });
             if (is_everything_ok()) [[likely]] {
                 auto results_filter{ResultsFilter(algorithm->get_results())};
                 event_loop_cam(algorithm, std::move(results_filter));
@@ -208,7 +322,7 @@ class Invoke final : public std::enable_shared_from_this<Invoke> {
             using AlgorithmType = AlgorithmYOLOPOSE;
             auto algorithm{std::make_shared<AlgorithmType>(static_resource->engine)};
             register_config_cmds(algorithm);
-            direct_reply(algorithm_config_2_json_str(algorithm));
+            direct_reply([&](JsonWriter& w) { algorithm_config_2_json(w, algorithm); });
             if (is_everything_ok()) [[likely]] {
                 auto results_filter{ResultsFilter(algorithm->get_results())};
                 event_loop_cam(algorithm, std::move(results_filter));
@@ -219,7 +333,7 @@ class Invoke final : public std::enable_shared_from_this<Invoke> {
             using AlgorithmType = AlgorithmYOLOV8;
             auto algorithm{std::make_shared<AlgorithmType>(static_resource->engine)};
             register_config_cmds(algorithm);
-            direct_reply(algorithm_config_2_json_str(algorithm));
+            direct_reply([&](JsonWriter& w) { algorithm_config_2_json(w, algorithm); });
             if (is_everything_ok()) [[likely]] {
                 auto results_filter{ResultsFilter(algorithm->get_results())};
                 event_loop_cam(algorithm, std::move(results_filter));
@@ -230,7 +344,7 @@ class Invoke final : public std::enable_shared_from_this<Invoke> {
             using AlgorithmType = AlgorithmNvidiaDet;
             auto algorithm{std::make_shared<AlgorithmType>(static_resource->engine)};
             register_config_cmds(algorithm);
-            direct_reply(algorithm_config_2_json_str(algorithm));
+            direct_reply([&](JsonWriter& w) { algorithm_config_2_json(w, algorithm); });
             if (is_everything_ok()) [[likely]] {
                 auto results_filter{ResultsFilter(algorithm->get_results())};
                 event_loop_cam(algorithm, std::move(results_filter));
@@ -240,7 +354,7 @@ class Invoke final : public std::enable_shared_from_this<Invoke> {
 
         default:
             _ret = EL_ENOTSUP;
-            direct_reply(algorithm_info_2_json_str(&_algorithm_info));
+            direct_reply([this](JsonWriter& w) { algorithm_info_2_json(w, &_algorithm_info); });
         }
     }
 
@@ -270,15 +384,9 @@ class Invoke final : public std::enable_shared_from_this<Invoke> {
                                         ? EL_OK
                                         : EL_EIO;
                             }
-                            auto ss{concat_strings("\r{\"type\": 0, \"name\": \"",
-                                                   cmd,
-                                                   "\", \"code\": ",
-                                                   std::to_string(ret),
-                                                   ", \"data\": ",
-                                                   std::to_string(algorithm->get_score_threshold()),
-                                                   "}\n")};
-                            static_cast<Transport*>(caller)->send_bytes(ss.c_str(), ss.size());
-                            // caller, buffer, cahr* id
+                            JsonWriter w(static_cast<Transport*>(caller));
+                            w << "\r{\"type\": 0, \"name\": \"" << cmd << "\", \"code\": " << ret
+                              << ", \"data\": " << algorithm->get_score_threshold() << "}\n";
                         });
                       return EL_OK;
                   }) == EL_OK) [[likely]]
@@ -289,14 +397,9 @@ class Invoke final : public std::enable_shared_from_this<Invoke> {
                   "TSCORE?", "Get score threshold", "", [algorithm](std::vector<std::string> argv, void* caller) {
                       static_resource->executor->add_task(
                         [algorithm, cmd = std::move(argv[0]), caller](const std::atomic<bool>&) {
-                            auto ss{concat_strings("\r{\"type\": 0, \"name\": \"",
-                                                   cmd,
-                                                   "\", \"code\": ",
-                                                   std::to_string(EL_OK),
-                                                   ", \"data\": ",
-                                                   std::to_string(algorithm->get_score_threshold()),
-                                                   "}\n")};
-                            static_cast<Transport*>(caller)->send_bytes(ss.c_str(), ss.size());
+                            JsonWriter w(static_cast<Transport*>(caller));
+                            w << "\r{\"type\": 0, \"name\": \"" << cmd << "\", \"code\": " << EL_OK
+                              << ", \"data\": " << algorithm->get_score_threshold() << "}\n";
                         });
                       return EL_OK;
                   }) == EL_OK) [[likely]]
@@ -319,14 +422,9 @@ class Invoke final : public std::enable_shared_from_this<Invoke> {
                                         ? EL_OK
                                         : EL_EIO;
                             }
-                            auto ss{concat_strings("\r{\"type\": 0, \"name\": \"",
-                                                   cmd,
-                                                   "\", \"code\": ",
-                                                   std::to_string(ret),
-                                                   ", \"data\": ",
-                                                   std::to_string(algorithm->get_iou_threshold()),
-                                                   "}\n")};
-                            static_cast<Transport*>(caller)->send_bytes(ss.c_str(), ss.size());
+                            JsonWriter w(static_cast<Transport*>(caller));
+                            w << "\r{\"type\": 0, \"name\": \"" << cmd << "\", \"code\": " << ret
+                              << ", \"data\": " << algorithm->get_iou_threshold() << "}\n";
                         });
                       return EL_OK;
                   }) == EL_OK) [[likely]]
@@ -337,14 +435,9 @@ class Invoke final : public std::enable_shared_from_this<Invoke> {
                   "TIOU?", "Get IoU threshold", "", [algorithm](std::vector<std::string> argv, void* caller) {
                       static_resource->executor->add_task(
                         [algorithm, cmd = std::move(argv[0]), caller](const std::atomic<bool>&) {
-                            auto ss{concat_strings("\r{\"type\": 0, \"name\": \"",
-                                                   cmd,
-                                                   "\", \"code\": ",
-                                                   std::to_string(EL_OK),
-                                                   ", \"data\": ",
-                                                   std::to_string(algorithm->get_iou_threshold()),
-                                                   "}\n")};
-                            static_cast<Transport*>(caller)->send_bytes(ss.c_str(), ss.size());
+                            JsonWriter w(static_cast<Transport*>(caller));
+                            w << "\r{\"type\": 0, \"name\": \"" << cmd << "\", \"code\": " << EL_OK
+                              << ", \"data\": " << algorithm->get_iou_threshold() << "}\n";
                         });
                       return EL_OK;
                   }) == EL_OK) [[likely]]
@@ -358,13 +451,14 @@ class Invoke final : public std::enable_shared_from_this<Invoke> {
         if (static_resource->current_task_id.load(std::memory_order_seq_cst) != _task_id) [[unlikely]]
             return;
 
-        auto camera = static_resource->device->get_camera();
-        auto frame  = el_img_t{};
-#if CONFIG_EL_HAS_ACCELERATED_JPEG_CODEC
-        auto processed_frame = el_img_t{};
-#endif
-        auto encoded_frame_str = std::string{};
+        auto camera        = static_resource->device->get_camera();
+        auto frame         = el_img_t{};
+        auto encoded_frame = el_img_t{};
+        auto reply_format  = static_resource->get_reply_format(_caller);
+
+        el_heap_frame_begin();
 
+        _frame_writer.wait();  // the camera buffer may be still sent as the image of the last frame
         _ret = camera->start_stream();
         if (!is_everything_ok()) [[unlikely]]
             goto Err;
@@ -375,12 +469,15 @@ class Invoke final : public std::enable_shared_from_this<Invoke> {
 
         if (!_results_only) {
 #if CONFIG_EL_HAS_ACCELERATED_JPEG_CODEC
-            _ret = camera->get_processed_frame(&processed_frame);
+            _ret = camera->get_processed_frame(&encoded_frame);
             if (!is_everything_ok()) [[unlikely]]
                 goto Err;
-            encoded_frame_str = std::move(img_2_json_str(&processed_frame));
 #else
-            encoded_frame_str = std::move(img_2_jpeg_json_str(&frame));
+            if (img_2_preview_jpeg(&frame,
+                                   &encoded_frame,
+                                   &static_resource->preview_config,
+                                   &static_resource->jpeg_config) != EL_OK) [[unlikely]]
+                encoded_frame = el_img_t{};
 #endif
         }
 
@@ -394,24 +491,37 @@ class Invoke final : public std::enable_shared_from_this<Invoke> {
         }
         static_resource->action->evalute(_caller);
 
+#if CONFIG_EL_TSDB
+        if (static_resource->result_log_config.enabled) [[unlikely]]
+            static_resource->result_log->append(_model_info.id, _algorithm_info.type, algorithm);
+#endif
+
         _ret = camera->stop_stream();
         if (!is_everything_ok()) [[unlikely]]
             goto Err;
 
-        if (!_differed || results_filter.compare_and_update(algorithm->get_results())) {
-            if (_results_only)
-                event_reply(
-                  concat_strings(", ", algorithm_results_2_json_str(algorithm), ", ", img_res_2_json_str(&frame)));
-            else {
-                event_reply(concat_strings(", ",
-                                           algorithm_results_2_json_str(algorithm),
-                                           ", ",
-                                           img_res_2_json_str(&frame),
-                                           ", ",
-                                           std::move(encoded_frame_str)));
-            }
+        if (_differed == INVOKE_DIFF_DELTA) [[unlikely]]
+            event_delta_reply(
+              algorithm, results_filter, reply_format, &frame, _results_only ? nullptr : &encoded_frame);
+        else if (_differed == INVOKE_DIFF_NONE || results_filter.compare_and_update(algorithm->get_results())) {
+            const HeapScope heap_scope(EL_HEAP_TAG_REPLY);
+            if (reply_format == REPLY_FMT_BINARY)
+                event_frame_reply(algorithm, &frame, _results_only ? nullptr : &encoded_frame);
+            else
+                event_reply([&](JsonWriter& w) {
+                    w << ", ";
+                    algorithm_results_2_json(w, algorithm);
+                    w << ", ";
+                    img_res_2_json(w, &frame);
+                    if (!_results_only) {
+                        w << ", ";
+                        img_2_json(w, &encoded_frame);  // base64 is streamed, no image sized buffer
+                    }
+                });
         }
 
+        el_heap_frame_end();
+
         static_resource->executor->add_task(
           [_this = std::move(getptr()), _algorithm = std::move(algorithm), _results_filter = std::move(results_filter)](
             const std::atomic<bool>& stop_token) {
@@ -422,7 +532,12 @@ class Invoke final : public std::enable_shared_from_this<Invoke> {
         return;
 
     Err:
-        event_reply("");
+        if (reply_format == REPLY_FMT_BINARY) {
+            event_frame_begin();
+            event_frame_reply();
+        } else
+            event_reply([](JsonWriter&) {});
+        el_heap_frame_end();
     }
 
     template <typename AlgorithmType> void action_injection(std::shared_ptr<AlgorithmType> algorithm) {
@@ -484,10 +599,10 @@ class Invoke final : public std::enable_shared_from_this<Invoke> {
 
    private:
     std::string _cmd;
-    int32_t     _n_times;
-    bool        _differed;
-    bool        _results_only;
-    void*       _caller;
+    int32_t       _n_times;
+    invoke_diff_e _differed;
+    bool          _results_only;
+    void*         _caller;
 
     std::size_t         _task_id;
     el_sensor_info_t    _sensor_info;
@@ -499,6 +614,8 @@ class Invoke final : public std::enable_shared_from_this<Invoke> {
     uint16_t      _action_hash;
 
     std::forward_list<std::string> _config_cmds;
+
+    BinaryFrameWriter _frame_writer;
 };
 
 }  // namespace sscma::callback
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <algorithm>
 #include <string>
 
 #include "sscma/definations.hpp"
@@ -14,38 +15,75 @@ void get_available_models(const std::string& cmd, void* caller) {
     const auto& models_info = static_resource->models->get_all_model_info();
     const char* delim       = "";
 
-    std::string ss{
-      concat_strings("\r{\"type\": 0, \"name\": \"", cmd, "\", \"code\": ", std::to_string(EL_OK), ", \"data\": [")};
+    JsonWriter w(static_cast<Transport*>(caller));
+    w << "\r{\"type\": 0, \"name\": \"" << cmd << "\", \"code\": " << EL_OK << ", \"data\": [";
     for (const auto& i : models_info) {
-        ss += concat_strings(delim, model_info_2_json_str(i));
+        w << delim;
+        model_info_2_json(w, i);
         delim = ", ";
     }
-    ss += "]}\n";
-
-    static_cast<Transport*>(caller)->send_bytes(ss.c_str(), ss.size());
+    w << "]}\n";
 }
 
 void set_model(const std::string& cmd, uint8_t model_id, void* caller, bool called_by_event = false) {
+    // the model loaded into the engine, a model of the same id, location and CRC is not loaded again
+    static struct {
+        uint8_t     id;
+        const void* addr;
+        size_t      size;
+        uint32_t    crc32;
+    } loaded{};
+
     const auto& model_info = static_resource->models->get_model_info(model_id);
+    auto        perf       = el_engine_load_perf_t{};
+    uint32_t    verify_us  = 0;
+    uint64_t    start_time = el_get_time_us();
+    bool        is_reused  = false;
 
     // a valid model id should always > 0
     auto ret = model_info.id ? EL_OK : EL_EINVAL;
+    // the verification result is cached, only a model not yet checked in background is verified here
+    auto verify     = model_info.id ? static_resource->models->verify(model_id) : EL_MODEL_VERIFY_NONE;
+    auto meta       = static_resource->models->get_model_meta(model_id);
+    auto arena_size = meta.arena_size;
+    verify_us       = el_get_time_us() - start_time;
     if (ret != EL_OK) [[unlikely]]
         goto ModelReply;
 
-    // allocate tensor arena once (memset to 0 every time)
-    static auto* tensor_arena = el_aligned_malloc_once(32, CONFIG_SSCMA_TENSOR_ARENA_SIZE);
-    std::memset(tensor_arena, 0, CONFIG_SSCMA_TENSOR_ARENA_SIZE);
+    // reject corrupted models and models not fitting the arena before touching the engine
+    if (verify == EL_MODEL_VERIFY_FAILED || arena_size > CONFIG_SSCMA_TENSOR_ARENA_SIZE) [[unlikely]] {
+        ret = verify == EL_MODEL_VERIFY_FAILED ? EL_EINVAL : EL_ENOMEM;
+        // the loaded model is kept, unless it is the one rejected
+        if (static_resource->current_model_id == model_id) goto ModelError;
+        goto ModelReply;
+    }
 
-    // init engine with tensor arena
-    ret = static_resource->engine->init(tensor_arena, CONFIG_SSCMA_TENSOR_ARENA_SIZE);
-    if (ret != EL_OK) [[unlikely]]
-        goto ModelError;
+    // the requested model is already loaded, the engine and the tensor arena are reused as is
+    if (loaded.id == model_id && loaded.addr == model_info.addr_memory && loaded.size == model_info.size &&
+        loaded.crc32 == meta.crc32 && static_resource->current_model_id == model_id) {
+        is_reused = true;
+        goto ModelReply;
+    }
+    loaded.id = 0;
+
+    {
+        // allocate tensor arena once, it is not cleared between the models, the interpreter initializes every tensor
+        // and buffer it allocates from the arena (persistent ones at the tail as well as the ones at the head)
+        static auto* tensor_arena = el_aligned_malloc_once(32, CONFIG_SSCMA_TENSOR_ARENA_SIZE);
+
+        // init engine with tensor arena
+        ret = static_resource->engine->init(tensor_arena, CONFIG_SSCMA_TENSOR_ARENA_SIZE);
+        if (ret != EL_OK) [[unlikely]]
+            goto ModelError;
+
+        // load model from flash to tensor arena (memory)
+        ret  = static_resource->engine->load_model(model_info.addr_memory, model_info.size);
+        perf = static_resource->engine->get_load_perf();
+        if (ret != EL_OK) [[unlikely]]
+            goto ModelError;
+    }
 
-    // load model from flash to tensor arena (memory)
-    ret = static_resource->engine->load_model(model_info.addr_memory, model_info.size);
-    if (ret != EL_OK) [[unlikely]]
-        goto ModelError;
+    loaded = {model_id, model_info.addr_memory, model_info.size, meta.crc32};
 
     // if model id changed, update current model id
     if (static_resource->current_model_id != model_id) {
@@ -62,31 +100,26 @@ void set_model(const std::string& cmd, uint8_t model_id, void* caller, bool call
 
 ModelError:
     static_resource->current_model_id = 0;
+    loaded.id                         = 0;
 
 ModelReply:
-    auto ss{concat_strings("\r{\"type\": ",
-                           std::to_string(called_by_event ? 1 : 0),
-                           ", \"name\": \"",
-                           cmd,
-                           "\", \"code\": ",
-                           std::to_string(ret),
-                           ", \"data\": {\"model\": ",
-                           model_info_2_json_str(model_info),
-                           "}}\n")};
-    static_cast<Transport*>(caller)->send_bytes(ss.c_str(), ss.size());
+    uint64_t   total_us = el_get_time_us() - start_time;
+    JsonWriter w(static_cast<Transport*>(caller));
+    w << "\r{\"type\": " << (called_by_event ? 1 : 0) << ", \"name\": \"" << cmd << "\", \"code\": " << ret
+      << ", \"data\": {\"model\": ";
+    model_info_2_json(w, model_info);
+    w << ", \"reused\": " << (is_reused ? 1 : 0) << ", \"perf\": {\"verify\": " << verify_us
+      << ", \"map\": " << perf.map << ", \"construct\": " << perf.construct << ", \"allocate\": " << perf.allocate
+      << ", \"total\": " << total_us << "}}}\n";
 }
 
 void get_model_info(const std::string& cmd, void* caller) {
     const auto& model_info = static_resource->models->get_model_info(static_resource->current_model_id);
 
-    auto ss{concat_strings("\r{\"type\": 0, \"name\": \"",
-                           cmd,
-                           "\", \"code\": ",
-                           std::to_string(EL_OK),
-                           ", \"data\": ",
-                           model_info_2_json_str(model_info),
-                           "}\n")};
-    static_cast<Transport*>(caller)->send_bytes(ss.c_str(), ss.size());
+    JsonWriter w(static_cast<Transport*>(caller));
+    w << "\r{\"type\": 0, \"name\": \"" << cmd << "\", \"code\": " << EL_OK << ", \"data\": ";
+    model_info_2_json(w, model_info);
+    w << "}\n";
 }
 
 }  // namespace sscma::callback
@@ -42,12 +42,10 @@ void get_mqtt_pubsub(const std::string& cmd, void* caller) {
     config.sub_qos = 0;
 #endif
 
-    auto ss{concat_strings("\r{\"type\": 0, \"name\": \"",
-                           cmd,
-                           "\", \"code\": 0, \"data\": {\"config\": ",
-                           mqtt_pubsub_config_2_json_str(config),
-                           "}}\n")};
-    static_cast<Transport*>(caller)->send_bytes(ss.c_str(), ss.size());
+    JsonWriter w(static_cast<Transport*>(caller));
+    w << "\r{\"type\": 0, \"name\": \"" << cmd << "\", \"code\": 0, \"data\": {\"config\": ";
+    mqtt_pubsub_config_2_json(w, config);
+    w << "}}\n";
 }
 
 void set_mqtt_server(const std::vector<std::string>& argv, void* caller, bool called_by_event = false) {
@@ -75,6 +73,7 @@ void set_mqtt_server(const std::vector<std::string>& argv, void* caller, bool ca
     ret = static_resource->mqtt->set_mqtt_server_config(config) ? EL_OK : EL_EINVAL;
     if (ret != EL_OK) [[unlikely]]
         goto Reply;
+    static_resource->supervisor->notify();  // brought up by the supervisor at once
 #else
     shared_variables::mqtt_server_config = config;
 #endif
@@ -83,29 +82,20 @@ void set_mqtt_server(const std::vector<std::string>& argv, void* caller, bool ca
         ret = static_resource->storage->emplace(el_make_storage_kv_from_type(config)) ? EL_OK : EL_FAILED;
 
 Reply:
-    auto ss{concat_strings("\r{\"type\": ",
-                           called_by_event ? "1" : "0",
-                           ", \"name\": \"",
-                           argv[0],
-                           "\", \"code\": ",
-                           std::to_string(ret),
-                           ", \"data\": ",
-                           mqtt_server_config_2_json_str(config, called_by_event),
-                           "}\n")};
-    static_cast<Transport*>(caller)->send_bytes(ss.c_str(), ss.size());
+    JsonWriter w(static_cast<Transport*>(caller));
+    w << "\r{\"type\": " << (called_by_event ? 1 : 0) << ", \"name\": \"" << argv[0] << "\", \"code\": " << ret
+      << ", \"data\": ";
+    mqtt_server_config_2_json(w, config);
+    w << "}\n";
 }
 
 #if SSCMA_HAS_NATIVE_NETWORKING == 0
 void set_mqtt_status(const std::vector<std::string>& argv, void* caller) {
     shared_variables::mqtt_status = std::atoi(argv[1].c_str());
 
-    auto ss{concat_strings("\r{\"type\": 0",
-                           ", \"name\": \"",
-                           argv[0],
-                           "\", \"code\": 0, \"data\": {\"status\": ",
-                           std::to_string(shared_variables::mqtt_status),
-                           "}}\n")};
-    static_cast<Transport*>(caller)->send_bytes(ss.c_str(), ss.size());
+    JsonWriter w(static_cast<Transport*>(caller));
+    w << "\r{\"type\": 0, \"name\": \"" << argv[0] << "\", \"code\": 0, \"data\": {\"status\": "
+      << shared_variables::mqtt_status << "}}\n";
 }
 #endif
 
@@ -124,14 +114,11 @@ void get_mqtt_server(const std::string& cmd, void* caller) {
     static_resource->storage->get(el_make_storage_kv_from_type(config));  // discard return error code
 #endif
 
-    auto ss{concat_strings("\r{\"type\": 0, \"name\": \"",
-                           cmd,
-                           "\", \"code\": 0, \"data\": {\"status\": ",
-                           std::to_string(sta_code),
-                           ", \"config\": ",
-                           mqtt_server_config_2_json_str(config),
-                           "}}\n")};
-    static_cast<Transport*>(caller)->send_bytes(ss.c_str(), ss.size());
+    JsonWriter w(static_cast<Transport*>(caller));
+    w << "\r{\"type\": 0, \"name\": \"" << cmd << "\", \"code\": 0, \"data\": {\"status\": " << sta_code
+      << ", \"config\": ";
+    mqtt_server_config_2_json(w, config);
+    w << "}}\n";
 }
 
 }  // namespace sscma::callback
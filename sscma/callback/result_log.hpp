@@ -0,0 +1,98 @@
+#pragma once
+
+#include "core/el_config_internal.h"
+
+#if CONFIG_EL_TSDB
+
+    #include <cstdint>
+    #include <string>
+
+    #include "sscma/definations.hpp"
+    #include "sscma/static_resource.hpp"
+    #include "sscma/utility.hpp"
+
+namespace sscma::callback {
+
+using namespace edgelab;
+
+using namespace sscma::utility;
+
+inline void result_log_status_2_json(JsonWriter& w) {
+    w << "{\"enabled\": " << static_resource->result_log_config.enabled
+      << ", \"flush_interval\": " << static_resource->result_log_config.flush_interval
+      << ", \"now\": " << static_resource->result_log->get_time()
+      << ", \"pending\": " << static_resource->result_log->get_pending()
+      << ", \"batches\": " << static_resource->result_log->get_count() << "}";
+}
+
+inline void result_log_record_2_json(JsonWriter& w, int64_t time, const result_log_record_t& record) {
+    w << "{\"time\": " << time << ", \"model\": " << record.model_id << ", \"algorithm\": " << record.algorithm_type
+      << ", \"count\": " << record.count << ", \"max_score\": " << record.max_score << ", \"classes\": [";
+    for (std::size_t i = 0; i < record.n_classes; ++i) {
+        if (i) w << ", ";
+        w << '[' << record.classes[i][0] << ", " << record.classes[i][1] << ']';
+    }
+    w << "], \"perf\": [" << record.perf[0] << ", " << record.perf[1] << ", " << record.perf[2] << "]}";
+}
+
+void set_result_log(const std::string& cmd, int enabled, int flush_interval, void* caller) {
+    auto ret = ((enabled == 0) | (enabled == 1)) & (flush_interval >= 0) ? EL_OK : EL_EINVAL;
+    if (ret != EL_OK) [[unlikely]]
+        goto ResultLogReply;
+
+    // pending records are written before the logging is disabled
+    if (!enabled) static_resource->result_log->flush();
+
+    static_resource->result_log_config = result_log_config_t{.enabled        = static_cast<bool>(enabled),
+                                                             .flush_interval = static_cast<uint32_t>(flush_interval)};
+    static_resource->result_log->set_flush_interval(static_resource->result_log_config.flush_interval);
+    ret = static_resource->storage->emplace(el_make_storage_kv_from_type(static_resource->result_log_config))
+            ? EL_OK
+            : EL_EIO;
+
+ResultLogReply:
+    JsonWriter w(static_cast<Transport*>(caller));
+    w << "\r{\"type\": 0, \"name\": \"" << cmd << "\", \"code\": " << ret << ", \"data\": ";
+    result_log_status_2_json(w);
+    w << "}\n";
+}
+
+void get_result_log(const std::string& cmd, void* caller) {
+    JsonWriter w(static_cast<Transport*>(caller));
+    w << "\r{\"type\": 0, \"name\": \"" << cmd << "\", \"code\": " << EL_OK << ", \"data\": ";
+    result_log_status_2_json(w);
+    w << "}\n";
+}
+
+// records are streamed to the caller in time order, a negative 'to' queries until now
+void query_result_log(const std::string& cmd, int64_t from, int64_t to, void* caller) {
+    if (to < 0) to = INT64_MAX;
+    auto ret = (from >= 0) & (from <= to) ? EL_OK : EL_EINVAL;
+
+    JsonWriter w(static_cast<Transport*>(caller));
+    w << "\r{\"type\": 0, \"name\": \"" << cmd << "\", \"code\": " << ret
+      << ", \"data\": {\"now\": " << static_resource->result_log->get_time() << ", \"records\": [";
+    std::size_t count = 0;
+    const char* delim = "";
+    if (ret == EL_OK) [[likely]]
+        count = static_resource->result_log->query(from, to, [&](int64_t time, const result_log_record_t& record) {
+            w << delim;
+            result_log_record_2_json(w, time, record);
+            delim = ", ";
+            return true;
+        });
+    w << "], \"count\": " << count << "}}\n";
+}
+
+void clear_result_log(const std::string& cmd, void* caller) {
+    static_resource->result_log->clear();
+
+    JsonWriter w(static_cast<Transport*>(caller));
+    w << "\r{\"type\": 0, \"name\": \"" << cmd << "\", \"code\": " << EL_OK << ", \"data\": ";
+    result_log_status_2_json(w);
+    w << "}\n";
+}
+
+}  // namespace sscma::callback
+
+#endif
@@ -4,12 +4,14 @@
 #include <memory>
 #include <string>
 
+#include "extension/binary_frame.hpp"
 #include "sscma/definations.hpp"
 #include "sscma/static_resource.hpp"
 #include "sscma/utility.hpp"
 
 namespace sscma::callback {
 
+using namespace sscma::extension;
 using namespace sscma::utility;
 
 class Sample final : public std::enable_shared_from_this<Sample> {
@@ -33,7 +35,8 @@ class Sample final : public std::enable_shared_from_this<Sample> {
           _caller{caller},
           _task_id{static_resource->current_task_id.load(std::memory_order_seq_cst)},
           _times{0},
-          _ret{EL_OK} {
+          _ret{EL_OK},
+          _frame_writer{} {
         static_resource->is_sample = true;
     }
 
@@ -66,26 +69,35 @@ class Sample final : public std::enable_shared_from_this<Sample> {
     }
 
     inline void direct_reply() {
-        auto ss{concat_strings("\r{\"type\": 0, \"name\": \"",
-                               _cmd,
-                               "\", \"code\": ",
-                               std::to_string(_ret),
-                               ", \"data\": {\"sensor\": ",
-                               sensor_info_2_json_str(_sensor_info, static_resource->device),
-                               "}}\n")};
-        static_cast<Transport*>(_caller)->send_bytes(ss.c_str(), ss.size());
+        JsonWriter w(static_cast<Transport*>(_caller));
+        w << "\r{\"type\": 0, \"name\": \"" << _cmd << "\", \"code\": " << _ret << ", \"data\": {\"sensor\": ";
+        sensor_info_2_json(w, _sensor_info, static_resource->device);
+        w << "}}\n";
     }
 
-    inline void event_reply(std::string data) {
-        auto ss{concat_strings("\r{\"type\": 1, \"name\": \"",
-                               _cmd,
-                               "\", \"code\": ",
-                               std::to_string(_ret),
-                               ", \"data\": {\"count\": ",
-                               std::to_string(_times),
-                               data,
-                               "}}\n")};
-        static_cast<Transport*>(_caller)->send_bytes(ss.c_str(), ss.size());
+    inline void event_reply(const el_img_t* frame = nullptr, const el_img_t* encoded_frame = nullptr) {
+        JsonWriter w(static_cast<Transport*>(_caller));
+        w << "\r{\"type\": 1, \"name\": \"" << _cmd << "\", \"code\": " << _ret << ", \"data\": {\"count\": " << _times;
+        if (frame) {
+            w << ", ";
+            img_res_2_json(w, frame);
+        }
+        if (encoded_frame) {
+            w << ", ";
+            img_2_json(w, encoded_frame);
+        }
+        w << "}}\n";
+    }
+
+    inline void event_frame_reply(const el_img_t* frame = nullptr, const el_img_t* encoded_frame = nullptr) {
+        _frame_writer.begin(MSG_TYPE_EVENT);
+        _frame_writer.put_name(_cmd);
+        _frame_writer.put_u8(_ret);
+        _frame_writer.put_u32(_times);
+        if (frame) _frame_writer.put_resolution(frame);
+        if (encoded_frame) _frame_writer.put_image(encoded_frame);
+        _frame_writer.end();
+        _frame_writer.send(static_cast<Transport*>(_caller));
     }
 
     inline void event_loop() {
@@ -105,10 +117,12 @@ class Sample final : public std::enable_shared_from_this<Sample> {
         if (static_resource->current_task_id.load(std::memory_order_seq_cst) != _task_id) [[unlikely]]
             return;
 
-        auto camera            = static_resource->device->get_camera();
-        auto frame             = el_img_t{};
-        auto encoded_frame_str = std::string{};
+        auto camera        = static_resource->device->get_camera();
+        auto frame         = el_img_t{};
+        auto encoded_frame = el_img_t{};
+        auto reply_format  = static_resource->get_reply_format(_caller);
 
+        _frame_writer.wait();  // the camera buffer may be still sent as the image of the last frame
         _ret = camera->start_stream();
         if (!is_everything_ok()) [[unlikely]]
             goto Err;
@@ -118,27 +132,37 @@ class Sample final : public std::enable_shared_from_this<Sample> {
         if (!is_everything_ok()) [[unlikely]]
             goto Err;
 
-        encoded_frame_str = std::move(img_2_json_str(&frame));
+        encoded_frame = frame;
 #else
         _ret = camera->get_frame(&frame);
         if (!is_everything_ok()) [[unlikely]]
             goto Err;
 
-        encoded_frame_str = std::move(img_2_jpeg_json_str(&frame));
+        if (img_2_preview_jpeg(&frame,
+                               &encoded_frame,
+                               &static_resource->preview_config,
+                               &static_resource->jpeg_config) != EL_OK) [[unlikely]]
+            encoded_frame = el_img_t{};
 #endif
 
         _ret = camera->stop_stream();
         if (!is_everything_ok()) [[unlikely]]
             goto Err;
 
-        event_reply(concat_strings(", ", img_res_2_json_str(&frame), ", ", std::move(encoded_frame_str)));
+        if (reply_format == REPLY_FMT_BINARY)
+            event_frame_reply(&frame, &encoded_frame);
+        else
+            event_reply(&frame, &encoded_frame);
 
         static_resource->executor->add_task(
           [_this = std::move(getptr())](const std::atomic<bool>&) { _this->event_loop_cam(); });
         return;
 
     Err:
-        event_reply("");
+        if (reply_format == REPLY_FMT_BINARY)
+            event_frame_reply();
+        else
+            event_reply();
     }
 
     inline bool is_everything_ok() const { return _ret == EL_OK; }
@@ -153,6 +177,8 @@ class Sample final : public std::enable_shared_from_this<Sample> {
     int32_t          _times;
 
     el_err_code_t _ret;
+
+    BinaryFrameWriter _frame_writer;
 };
 
 }  // namespace sscma::callback
@@ -15,16 +15,14 @@ void get_available_sensors(const std::string& cmd, void* caller) {
     const auto& registered_sensors = static_resource->device->get_all_sensor_info();
     const char* delim              = "";
 
-    std::string ss{
-      concat_strings("\r{\"type\": 0, \"name\": \"", cmd, "\", \"code\": ", std::to_string(EL_OK), ", \"data\": [")};
-
+    JsonWriter w(static_cast<Transport*>(caller));
+    w << "\r{\"type\": 0, \"name\": \"" << cmd << "\", \"code\": " << EL_OK << ", \"data\": [";
     for (const auto& i : registered_sensors) {
-        ss += concat_strings(delim, sensor_info_2_json_str(i, static_resource->device, true));
+        w << delim;
+        sensor_info_2_json(w, i, static_resource->device, true);
         delim = ", ";
     }
-    ss += "]}\n";
-
-    static_cast<Transport*>(caller)->send_bytes(ss.c_str(), ss.size());
+    w << "]}\n";
 }
 
 void set_sensor(
@@ -79,29 +77,80 @@ SensorError:
     static_resource->current_sensor_id = 0;
 
 SensorReply:
-    auto ss{concat_strings("\r{\"type\": ",
-                           std::to_string(called_by_event ? 1 : 0),
-                           ", \"name\": \"",
-                           cmd,
-                           "\", \"code\": ",
-                           std::to_string(ret),
-                           ", \"data\": {\"sensor\": ",
-                           sensor_info_2_json_str(sensor_info, static_resource->device),
-                           "}}\n")};
-    static_cast<Transport*>(caller)->send_bytes(ss.c_str(), ss.size());
+    // the sensor is brought up on the boot worker outside the executor, only its reply is serialized with the others
+    JsonWriter w(static_cast<Transport*>(caller));
+    w << "\r{\"type\": " << (called_by_event ? 1 : 0) << ", \"name\": \"" << cmd << "\", \"code\": " << ret
+      << ", \"data\": {\"sensor\": ";
+    sensor_info_2_json(w, sensor_info, static_resource->device);
+    w << "}}\n";
 }
 
 void get_sensor_info(const std::string& cmd, void* caller) {
     const auto& sensor_info = static_resource->device->get_sensor_info(static_resource->current_sensor_id);
 
-    auto ss{concat_strings("\r{\"type\": 0, \"name\": \"",
-                           cmd,
-                           "\", \"code\": ",
-                           std::to_string(EL_OK),
-                           ", \"data\": ",
-                           sensor_info_2_json_str(sensor_info, static_resource->device),
-                           "}\n")};
-    static_cast<Transport*>(caller)->send_bytes(ss.c_str(), ss.size());
+    JsonWriter w(static_cast<Transport*>(caller));
+    w << "\r{\"type\": 0, \"name\": \"" << cmd << "\", \"code\": " << EL_OK << ", \"data\": ";
+    sensor_info_2_json(w, sensor_info, static_resource->device);
+    w << "}\n";
+}
+
+void set_jpeg_config(const std::string& cmd, int quality, int subsample, int max_size, void* caller) {
+    // the budget should leave room for the JPEG headers
+    auto ret = (quality >= EL_JPEG_QUALITY_BEST) & (quality <= EL_JPEG_QUALITY_LOW) &
+                   (subsample >= EL_JPEG_SUBSAMPLE_444) & (subsample <= EL_JPEG_SUBSAMPLE_420) &
+                   ((max_size == 0) | (max_size >= static_cast<int>(EL_JPEG_OUTPUT_HEADROOM << 1)))
+                 ? EL_OK
+                 : EL_EINVAL;
+    if (ret != EL_OK) [[unlikely]]
+        goto JpegReply;
+
+    static_resource->jpeg_config = el_jpeg_config_t{.quality   = static_cast<uint8_t>(quality),
+                                                    .subsample = static_cast<uint8_t>(subsample),
+                                                    .max_size  = static_cast<uint32_t>(max_size)};
+    ret = static_resource->storage->emplace(el_make_storage_kv_from_type(static_resource->jpeg_config)) ? EL_OK
+                                                                                                         : EL_EIO;
+
+JpegReply:
+    JsonWriter w(static_cast<Transport*>(caller));
+    w << "\r{\"type\": 0, \"name\": \"" << cmd << "\", \"code\": " << ret << ", \"data\": ";
+    jpeg_config_2_json(w, &static_resource->jpeg_config);
+    w << "}\n";
+}
+
+void get_jpeg_config(const std::string& cmd, void* caller) {
+    JsonWriter w(static_cast<Transport*>(caller));
+    w << "\r{\"type\": 0, \"name\": \"" << cmd << "\", \"code\": " << EL_OK << ", \"data\": ";
+    jpeg_config_2_json(w, &static_resource->jpeg_config);
+    w << "}\n";
+}
+
+void set_preview_config(const std::string& cmd, int width, int height, int format, void* caller) {
+    auto ret = (width >= 0) & (width <= UINT16_MAX) & (height >= 0) & (height <= UINT16_MAX) &
+                   ((format == EL_PIXEL_FORMAT_RGB888) | (format == EL_PIXEL_FORMAT_RGB565) |
+                    (format == EL_PIXEL_FORMAT_GRAYSCALE) | (format == EL_PIXEL_FORMAT_UNKNOWN))
+                 ? EL_OK
+                 : EL_EINVAL;
+    if (ret != EL_OK) [[unlikely]]
+        goto PreviewReply;
+
+    static_resource->preview_config = preview_config_t{.width  = static_cast<uint16_t>(width),
+                                                       .height = static_cast<uint16_t>(height),
+                                                       .format = static_cast<uint8_t>(format)};
+    ret = static_resource->storage->emplace(el_make_storage_kv_from_type(static_resource->preview_config)) ? EL_OK
+                                                                                                            : EL_EIO;
+
+PreviewReply:
+    JsonWriter w(static_cast<Transport*>(caller));
+    w << "\r{\"type\": 0, \"name\": \"" << cmd << "\", \"code\": " << ret << ", \"data\": ";
+    preview_config_2_json(w, &static_resource->preview_config);
+    w << "}\n";
+}
+
+void get_preview_config(const std::string& cmd, void* caller) {
+    JsonWriter w(static_cast<Transport*>(caller));
+    w << "\r{\"type\": 0, \"name\": \"" << cmd << "\", \"code\": " << EL_OK << ", \"data\": ";
+    preview_config_2_json(w, &static_resource->preview_config);
+    w << "}\n";
 }
 
 }  // namespace sscma::callback
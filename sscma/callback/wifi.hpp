@@ -25,21 +25,15 @@ static in6_info_t  in6_info{};
 void set_wifi_ver(const std::vector<std::string>& argv, void* caller) {
     shared_variables::wifi_ver = argv[1];
 
-    auto ss{concat_strings("\r{\"type\": 0, \"name\": \"",
-                           argv[0],
-                           "\", \"code\": 0, \"data\": {\"ver\": \"",
-                           shared_variables::wifi_ver,
-                           "\"}}\n")};
-    static_cast<Transport*>(caller)->send_bytes(ss.c_str(), ss.size());
+    JsonWriter w(static_cast<Transport*>(caller));
+    w << "\r{\"type\": 0, \"name\": \"" << argv[0] << "\", \"code\": 0, \"data\": {\"ver\": \""
+      << shared_variables::wifi_ver << "\"}}\n";
 }
 
 void get_wifi_ver(const std::string& cmd, void* caller) {
-    auto ss{concat_strings("\r{\"type\": 0, \"name\": \"",
-                           cmd,
-                           "\", \"code\": 0, \"data\": {\"ver\": \"",
-                           shared_variables::wifi_ver,
-                           "\"}}\n")};
-    static_cast<Transport*>(caller)->send_bytes(ss.c_str(), ss.size());
+    JsonWriter w(static_cast<Transport*>(caller));
+    w << "\r{\"type\": 0, \"name\": \"" << cmd << "\", \"code\": 0, \"data\": {\"ver\": \"" << shared_variables::wifi_ver
+      << "\"}}\n";
 }
 
 void set_wifi_network(const std::vector<std::string>& argv, void* caller, bool called_by_event = false) {
@@ -61,35 +55,27 @@ void set_wifi_network(const std::vector<std::string>& argv, void* caller, bool c
     ret = static_resource->wifi->set_wifi_config(config) ? EL_OK : EL_EINVAL;
     if (ret != EL_OK) [[unlikely]]
         goto Reply;
+    static_resource->supervisor->notify();  // brought up by the supervisor at once
 #endif
 
     if (!called_by_event) [[likely]]
         ret = static_resource->storage->emplace(el_make_storage_kv_from_type(config)) ? EL_OK : EL_FAILED;
 
 Reply:
-    auto ss{concat_strings("\r{\"type\": ",
-                           called_by_event ? "1" : "0",
-                           ", \"name\": \"",
-                           argv[0],
-                           "\", \"code\": ",
-                           std::to_string(ret),
-                           ", \"data\": ",
-                           wifi_config_2_json_str(config, called_by_event),
-                           "}\n")};
-    static_cast<Transport*>(caller)->send_bytes(ss.c_str(), ss.size());
+    JsonWriter w(static_cast<Transport*>(caller));
+    w << "\r{\"type\": " << (called_by_event ? 1 : 0) << ", \"name\": \"" << argv[0] << "\", \"code\": " << ret
+      << ", \"data\": ";
+    wifi_config_2_json(w, config);
+    w << "}\n";
 }
 
 #if SSCMA_HAS_NATIVE_NETWORKING == 0
 void set_wifi_status(const std::vector<std::string>& argv, void* caller) {
     shared_variables::wifi_status = std::atoi(argv[1].c_str());
 
-    auto ss{concat_strings("\r{\"type\": 0",
-                           ", \"name\": \"",
-                           argv[0],
-                           "\", \"code\": 0, \"data\": {\"status\": ",
-                           std::to_string(shared_variables::wifi_status),
-                           "}}\n")};
-    static_cast<Transport*>(caller)->send_bytes(ss.c_str(), ss.size());
+    JsonWriter w(static_cast<Transport*>(caller));
+    w << "\r{\"type\": 0, \"name\": \"" << argv[0] << "\", \"code\": 0, \"data\": {\"status\": "
+      << shared_variables::wifi_status << "}}\n";
 }
 
 void set_wifi_in4_info(const std::vector<std::string>& argv, void* caller) {
@@ -97,23 +83,19 @@ void set_wifi_in4_info(const std::vector<std::string>& argv, void* caller) {
     shared_variables::in4_info.netmask = ipv4_addr_t::from_str(argv[2]);
     shared_variables::in4_info.gateway = ipv4_addr_t::from_str(argv[3]);
 
-    auto ss{concat_strings("\r{\"type\": 0, \"name\": \"",
-                           argv[0],
-                           "\", \"code\": 0, \"data\": {\"in4_info\": ",
-                           in4_info_2_json_str(shared_variables::in4_info),
-                           "}}\n")};
-    static_cast<Transport*>(caller)->send_bytes(ss.c_str(), ss.size());
+    JsonWriter w(static_cast<Transport*>(caller));
+    w << "\r{\"type\": 0, \"name\": \"" << argv[0] << "\", \"code\": 0, \"data\": {\"in4_info\": ";
+    in4_info_2_json(w, shared_variables::in4_info);
+    w << "}}\n";
 }
 
 void set_wifi_in6_info(const std::vector<std::string>& argv, void* caller) {
     shared_variables::in6_info.ip = ipv6_addr_t::from_str(argv[1]);
 
-    auto ss{concat_strings("\r{\"type\": 0, \"name\": \"",
-                           argv[0],
-                           "\", \"code\": 0, \"data\": {\"in6_info\": ",
-                           in6_info_2_json_str(shared_variables::in6_info),
-                           "}}\n")};
-    static_cast<Transport*>(caller)->send_bytes(ss.c_str(), ss.size());
+    JsonWriter w(static_cast<Transport*>(caller));
+    w << "\r{\"type\": 0, \"name\": \"" << argv[0] << "\", \"code\": 0, \"data\": {\"in6_info\": ";
+    in6_info_2_json(w, shared_variables::in6_info);
+    w << "}}\n";
 }
 #endif
 
@@ -136,18 +118,15 @@ void get_wifi_network(const std::string& cmd, void* caller) {
 #endif
     static_resource->storage->get(el_make_storage_kv_from_type(config));  // discard return error code
 
-    auto ss{concat_strings("\r{\"type\": 0, \"name\": \"",
-                           cmd,
-                           "\", \"code\": 0, \"data\": {\"status\": ",
-                           std::to_string(sta_code),
-                           ", \"in4_info\": ",
-                           in4_info_2_json_str(in4),
-                           ", \"in6_info\": ",
-                           in6_info_2_json_str(in6),
-                           ", \"config\": ",
-                           wifi_config_2_json_str(config),
-                           "}}\n")};
-    static_cast<Transport*>(caller)->send_bytes(ss.c_str(), ss.size());
+    JsonWriter w(static_cast<Transport*>(caller));
+    w << "\r{\"type\": 0, \"name\": \"" << cmd << "\", \"code\": 0, \"data\": {\"status\": " << sta_code
+      << ", \"in4_info\": ";
+    in4_info_2_json(w, in4);
+    w << ", \"in6_info\": ";
+    in6_info_2_json(w, in6);
+    w << ", \"config\": ";
+    wifi_config_2_json(w, config);
+    w << "}}\n";
 }
 
 }  // namespace sscma::callback
@@ -12,32 +12,75 @@
 #ifndef SSCMA_REPL_EXECUTOR_PRIO
     #define SSCMA_REPL_EXECUTOR_PRIO 5
 #endif
+#define SSCMA_REPL_EXECUTOR_WAIT_MS 1000  // the worker is woken up at once when a task is added
 
 #define SSCMA_REPL_SUPERVISOR_NAME       "sscma#supervisor"
 #define SSCMA_REPL_SUPERVISOR_STACK_SIZE 6144U
 #ifndef SSCMA_REPL_SUPERVISOR_PRIO
     #define SSCMA_REPL_SUPERVISOR_PRIO (SSCMA_REPL_EXECUTOR_PRIO + 1)
 #endif
-#define SSCMA_REPL_SUPERVISOR_POLL_DELAY 5000
+#define SSCMA_REPL_SUPERVISOR_POLL_DELAY 5000  // the supervisor is woken up at once when notified
+
+// the input loop is woken up at once by the transports able to tell the arrival of data, it blocks until then if all the
+// transports could tell, otherwise the others are polled, briefly for a while after the last input and slowly when idle
+#define SSCMA_REPL_INPUT_WAIT_MS        60000
+#define SSCMA_REPL_INPUT_POLL_DELAY_MIN 1
+#define SSCMA_REPL_INPUT_POLL_DELAY_MAX 20
+#define SSCMA_REPL_INPUT_ACTIVE_MS      1000
+
+#define SSCMA_BOOT_WORKER_NAME       "sscma#boot"
+#define SSCMA_BOOT_WORKER_STACK_SIZE 8192U
+#define SSCMA_BOOT_WAIT_TIMEOUT_MS   100U  // a waited boot stage is checked again at least every 100 ms
 
 #ifndef SSCMA_HAS_NATIVE_NETWORKING
     #define SSCMA_HAS_NATIVE_NETWORKING 0
 #endif
 
-#ifndef SSCMA_SHARED_BASE64_BUFFER
-    #define SSCMA_SHARED_BASE64_BUFFER 0
-#else
-    #ifndef SSCMA_SHARED_BASE64_BUFFER_BASE or SSCMA_SHARED_BASE64_BUFFER_SIZE
-        #error "Please specify base and size for shared base64 buffer"
-    #endif
-#endif
-
 #define SSCMA_REPL_HISTORY_MAX               8
+#define SSCMA_REPL_ARGC_MAX                  16U  // arguments of a command, tokenized on stack
+#define SSCMA_REPL_CMD_TABLE_SIZE_MIN        64U  // slots of the command hash table, a power of 2
+#define SSCMA_REPL_BATCH_DELIM               ';'  // delimiter of the commands in a batch line
 
 #define SSCMA_AT_API_MAJOR_VERSION           "v0"
 
 #define SSCMA_CMD_MAX_LENGTH                 4096U
 
+#ifndef SSCMA_BATCH_REPLY_SIZE_MAX
+    #define SSCMA_BATCH_REPLY_SIZE_MAX 4096U  // replies of a batch combined at most
+#endif
+
+#ifndef SSCMA_BATCH_REPLY_HOLD_MS
+    #define SSCMA_BATCH_REPLY_HOLD_MS 1000U  // replies of a batch held at most
+#endif
+
+#ifndef SSCMA_FRAME_SEND_WAIT_MS
+    #define SSCMA_FRAME_SEND_WAIT_MS 3000U  // a binary frame sent from its views is waited at most, then aborted
+#endif
+
+#ifndef SSCMA_JSON_WRITER_CHUNK_SIZE
+    #define SSCMA_JSON_WRITER_CHUNK_SIZE 512U
+#endif
+
+#ifndef SSCMA_RESULTS_FILTER_TOLERANCE
+    #define SSCMA_RESULTS_FILTER_TOLERANCE 5U  // results within the distance are the same in differed invoke
+#endif
+
+#ifndef SSCMA_RESULTS_FILTER_TRACK_DISTANCE
+    #define SSCMA_RESULTS_FILTER_TRACK_DISTANCE 64U  // results of a class within the distance are the same object
+#endif
+
+#ifndef SSCMA_RESULTS_FILTER_SCORE_SHIFT
+    #define SSCMA_RESULTS_FILTER_SCORE_SHIFT 2U  // score difference is weighted by 1/4 in the distance
+#endif
+
+#ifndef SSCMA_INVOKE_DELTA_KEYFRAME_INTERVAL
+    #define SSCMA_INVOKE_DELTA_KEYFRAME_INTERVAL 30U  // full results are sent every N frames in delta invoke
+#endif
+
+#ifndef SSCMA_RESULT_LOG_BATCH_SIZE
+    #define SSCMA_RESULT_LOG_BATCH_SIZE 16U  // records written to the result log at once
+#endif
+
 #define SSCMA_STORAGE_KEY_VERSION            "sscma#version"
 #define SSCMA_STORAGE_KEY_ACTION             "sscma#action"
 #define SSCMA_STORAGE_KEY_INFO               "sscma#info"
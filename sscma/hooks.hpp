@@ -26,6 +26,7 @@ using namespace edgelab::utility;
 
 using namespace sscma::utility;
 using namespace sscma::callback;
+using namespace sscma::prototypes;
 
 // may cause undefined behavior
 static auto default_transport = []() { return static_resource->transports.front(); };
@@ -41,12 +42,31 @@ void init_model_hook(std::string cmd) {
         set_model(cmd + "@MODEL", static_resource->current_model_id, static_cast<void*>(default_transport()), true);
 }
 
+// models with a checksum are verified in background, one chunk per task so that the executor is never blocked long
+void init_model_verify_hook() {
+    static_resource->executor->add_task([](const std::atomic<bool>&) {
+        if (static_resource->models->verify_step()) init_model_verify_hook();
+    });
+}
+
 void init_sensor_hook(std::string cmd) {
     if (static_resource->current_sensor_id) [[likely]]
         set_sensor(
           cmd + "@SENSOR", static_resource->current_sensor_id, true, 0, static_cast<void*>(default_transport()), true);
 }
 
+// the cached config writes are committed on the supervisor instead of the AT server, so that the input is never blocked
+// by a flash erase, writes in a short window (e.g. a sequence of set commands) are committed at once
+class StorageSyncJob final : public Supervisable {
+   public:
+    void poll_from_supervisor() override { static_resource->storage->sync(CONFIG_EL_STORAGE_SYNC_DELAY_MS); }
+};
+
+void init_storage_sync_hook() {
+    static StorageSyncJob job;
+    static_resource->supervisor->register_supervised_object(&job, 100);
+}
+
 void init_action_hook(std::string cmd) {
     if (static_resource->storage->contains(SSCMA_STORAGE_KEY_ACTION)) [[likely]] {
         char action[SSCMA_CMD_MAX_LENGTH]{};
@@ -0,0 +1,149 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#include "core/el_types.h"
+#include "core/synchronize/el_guard.hpp"
+#include "core/synchronize/el_mutex.hpp"
+#include "porting/el_misc.h"
+#include "porting/el_transport.h"
+#include "sscma/definations.hpp"
+
+namespace sscma::transport {
+
+using namespace edgelab;
+
+// the caller of the commands in a batch line, replies are combined while a batch is open and sent to the transport by
+// one write once the batch is done, so that a host could send a batch and wait for a single combined reply, the
+// replies are sent as they come once the combined reply is too large or held too long (e.g. a streaming invoke)
+class Batch final : public Transport {
+   public:
+    explicit Batch(Transport* transport)
+        : _transport(transport), _lock(), _generation(0), _depth(0), _since(0), _is_holding(false) {
+        this->type        = transport->type;  // e.g. replies to MQTT are written as whole messages
+        this->_is_present = true;
+    }
+
+    ~Batch() = default;
+
+    Batch(const Batch&)            = delete;
+    Batch& operator=(const Batch&) = delete;
+
+    inline Transport* get_transport() const { return _transport; }
+
+    // replies to the batch and to its transport are serialized by the same lock, the reply lock is always taken before
+    // the lock of the batch
+    const Mutex& get_reply_lock() const override { return _transport->get_reply_lock(); }
+
+    // batches from the same transport could be nested, the replies are held until the outermost batch is done, returns
+    // the generation of the held replies to be passed to end()
+    uint32_t begin() {
+        const Guard<Mutex> guard(_lock);
+        if (!_is_holding) [[likely]] {
+            _depth      = 0;
+            _is_holding = true;
+            _since      = el_get_time_ms();
+            ++_generation;
+        }
+        ++_depth;
+        return _generation;
+    }
+
+    // the batches released by poll() (e.g. on a cancelled executor) are not waited on, their late end() calls are
+    // ignored by the generation, so that they never end a batch begun after them
+    void end(uint32_t generation) {
+        const Guard<Mutex> reply_guard(get_reply_lock());
+        const Guard<Mutex> guard(_lock);
+        if (!_is_holding || generation != _generation || --_depth != 0) [[unlikely]]
+            return;
+        m_flush();
+        _is_holding = false;
+    }
+
+    // releases the replies held too long, called periodically so that the replies are never held forever, the reply
+    // lock is only waited on once the replies are due
+    void poll() {
+        {
+            const Guard<Mutex> guard(_lock);
+            if (!m_is_due()) [[likely]]
+                return;
+        }
+        const Guard<Mutex> reply_guard(get_reply_lock());
+        const Guard<Mutex> guard(_lock);
+        if (!m_is_due()) [[unlikely]]
+            return;
+        m_flush();
+        _is_holding = false;
+    }
+
+    // the time until the held replies are due, poll() has nothing to release before then
+    uint32_t get_due_ms() const {
+        const Guard<Mutex> guard(_lock);
+        if (!_is_holding) [[likely]]
+            return UINT32_MAX;
+        uint64_t held = el_get_time_ms() - _since;
+        return held > SSCMA_BATCH_REPLY_HOLD_MS ? 0 : SSCMA_BATCH_REPLY_HOLD_MS - held + 1;
+    }
+
+    std::size_t send_bytes(const char* buffer, size_t size) override {
+        const el_buffer_view_t view{.data = buffer, .size = size};
+        return send_views(&view, 1);
+    }
+
+    std::size_t send_views(const el_buffer_view_t* views,
+                           size_t                  n,
+                           el_send_done_cb_t       done = nullptr,
+                           void*                   arg  = nullptr) override {
+        const Guard<Mutex> guard(_lock);
+        if (!_is_holding) [[likely]]
+            return _transport->send_views(views, n, done, arg);
+
+        std::size_t size = 0;
+        for (std::size_t i = 0; i < n; ++i) size += views[i].size;
+        if (_buffer.size() + size <= SSCMA_BATCH_REPLY_SIZE_MAX &&
+            el_get_time_ms() - _since <= SSCMA_BATCH_REPLY_HOLD_MS) [[likely]] {
+            for (std::size_t i = 0; i < n; ++i) _buffer.append(views[i].data, views[i].size);
+            if (done) done(arg);
+            return size;
+        }
+
+        // replies are kept in order, the rest of the batch is replied as it comes
+        m_flush();
+        _is_holding = false;
+        return _transport->send_views(views, n, done, arg);
+    }
+
+    // the held views are copied and released at once, only the views sent to the transport could be in flight
+    void abort_views() override { _transport->abort_views(); }
+
+    std::size_t read_bytes(char* buffer, size_t size) override { return _transport->read_bytes(buffer, size); }
+
+    char echo(bool only_visible = true) override { return _transport->echo(only_visible); }
+
+    char get_char() override { return _transport->get_char(); }
+
+    std::size_t get_line(char* buffer, size_t size, const char delim = 0x0d) override {
+        return _transport->get_line(buffer, size, delim);
+    }
+
+   protected:
+    inline bool m_is_due() const { return _is_holding && el_get_time_ms() - _since > SSCMA_BATCH_REPLY_HOLD_MS; }
+
+    inline void m_flush() {
+        if (_buffer.empty()) return;
+        _transport->send_bytes(_buffer.data(), _buffer.size());
+        _buffer.clear();
+    }
+
+   private:
+    Transport*  _transport;
+    Mutex       _lock;
+    uint32_t    _generation;
+    std::size_t _depth;
+    uint64_t    _since;
+    bool        _is_holding;
+    std::string _buffer;
+};
+
+}  // namespace sscma::transport
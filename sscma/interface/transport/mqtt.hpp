@@ -62,6 +62,7 @@ class MQTT final : public Supervisable, public Transport {
             mqtt->set_down({mqtt_sta_e::DISCONNECTED, mqtt->get_last_mqtt_server_config()});
         });
 
+        this->type        = EL_TRANSPORT_MQTT;
         this->_is_present = true;
     }
 
@@ -145,6 +146,8 @@ class MQTT final : public Supervisable, public Transport {
         return m_send_bytes(config.pub_topic, config.pub_qos, buffer, size);
     }
 
+    bool is_recv_notified() const override { return true; }
+
     char echo(bool only_visible = true) override {
         auto config = get_mqtt_pubsub_config();
         auto c      = get_char();
@@ -213,8 +216,14 @@ class MQTT final : public Supervisable, public Transport {
     }
 
     void emit_mqtt_discover() {
-        auto config = get_mqtt_pubsub_config();
-        auto ss{concat_strings("\r", mqtt_pubsub_config_2_json_str(config), "\n")};
+        auto        config = get_mqtt_pubsub_config();
+        std::string ss;
+        {
+            JsonWriter w(&ss);
+            w << '\r';
+            mqtt_pubsub_config_2_json(w, config);
+            w << '\n';
+        }
         char discover_topic[SSCMA_MQTT_TOPIC_LEN]{};
         std::snprintf(
           discover_topic, sizeof(discover_topic) - 1, SSCMA_MQTT_DISCOVER_TOPIC, SSCMA_AT_API_MAJOR_VERSION);
@@ -255,6 +264,7 @@ class MQTT final : public Supervisable, public Transport {
 
         if (!this_ptr->push_to_buffer(msg, mlen)) [[unlikely]]
             EL_LOGD("[SSCMA] MQTT::mqtt_subscribe_callback() - buffer may corrupted");
+        this_ptr->notify_recv();
     }
 
     inline bool push_to_buffer(const char* bytes, std::size_t size) {
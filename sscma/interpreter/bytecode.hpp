@@ -0,0 +1,118 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace sscma::interpreter::bytecode {
+
+// stack machine, the operands of a binary operator are the top 2 values (the right one on top, except for DIV)
+enum class OpCode : uint8_t {
+    PUSH,       // push the argument
+    LOAD,       // push the value of the mutable in the slot of the argument
+    RAISE,      // push 0 and raise an exception (unknown operator)
+    ADD,
+    SUB,
+    MUL,
+    DIV,        // divides the top by the value below it, the right operand is evaluated first
+    DIV_GUARD,  // raises an exception and jumps to the argument if the top (right operand of DIV) is 0
+    GT,
+    LT,
+    GE,
+    LE,
+    EQ,
+    NE,
+    AND,        // jumps to the argument if the top is 0, pops otherwise (short circuit of &&)
+    OR,         // replaces the top by 1 and jumps to the argument if the top is not 0, pops otherwise (of ||)
+    BOOL,       // replaces the top by 0 or 1
+};
+
+struct Instruction {
+    OpCode  op;
+    int32_t arg;
+};
+
+// the binary operators are resolved once on compile
+inline OpCode operator_2_opcode(const std::string& name) {
+    static const struct {
+        const char* name;
+        OpCode      op;
+    } operators[] = {{"&&", OpCode::AND},
+                     {"||", OpCode::OR},
+                     {"+", OpCode::ADD},
+                     {"-", OpCode::SUB},
+                     {"*", OpCode::MUL},
+                     {"/", OpCode::DIV},
+                     {">", OpCode::GT},
+                     {"<", OpCode::LT},
+                     {">=", OpCode::GE},
+                     {"<=", OpCode::LE},
+                     {"==", OpCode::EQ},
+                     {"!=", OpCode::NE}};
+    for (const auto& o : operators)
+        if (name == o.name) return o.op;
+    return OpCode::RAISE;
+}
+
+class Program {
+   public:
+    Program() : _depth(0), _max_depth(0) {}
+
+    ~Program() = default;
+
+    inline void emit(OpCode op, int32_t arg = 0) {
+        _code.push_back(Instruction{.op = op, .arg = arg});
+        // the depth is tracked on the path without jumps, jumps always land on the same depth
+        switch (op) {
+        case OpCode::PUSH:
+        case OpCode::LOAD:
+        case OpCode::RAISE:
+            if (++_depth > _max_depth) _max_depth = _depth;
+            break;
+        case OpCode::DIV_GUARD:
+        case OpCode::BOOL:
+            break;
+        default:
+            --_depth;
+        }
+    }
+
+    // returns the position of the emitted jump, the target is set by patch() once known
+    inline std::size_t emit_jump(OpCode op) {
+        emit(op);
+        return _code.size() - 1;
+    }
+
+    inline void patch(std::size_t pos) { _code[pos].arg = static_cast<int32_t>(_code.size()); }
+
+    // mutables of the same name share a slot
+    inline int32_t intern(const std::string& name) {
+        for (std::size_t i = 0; i < _slots.size(); ++i)
+            if (_slots[i] == name) return static_cast<int32_t>(i);
+        _slots.push_back(name);
+        return static_cast<int32_t>(_slots.size() - 1);
+    }
+
+    inline const std::vector<Instruction>& get_code() const { return _code; }
+
+    inline const std::vector<std::string>& get_slots() const { return _slots; }
+
+    inline std::size_t get_max_depth() const { return _max_depth; }
+
+    inline bool empty() const { return _code.empty(); }
+
+    inline void clear() {
+        _code.clear();
+        _slots.clear();
+        _depth     = 0;
+        _max_depth = 0;
+    }
+
+   private:
+    std::vector<Instruction> _code;
+    std::vector<std::string> _slots;
+    std::size_t              _depth;
+    std::size_t              _max_depth;
+};
+
+}  // namespace sscma::interpreter::bytecode
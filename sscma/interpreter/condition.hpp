@@ -4,10 +4,12 @@
 #include <functional>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 #include "core/synchronize/el_guard.hpp"
 #include "core/synchronize/el_mutex.hpp"
 #include "core/utils/el_hash.h"
+#include "sscma/interpreter/bytecode.hpp"
 #include "sscma/interpreter/lexer.hpp"
 #include "sscma/interpreter/parser.hpp"
 #include "sscma/interpreter/types.hpp"
@@ -19,16 +21,19 @@ using namespace edgelab;
 using namespace sscma::types;
 using namespace sscma::interpreter;
 using namespace sscma::interpreter::types;
+using namespace sscma::interpreter::bytecode;
 
+// the expression is compiled to a stack bytecode on set, mutables are resolved to slots once the map is set, so that
+// the evaluation after each inference does not walk the AST or look up the mutables by name
 class Condition {
    public:
-    Condition() : _node(nullptr), _exp_hash(0xffff), _eval_lock() {}
+    Condition() : _exp_hash(0xffff), _eval_lock() {}
 
     ~Condition() { m_unset_condition(); }
 
     inline bool has_condition() {
         const Guard<Mutex> guard(_eval_lock);
-        return _node ? true : false;
+        return !_program.empty();
     }
 
     bool set_condition(const std::string& input) {
@@ -52,11 +57,19 @@ class Condition {
         if (!node) [[unlikely]]
             return false;
 
+        Program program;
+        bool    is_ok = node->compile(program);
+        delete node;
+        if (!is_ok) [[unlikely]]
+            return false;
+
         m_unset_condition();
-        _node     = node;
+        _program  = std::move(program);
         _exp_hash = exp_hash;
 
         for (const auto& tok : mutables) _mutable_map[tok.value] = nullptr;
+        _slots.resize(_program.get_slots().size());
+        _stack.resize(_program.get_max_depth());
 
         return true;
     }
@@ -74,6 +87,7 @@ class Condition {
     inline void set_mutable_map(const mutable_map_t& map) {
         const Guard<Mutex> guard(_eval_lock);
         _mutable_map = map;
+        m_bind_slots();
     }
 
     inline void set_exception_cb(branch_cb_t cb) {
@@ -81,20 +95,105 @@ class Condition {
         _exception_cb = cb;
     }
 
-    inline void evalute(void* caller) {
+    void evalute(void* caller) {
         const Guard<Mutex> guard(_eval_lock);
 
-        if (!_node) [[unlikely]]
+        const auto& code = _program.get_code();
+        if (code.empty()) [[unlikely]]
             return;
 
-        auto result = _node->evaluate([this, caller](NodeType, const std::string& name) {
-            auto it = this->_mutable_map.find(name);
-            if (it != this->_mutable_map.end() && it->second) [[likely]]
-                return Result{.status = EvalStatus::OK, .value = it->second(caller)};
-            return Result{.status = EvalStatus::EXCEPTION, .value = 0};
-        });
+        // the stack is sized to the max depth on compile, sp points to the next free entry
+        int*        sp        = _stack.data();
+        bool        exception = false;
+        std::size_t pc        = 0;
+        std::size_t n         = code.size();
+
+        while (pc < n) {
+            const auto& ins = code[pc++];
+            switch (ins.op) {
+            case OpCode::PUSH:
+                *sp++ = ins.arg;
+                break;
+            case OpCode::LOAD: {
+                const auto& cb = _slots[ins.arg];
+                if (cb) [[likely]]
+                    *sp++ = cb(caller);
+                else {
+                    *sp++     = 0;
+                    exception = true;
+                }
+                break;
+            }
+            case OpCode::RAISE:
+                *sp++     = 0;
+                exception = true;
+                break;
+            case OpCode::ADD:
+                --sp;
+                sp[-1] = sp[-1] + sp[0];
+                break;
+            case OpCode::SUB:
+                --sp;
+                sp[-1] = sp[-1] - sp[0];
+                break;
+            case OpCode::MUL:
+                --sp;
+                sp[-1] = sp[-1] * sp[0];
+                break;
+            case OpCode::DIV:
+                --sp;
+                sp[-1] = sp[0] / sp[-1];
+                break;
+            case OpCode::DIV_GUARD:
+                if (!sp[-1]) [[unlikely]] {
+                    exception = true;
+                    pc        = ins.arg;
+                }
+                break;
+            case OpCode::GT:
+                --sp;
+                sp[-1] = sp[-1] > sp[0];
+                break;
+            case OpCode::LT:
+                --sp;
+                sp[-1] = sp[-1] < sp[0];
+                break;
+            case OpCode::GE:
+                --sp;
+                sp[-1] = sp[-1] >= sp[0];
+                break;
+            case OpCode::LE:
+                --sp;
+                sp[-1] = sp[-1] <= sp[0];
+                break;
+            case OpCode::EQ:
+                --sp;
+                sp[-1] = sp[-1] == sp[0];
+                break;
+            case OpCode::NE:
+                --sp;
+                sp[-1] = sp[-1] != sp[0];
+                break;
+            case OpCode::AND:
+                if (!sp[-1])
+                    pc = ins.arg;
+                else
+                    --sp;
+                break;
+            case OpCode::OR:
+                if (sp[-1]) {
+                    sp[-1] = 1;
+                    pc     = ins.arg;
+                } else
+                    --sp;
+                break;
+            case OpCode::BOOL:
+                sp[-1] = sp[-1] != 0;
+                break;
+            }
+        }
 
-        if (result.status != EvalStatus::OK) [[unlikely]] {
+        if (exception) [[unlikely]] {
             if (_exception_cb) [[likely]]
                 _exception_cb(caller);
         }
@@ -102,19 +201,28 @@ class Condition {
 
    protected:
     inline void m_unset_condition() {
-        if (_node) [[likely]] {
-            delete _node;
-            _node = nullptr;
-        }
+        _program.clear();
+        _slots.clear();
+        _stack.clear();
         _mutable_map.clear();
     }
 
+    inline void m_bind_slots() {
+        const auto& names = _program.get_slots();
+        for (std::size_t i = 0; i < names.size(); ++i) {
+            auto it   = _mutable_map.find(names[i]);
+            _slots[i] = it != _mutable_map.end() ? it->second : nullptr;
+        }
+    }
+
    private:
-    ASTNode*      _node;
-    uint16_t      _exp_hash;
-    Mutex         _eval_lock;
-    mutable_map_t _mutable_map;
-    branch_cb_t   _exception_cb;
+    Program                   _program;
+    std::vector<mutable_cb_t> _slots;
+    std::vector<int>          _stack;
+    uint16_t                  _exp_hash;
+    Mutex                     _eval_lock;
+    mutable_map_t             _mutable_map;
+    branch_cb_t               _exception_cb;
 };
 
 }  // namespace sscma::interpreter
@@ -16,6 +16,11 @@ class IdentifierNode : public ASTNode {
 
     inline Result evaluate(EvalCallback callback) const override { return callback(NodeType::IDENTIFIER, _identifier_name); }
 
+    inline bool compile(bytecode::Program& program) const override {
+        program.emit(bytecode::OpCode::LOAD, program.intern(_identifier_name));
+        return true;
+    }
+
    private:
     std::string _identifier_name;
 };
@@ -28,6 +33,11 @@ class ConstantNode : public ASTNode {
 
     inline Result evaluate(EvalCallback) const override { return Result{.status = EvalStatus::OK, .value = _value}; }
 
+    inline bool compile(bytecode::Program& program) const override {
+        program.emit(bytecode::OpCode::PUSH, _value);
+        return true;
+    }
+
    private:
     int _value;
 };
@@ -137,6 +147,47 @@ class OperatorNode : public ASTNode {
         return result;
     }
 
+    // same evaluation order and short circuits as evaluate(), as the mutables may have side effects
+    bool compile(bytecode::Program& program) const override {
+        using bytecode::OpCode;
+
+        if (!_left || !_right) [[unlikely]]
+            return false;
+
+        auto op = bytecode::operator_2_opcode(_operator_name);
+        switch (op) {
+        case OpCode::RAISE:
+            program.emit(op);
+            return true;
+        case OpCode::AND:
+        case OpCode::OR: {
+            if (!_left->compile(program)) [[unlikely]]
+                return false;
+            auto jump = program.emit_jump(op);
+            if (!_right->compile(program)) [[unlikely]]
+                return false;
+            program.emit(OpCode::BOOL);
+            program.patch(jump);
+            return true;
+        }
+        case OpCode::DIV: {
+            if (!_right->compile(program)) [[unlikely]]
+                return false;
+            auto jump = program.emit_jump(OpCode::DIV_GUARD);
+            if (!_left->compile(program)) [[unlikely]]
+                return false;
+            program.emit(op);
+            program.patch(jump);
+            return true;
+        }
+        default:
+            if (!_left->compile(program) || !_right->compile(program)) [[unlikely]]
+                return false;
+            program.emit(op);
+            return true;
+        }
+    }
+
    private:
     std::string _operator_name;
     ASTNode*    _left;
@@ -151,6 +202,11 @@ class FunctionCallNode : public ASTNode {
 
     Result evaluate(EvalCallback callback) const override { return callback(NodeType::FUNCTION_CALL, _function_call); }
 
+    inline bool compile(bytecode::Program& program) const override {
+        program.emit(bytecode::OpCode::LOAD, program.intern(_function_call));
+        return true;
+    }
+
    private:
     std::string _function_call;
 };
@@ -4,6 +4,8 @@
 #include <string>
 #include <vector>
 
+#include "sscma/interpreter/bytecode.hpp"
+
 namespace sscma::interpreter::types {
 
 static const char lparn = '(';
@@ -34,6 +36,9 @@ class ASTNode {
     virtual ~ASTNode() = default;
 
     virtual Result evaluate(EvalCallback callback) const = 0;
+
+    // emits the bytecode that leaves the value of the node on top of the stack
+    virtual bool compile(bytecode::Program& program) const = 0;
 };
 
 }  // namespace sscma::interpreter::types
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+
+#include "core/el_types.h"
+#include "core/utils/el_cv.h"
+
+namespace sscma::utility {
+
+using namespace edgelab;
+
+// JPEG encoder keeps the output buffer across frames and adapts the quality to the byte budget:
+// once a frame does not fit, the quality is stepped down (and then the chroma is subsampled to 4:2:0), the step that
+// fits is reused for the following frames and stepped back up if a frame takes less than half of the budget
+class JpegEncoder {
+   public:
+    JpegEncoder() : _buffer(nullptr), _size(0), _step(0), _config{} {}
+
+    ~JpegEncoder() {
+        if (_buffer) [[likely]]
+            delete[] _buffer;
+    }
+
+    JpegEncoder(const JpegEncoder&)            = delete;
+    JpegEncoder& operator=(const JpegEncoder&) = delete;
+
+    el_err_code_t encode(const el_img_t* img, el_img_t* jpeg_img, const el_jpeg_config_t& config) {
+        if (!img || !img->data || !img->size) [[unlikely]]
+            return EL_EINVAL;
+
+        // without a budget the buffer is sized to 1/4 of the raw image, and the quality is stepped on overflow
+        std::size_t size = config.max_size ? config.max_size + EL_JPEG_OUTPUT_HEADROOM : img->size >> 2u;
+        if (size < (EL_JPEG_OUTPUT_HEADROOM << 1)) [[unlikely]]
+            size = EL_JPEG_OUTPUT_HEADROOM << 1;
+        // only reallocate when the buffer is not large enough
+        if (size > _size) [[unlikely]] {
+            if (_buffer) [[likely]]
+                delete[] _buffer;
+            _buffer = new uint8_t[size]{};
+            _size   = size;
+        }
+
+        // restart from the configured quality once the config is changed
+        if (std::memcmp(&config, &_config, sizeof(_config)) != 0) [[unlikely]] {
+            _config = config;
+            _step   = 0;
+        }
+
+        std::size_t steps  = max_step(img, config);
+        std::size_t step   = _step < steps ? _step : steps;
+        auto        budget = config.max_size ? static_cast<std::size_t>(config.max_size) : size;
+        auto        ret    = EL_OK;
+
+        for (;; ++step) {
+            auto cfg  = step_config(config, step);
+            *jpeg_img = el_img_t{.data   = _buffer,
+                                 .size   = size,
+                                 .width  = img->width,
+                                 .height = img->height,
+                                 .format = EL_PIXEL_FORMAT_JPEG,
+                                 .rotate = img->rotate};
+            ret       = el_img_encode_jpeg(img, jpeg_img, &cfg);
+            if (ret != EL_ENOMEM || step >= steps) break;
+        }
+
+        if (ret == EL_OK) [[likely]]
+            _step = step && jpeg_img->size < (budget >> 1) ? step - 1 : step;
+        else if (ret == EL_ENOMEM)  // nothing fits, start from the lowest step for the next frame
+            _step = steps;
+
+        return ret;
+    }
+
+    // the last step that fits the budget, 0 for the configured quality and subsampling
+    inline std::size_t get_step() const { return _step; }
+
+   protected:
+    static inline std::size_t max_step(const el_img_t* img, const el_jpeg_config_t& config) {
+        const auto  low     = static_cast<std::size_t>(EL_JPEG_QUALITY_LOW);
+        const auto  quality = static_cast<std::size_t>(config.quality);
+        std::size_t steps   = low - (quality < low ? quality : low);
+        if (config.subsample == EL_JPEG_SUBSAMPLE_444 && img->format != EL_PIXEL_FORMAT_GRAYSCALE) ++steps;
+        return steps;
+    }
+
+    static inline el_jpeg_config_t step_config(const el_jpeg_config_t& config, std::size_t step) {
+        auto cfg = config;
+        for (; step && cfg.quality < EL_JPEG_QUALITY_LOW; --step) ++cfg.quality;
+        if (step) cfg.subsample = EL_JPEG_SUBSAMPLE_420;
+        return cfg;
+    }
+
+   private:
+    uint8_t*         _buffer;
+    std::size_t      _size;
+    std::size_t      _step;
+    el_jpeg_config_t _config;
+};
+
+}  // namespace sscma::utility
@@ -0,0 +1,204 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+
+#include "core/el_types.h"
+#include "core/utils/el_base64.h"
+#include "definations.hpp"
+#include "porting/el_transport.h"
+
+namespace sscma::utility {
+
+using namespace edgelab;
+
+namespace json_writer {
+
+constexpr std::size_t INTEGER_MAX_LENGTH = 20;  // length of UINT64_MAX
+
+// writes the decimal digits of v to out (at least INTEGER_MAX_LENGTH bytes), returns the number of digits
+template <typename T> inline std::size_t fast_utoa(T v, char* out) {
+    static_assert(std::is_unsigned<T>::value);
+    static const char digits_lut[] =
+      "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+      "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+      "8081828384858687888990919293949596979899";
+
+    char  buffer[INTEGER_MAX_LENGTH];
+    char* p = buffer + sizeof(buffer);
+
+    // 2 digits per division, keep 32-bit values on 32-bit arithmetic
+    while (v >= 100u) {
+        std::size_t i = static_cast<std::size_t>(v % 100u) << 1;
+        v /= 100u;
+        *--p = digits_lut[i + 1];
+        *--p = digits_lut[i];
+    }
+    if (v < 10u)
+        *--p = static_cast<char>('0' + v);
+    else {
+        std::size_t i = static_cast<std::size_t>(v) << 1;
+        *--p          = digits_lut[i + 1];
+        *--p          = digits_lut[i];
+    }
+
+    std::size_t len = buffer + sizeof(buffer) - p;
+    std::memcpy(out, p, len);
+    return len;
+}
+
+}  // namespace json_writer
+
+// JSON writer formats into a fixed size chunk on stack and flushes the chunk directly to a transport once it is full,
+// message oriented transports (e.g. MQTT) still get a whole reply per send, the reply is built in a string which is
+// sized up front by reserve() if a large payload is known, and the writer could also target a string, the reply lock
+// of the transport is held by the writer, so that no reply is sent between the chunks
+class JsonWriter {
+   public:
+    explicit JsonWriter(Transport* transport)
+        : _transport(transport),
+          _str(transport && transport->type == EL_TRANSPORT_MQTT ? &_message : nullptr),
+          _reply_lock(transport ? &transport->get_reply_lock() : nullptr),
+          _message(),
+          _size(0) {
+        if (_reply_lock) [[likely]]
+            _reply_lock->lock();
+    }
+
+    explicit JsonWriter(std::string* str)
+        : _transport(nullptr), _str(str), _reply_lock(nullptr), _message(), _size(0) {}
+
+    ~JsonWriter() {
+        flush();
+        if (_reply_lock) [[likely]]
+            _reply_lock->unlock();
+    }
+
+    JsonWriter(const JsonWriter&)            = delete;
+    JsonWriter& operator=(const JsonWriter&) = delete;
+
+    // the writer is flushed on destruction, call it manually only if the reply is completed earlier
+    void flush() {
+        flush_chunk();
+        if (_transport && _message.size()) [[unlikely]] {
+            _transport->send_bytes(_message.c_str(), _message.size());
+            _message.clear();
+        }
+    }
+
+    // size bytes are about to be written, the string a reply is built in is grown once for them and for the tail of the
+    // reply (up to a chunk), instead of being reallocated and copied along the payload, no-op on a streamed reply
+    void reserve(std::size_t size) {
+        if (_str) _str->reserve(_str->size() + _size + size + sizeof(_chunk));
+    }
+
+    void write(const char* data, std::size_t size) {
+        while (size) {
+            if (_size == sizeof(_chunk)) [[unlikely]]
+                flush_chunk();
+            std::size_t n = std::min(size, sizeof(_chunk) - _size);
+            std::memcpy(_chunk + _size, data, n);
+            _size += n;
+            data += n;
+            size -= n;
+        }
+    }
+
+    inline JsonWriter& operator<<(const char* s) {
+        write(s, std::strlen(s));
+        return *this;
+    }
+
+    inline JsonWriter& operator<<(const std::string& s) {
+        write(s.data(), s.size());
+        return *this;
+    }
+
+    inline JsonWriter& operator<<(char c) {
+        if (_size == sizeof(_chunk)) [[unlikely]]
+            flush_chunk();
+        _chunk[_size++] = c;
+        return *this;
+    }
+
+    template <typename T,
+              typename std::enable_if<std::is_integral<T>::value || std::is_enum<T>::value, bool>::type = true>
+    inline JsonWriter& operator<<(T v) {
+        if constexpr (std::is_enum<T>::value)
+            return *this << static_cast<typename std::underlying_type<T>::type>(v);
+        else if constexpr (std::is_same<T, bool>::value)
+            return *this << static_cast<int>(v);
+        else {
+            using U = typename std::conditional<sizeof(T) <= sizeof(uint32_t), uint32_t, uint64_t>::type;
+            if (sizeof(_chunk) - _size < json_writer::INTEGER_MAX_LENGTH + 1) [[unlikely]]
+                flush_chunk();
+            U u = static_cast<U>(v);
+            if constexpr (std::is_signed<T>::value)
+                if (v < 0) {
+                    _chunk[_size++] = '-';
+                    u               = U(0) - u;
+                }
+            _size += json_writer::fast_utoa(u, _chunk + _size);
+            return *this;
+        }
+    }
+
+    // base64 is encoded into the chunk directly, whole triples are encoded until the last chunk
+    JsonWriter& base64(const uint8_t* data, std::size_t size) {
+        reserve(((size + 2) / 3) << 2);
+        while (size) {
+            std::size_t triples = (sizeof(_chunk) - _size) >> 2;
+            if (!triples) [[unlikely]] {
+                flush_chunk();
+                continue;
+            }
+            std::size_t n = std::min(size, triples * 3);
+            el_base64_encode(data, static_cast<int>(n), _chunk + _size);
+            _size += ((n + 2) / 3) << 2;
+            data += n;
+            size -= n;
+        }
+        return *this;
+    }
+
+    // same escaping rules as utility::quoted()
+    JsonWriter& quoted(const char* s, std::size_t size, const char delim = '"') {
+        *this << delim;
+        for (std::size_t i = 0; i < size; ++i) {
+            if (!(s[i] ^ delim) | !(s[i] ^ '\\')) [[unlikely]]
+                *this << '\\';
+            *this << s[i];
+        }
+        return *this << delim;
+    }
+
+    inline JsonWriter& quoted(const std::string& s, const char delim = '"') {
+        return quoted(s.data(), s.size(), delim);
+    }
+
+    inline JsonWriter& quoted(const char* s, const char delim = '"') { return quoted(s, std::strlen(s), delim); }
+
+   protected:
+    inline void flush_chunk() {
+        if (!_size) [[unlikely]]
+            return;
+        if (_str)
+            _str->append(_chunk, _size);
+        else if (_transport) [[likely]]
+            _transport->send_bytes(_chunk, _size);
+        _size = 0;
+    }
+
+   private:
+    Transport*   _transport;
+    std::string* _str;
+    const Mutex* _reply_lock;
+    std::string  _message;
+    std::size_t  _size;
+    char         _chunk[SSCMA_JSON_WRITER_CHUNK_SIZE];
+};
+
+}  // namespace sscma::utility
@@ -11,6 +11,7 @@
 #include "callback/kv.hpp"
 #include "callback/model.hpp"
 #include "callback/mqtt.hpp"
+#include "callback/result_log.hpp"
 #include "callback/sample.hpp"
 #include "callback/sensor.hpp"
 #include "callback/wifi.hpp"
@@ -37,16 +38,38 @@ void run() {
 void init_static_resource() {
     static_resource->init([]() {
         EL_LOGI("[SSCMA] running post init...");
-        static_resource->executor->add_task([](const std::atomic<bool>&) {
+        auto* profile = &static_resource->boot_profile;
+
+        init_storage_sync_hook();
+
+        // the sensor is brought up on the boot worker while the algorithm and the model are loaded on the executor, its
+        // reply is sent from the worker under the reply lock, which is taken only once the sensor is up
+        run_boot_stage_async(profile, BOOT_STAGE_SENSOR, []() { init_sensor_hook("INIT"); });
+
+        static_resource->executor->add_task([profile](const std::atomic<bool>&) {
             std::string caller{"INIT"};
+            profile->begin(BOOT_STAGE_ALGORITHM);
             init_algorithm_hook(caller);
+            profile->end(BOOT_STAGE_ALGORITHM);
+
+            profile->begin(BOOT_STAGE_MODEL);
             init_model_hook(caller);
-            init_sensor_hook(caller);
+            profile->end(BOOT_STAGE_MODEL);
+
+            profile->begin(BOOT_STAGE_ACTION);
             init_action_hook(caller);
+            profile->end(BOOT_STAGE_ACTION);
+
+            // the tasks queued after (e.g. AT+INVOKE received during boot) are run once the sensor is ready
+            profile->wait(BOOT_STAGE_SENSOR);
+
 #if SSCMA_HAS_NATIVE_NETWORKING
+            profile->begin(BOOT_STAGE_NETWORK);
             init_wifi_hook(caller);
             init_mqtt_hook(caller);
+            profile->end(BOOT_STAGE_NETWORK);
 #endif
+            init_model_verify_hook();
         });
     });
 }
@@ -55,7 +78,7 @@ void register_commands() {
     EL_LOGI("[SSCMA] registering AT commands...");
 
     static_resource->instance->register_cmd(
-      "HELP?", "List available commands", "", [](std::vector<std::string> argv, void* caller) {
+      "HELP?", "List available commands", "", [](std::vector<std::string>, void* caller) {
           static_resource->executor->add_task([caller](const std::atomic<bool>&) {
               print_help(static_resource->instance->get_registered_cmds(), caller);
           });
@@ -78,8 +101,9 @@ void register_commands() {
 
     static_resource->instance->register_cmd(
       "STAT?", "Get device status", "", [](std::vector<std::string> argv, void* caller) {
-          static_resource->executor->add_task(
-            [cmd = std::move(argv[0]), caller](const std::atomic<bool>&) { get_device_status(cmd, caller); });
+          // replied in place instead of on the executor, so that the boot progress could be queried during boot
+          const Guard<Mutex> guard(static_cast<Transport*>(caller)->get_reply_lock());
+          get_device_status(argv[0], caller);
           return EL_OK;
       });
 
@@ -91,7 +115,10 @@ void register_commands() {
       });
 
     static_resource->instance->register_cmd("RST", "Reboot device", "", [](std::vector<std::string>, void*) {
-        static_resource->executor->add_task([](const std::atomic<bool>&) { static_resource->device->reset(); });
+        static_resource->executor->add_task([](const std::atomic<bool>&) {
+            static_resource->storage->sync();  // commit the cached writes before reboot
+            static_resource->device->reset();
+        });
         return EL_OK;
     });
 
@@ -206,6 +233,50 @@ void register_commands() {
           return EL_OK;
       });
 
+    static_resource->instance->register_cmd(
+      "JPEG",
+      "Set JPEG encoder config (QUALITY 0-3 from best to low, SUBSAMPLE 0 for 4:4:4 or 1 for 4:2:0, MAX_SIZE)",
+      "QUALITY,SUBSAMPLE,MAX_SIZE",
+      [](std::vector<std::string> argv, void* caller) {
+          static_resource->executor->add_task([cmd       = std::move(argv[0]),
+                                               quality   = std::atoi(argv[1].c_str()),
+                                               subsample = std::atoi(argv[2].c_str()),
+                                               max_size  = std::atoi(argv[3].c_str()),
+                                               caller](const std::atomic<bool>&) {
+              set_jpeg_config(cmd, quality, subsample, max_size, caller);
+          });
+          return EL_OK;
+      });
+
+    static_resource->instance->register_cmd(
+      "JPEG?", "Get JPEG encoder config", "", [](std::vector<std::string> argv, void* caller) {
+          static_resource->executor->add_task(
+            [cmd = std::move(argv[0]), caller](const std::atomic<bool>&) { get_jpeg_config(cmd, caller); });
+          return EL_OK;
+      });
+
+    static_resource->instance->register_cmd(
+      "PREVIEW",
+      "Set preview image resolution (0 for frame size) and format (5 for frame format)",
+      "WIDTH,HEIGHT,FORMAT",
+      [](std::vector<std::string> argv, void* caller) {
+          static_resource->executor->add_task([cmd    = std::move(argv[0]),
+                                               width  = std::atoi(argv[1].c_str()),
+                                               height = std::atoi(argv[2].c_str()),
+                                               format = std::atoi(argv[3].c_str()),
+                                               caller](const std::atomic<bool>&) {
+              set_preview_config(cmd, width, height, format, caller);
+          });
+          return EL_OK;
+      });
+
+    static_resource->instance->register_cmd(
+      "PREVIEW?", "Get preview image config", "", [](std::vector<std::string> argv, void* caller) {
+          static_resource->executor->add_task(
+            [cmd = std::move(argv[0]), caller](const std::atomic<bool>&) { get_preview_config(cmd, caller); });
+          return EL_OK;
+      });
+
     // TODO: sensor config command
 
     static_resource->instance->register_cmd(
@@ -237,7 +308,10 @@ void register_commands() {
                                                result_only = std::atoi(argv[3].c_str()),
                                                caller](const std::atomic<bool>&) {
               static_resource->current_task_id.fetch_add(1, std::memory_order_seq_cst);
-              Invoke::create(cmd, n_times, differed != 0, result_only != 0, caller)->run();
+              // any other non-zero value is the differed invoke with full results, as it was before the delta one
+              auto diff = differed == INVOKE_DIFF_DELTA ? INVOKE_DIFF_DELTA
+                                                        : (differed != 0 ? INVOKE_DIFF_FULL : INVOKE_DIFF_NONE);
+              Invoke::create(cmd, n_times, diff, result_only != 0, caller)->run();
           });
           return EL_OK;
       });
@@ -250,6 +324,88 @@ void register_commands() {
           return EL_OK;
       });
 
+    static_resource->instance->register_cmd(
+      "REPLYFMT",
+      "Set event reply format of current transport (0 for JSON, 1 for binary)",
+      "FORMAT",
+      [](std::vector<std::string> argv, void* caller) {
+          static_resource->executor->add_task(
+            [cmd = std::move(argv[0]), format = std::atoi(argv[1].c_str()), caller](const std::atomic<bool>&) {
+                set_reply_format(cmd, format, caller);
+            });
+          return EL_OK;
+      });
+
+    static_resource->instance->register_cmd(
+      "REPLYFMT?", "Get event reply format of current transport", "", [](std::vector<std::string> argv, void* caller) {
+          static_resource->executor->add_task(
+            [cmd = std::move(argv[0]), caller](const std::atomic<bool>&) { get_reply_format(cmd, caller); });
+          return EL_OK;
+      });
+
+    static_resource->instance->register_cmd(
+      "HEAP",
+      "Set allocation budget per invoke frame (0 for unlimited)",
+      "BUDGET",
+      [](std::vector<std::string> argv, void* caller) {
+          static_resource->executor->add_task(
+            [cmd = std::move(argv[0]), budget = std::atoi(argv[1].c_str()), caller](const std::atomic<bool>&) {
+                set_heap_budget(cmd, budget, caller);
+            });
+          return EL_OK;
+      });
+
+    static_resource->instance->register_cmd(
+      "HEAP?", "Get heap allocation statistics", "", [](std::vector<std::string> argv, void* caller) {
+          static_resource->executor->add_task(
+            [cmd = std::move(argv[0]), caller](const std::atomic<bool>&) { get_heap_status(cmd, caller); });
+          return EL_OK;
+      });
+
+#if CONFIG_EL_TSDB
+    static_resource->instance->register_cmd(
+      "RESLOG",
+      "Set result logging (0 for disable, 1 for enable) and flush interval in ms",
+      "ENABLE,FLUSH_INTERVAL",
+      [](std::vector<std::string> argv, void* caller) {
+          static_resource->executor->add_task([cmd            = std::move(argv[0]),
+                                               enabled        = std::atoi(argv[1].c_str()),
+                                               flush_interval = std::atoi(argv[2].c_str()),
+                                               caller](const std::atomic<bool>&) {
+              set_result_log(cmd, enabled, flush_interval, caller);
+          });
+          return EL_OK;
+      });
+
+    static_resource->instance->register_cmd(
+      "RESLOG?", "Get result logging status", "", [](std::vector<std::string> argv, void* caller) {
+          static_resource->executor->add_task(
+            [cmd = std::move(argv[0]), caller](const std::atomic<bool>&) { get_result_log(cmd, caller); });
+          return EL_OK;
+      });
+
+    static_resource->instance->register_cmd(
+      "RESLOGQUERY",
+      "Query logged results by time range in ms (-1 for until now)",
+      "FROM,TO",
+      [](std::vector<std::string> argv, void* caller) {
+          static_resource->executor->add_task([cmd  = std::move(argv[0]),
+                                               from = std::atoll(argv[1].c_str()),
+                                               to   = std::atoll(argv[2].c_str()),
+                                               caller](const std::atomic<bool>&) {
+              query_result_log(cmd, from, to, caller);
+          });
+          return EL_OK;
+      });
+
+    static_resource->instance->register_cmd(
+      "RESLOGCLEAR", "Clear logged results", "", [](std::vector<std::string> argv, void* caller) {
+          static_resource->executor->add_task(
+            [cmd = std::move(argv[0]), caller](const std::atomic<bool>&) { clear_result_log(cmd, caller); });
+          return EL_OK;
+      });
+#endif
+
     // Note:
     //    AT+ACTION="((count(target,0)>=3)&&led(1))||led(0)"
     //    AT+ACTION="((max_score(target,0)>=80)&&led(1))||led(0)"
@@ -405,10 +561,11 @@ void register_commands() {
 }
 
 void wait_for_inputs() {
-    // mark the system status as ready
-    static_resource->executor->add_task([](const std::atomic<bool>&) { static_resource->is_ready.store(true); });
+    // mark the system status as ready once the AT server accepts commands, the boot stages may be still running
+    static_resource->is_ready.store(true);
+    static_resource->boot_profile.set_ready();
 
-    // broadcast device status to all transports
+    // broadcast device status to all transports once the boot stages are done
     for (auto& transport : static_resource->transports) {
         static_resource->executor->add_task([transport = transport](const std::atomic<bool>&) {
             get_device_status(std::string("INIT@STAT?"), static_cast<void*>(transport));
@@ -423,15 +580,51 @@ void wait_for_inputs() {
 
     char* buf = reinterpret_cast<char*>(el_aligned_malloc_once(16, SSCMA_CMD_MAX_LENGTH + 1));
     std::memset(buf, 0, SSCMA_CMD_MAX_LENGTH + 1);
+    uint64_t last_input = el_get_time_ms();
 
 Loop:
+    // a line is taken from each transport in turn, the lines pipelined by a host are drained before wait
+    bool has_line = false;
     for (auto& transport : static_resource->transports) {
         if (transport && *transport && transport->get_line(buf, SSCMA_CMD_MAX_LENGTH)) {
-            static_resource->instance->exec(buf, static_cast<void*>(transport));
+            has_line    = true;
+            auto* batch = static_resource->get_batch(transport);
+            if (!batch || !Server::is_batch(buf)) [[likely]]
+                static_resource->instance->exec(buf, static_cast<void*>(transport));
+            else {
+                // the replies of a batch are held and sent at once after its status, which is queued after the tasks
+                // of the commands in the batch
+                void*       caller     = static_cast<void*>(static_cast<Transport*>(batch));
+                std::size_t failed     = 0;
+                uint32_t    generation = batch->begin();
+                std::size_t count      = static_resource->instance->exec_batch(buf, caller, &failed);
+                static_resource->executor->add_task(
+                  [batch, caller, generation, count, failed](const std::atomic<bool>&) {
+                      get_batch_status("BATCH", count, failed, caller);
+                      batch->end(generation);
+                  });
+            }
             std::memset(buf, 0, SSCMA_CMD_MAX_LENGTH + 1);
         }
     }
-    el_sleep(20);
+    if (has_line) {
+        last_input = el_get_time_ms();
+        goto Loop;
+    }
+
+    for (auto& batch : static_resource->batches) batch.poll();
+    // woken up at once by a transport received data, the transports unable to tell are polled on timeout, the held
+    // replies of a batch are released once due
+    uint32_t delay = SSCMA_REPL_INPUT_WAIT_MS;
+    for (auto& transport : static_resource->transports) {
+        if (!transport || !*transport || transport->is_recv_notified()) [[likely]]
+            continue;
+        delay = el_get_time_ms() - last_input < SSCMA_REPL_INPUT_ACTIVE_MS ? SSCMA_REPL_INPUT_POLL_DELAY_MIN
+                                                                           : SSCMA_REPL_INPUT_POLL_DELAY_MAX;
+        break;
+    }
+    for (auto& batch : static_resource->batches) delay = std::min(delay, batch.get_due_ms());
+    if (static_resource->input_event.wait(delay)) last_input = el_get_time_ms();
     goto Loop;
 }
 
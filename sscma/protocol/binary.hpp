@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// binary reply frame definitions, dependency free so that it could be shared by host side decoders
+//
+//   offset   size  field
+//   0        2     magic, 0xa5 0x5a
+//   2        1     version
+//   3        1     message type
+//   4        4     payload length N (little-endian)
+//   8        N     payload
+//   8 + N    2     crc16 maxim of bytes [2, 8 + N) (little-endian)
+//
+// payload of an event message (all the integers are little-endian):
+//
+//   u8  name length L, followed by L bytes of command name (including the tag)
+//   u8  response code
+//   u32 event count
+//   sections until the end of payload, each section is [u8 id, u32 length, bytes...]
+//
+// in delta invoke, a keyframe has the ids of all the results, other frames have the records of the added results
+// followed by the moved ones in the results section, their ids, and a delta section of the counts and removed ids
+
+namespace sscma::protocol::binary {
+
+constexpr uint8_t     FRAME_MAGIC[2]     = {0xa5, 0x5a};
+constexpr uint8_t     FRAME_VERSION      = 1;
+constexpr std::size_t FRAME_HEADER_SIZE  = 8;
+constexpr std::size_t FRAME_TRAILER_SIZE = 2;
+
+typedef enum msg_type_e : uint8_t { MSG_TYPE_EVENT = 0x01 } msg_type_e;
+
+typedef enum section_id_e : uint8_t {
+    SECTION_PERF       = 0x01,  // 3 x u32, preprocess, run and postprocess time in ms
+    SECTION_RESOLUTION = 0x02,  // 2 x u16, width and height
+    SECTION_BOXES      = 0x10,  // u16 n, n x box
+    SECTION_POINTS     = 0x11,  // u16 n, n x point
+    SECTION_CLASSES    = 0x12,  // u16 n, n x class
+    SECTION_KEYPOINTS  = 0x13,  // u16 n, n x [box, u8 score, u8 target, u8 m, m x point]
+    SECTION_IDS        = 0x14,  // u16 n, n x u32, object ids of the records in the results section
+    SECTION_DELTA      = 0x15,  // u16 added, u16 moved, u16 n, n x u32 ids of the removed objects
+    SECTION_IMAGE      = 0x20   // raw JPEG bytes
+} section_id_e;
+
+constexpr std::size_t SECTION_HEADER_SIZE = 5;
+
+// packed record sizes
+constexpr std::size_t BOX_RECORD_SIZE   = 11;  // u16 x, u16 y, u16 w, u16 h, u8 score, u16 target
+constexpr std::size_t POINT_RECORD_SIZE = 6;   // u16 x, u16 y, u8 score, u8 target
+constexpr std::size_t CLASS_RECORD_SIZE = 4;   // u16 score, u16 target
+
+}  // namespace sscma::protocol::binary
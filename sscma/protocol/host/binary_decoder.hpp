@@ -0,0 +1,286 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "../binary.hpp"
+
+// host side decoder of the binary reply frames, depends on the C++ standard library only
+//
+//   sscma::protocol::binary::host::Decoder decoder;
+//   decoder.feed(bytes, size);
+//   for (auto frame = Frame{}; decoder.next(frame);) {
+//       auto event = Event{};
+//       if (frame.type == MSG_TYPE_EVENT && parse_event(frame, event)) ...
+//   }
+//   auto text = decoder.take_text();  // JSON replies and logs received on the same link
+
+namespace sscma::protocol::binary::host {
+
+inline uint16_t crc16_maxim(const uint8_t* data, std::size_t length, uint16_t crc = 0x0000) {
+    for (std::size_t i = 0; i < length; ++i) {
+        crc ^= data[i];
+        for (int j = 0; j < 8; ++j) crc = crc & 1 ? (crc >> 1) ^ 0xa001 : crc >> 1;
+    }
+    return crc;
+}
+
+struct Box {
+    uint16_t x, y, w, h;
+    uint8_t  score;
+    uint16_t target;
+};
+
+struct Point {
+    uint16_t x, y;
+    uint8_t  score;
+    uint8_t  target;
+};
+
+struct Class {
+    uint16_t score;
+    uint16_t target;
+};
+
+struct Keypoint {
+    Box                box;
+    uint8_t            score;
+    uint8_t            target;
+    std::vector<Point> pts;
+};
+
+struct Frame {
+    uint8_t              version;
+    uint8_t              type;
+    std::vector<uint8_t> payload;
+};
+
+struct Event {
+    std::string           name;
+    uint8_t               code;
+    uint32_t              count;
+    bool                  has_perf;
+    uint32_t              perf[3];
+    bool                  has_resolution;
+    uint16_t              width;
+    uint16_t              height;
+    std::vector<Box>      boxes;
+    std::vector<Point>    points;
+    std::vector<Class>    classes;
+    std::vector<Keypoint> keypoints;
+    std::vector<uint32_t> ids;  // object ids of the results in delta invoke
+    bool                  has_delta;
+    uint16_t              added;  // counts of the added and moved results, in this order in the results
+    uint16_t              moved;
+    std::vector<uint32_t> removed;
+    std::vector<uint8_t>  image;  // raw JPEG bytes
+};
+
+class Reader {
+   public:
+    Reader(const uint8_t* data, std::size_t size) : _data(data), _size(size), _pos(0), _ok(true) {}
+
+    bool ok() const { return _ok; }
+    bool eof() const { return _pos >= _size; }
+
+    uint8_t u8() {
+        if (!need(1)) return 0;
+        return _data[_pos++];
+    }
+
+    uint16_t u16() {
+        if (!need(2)) return 0;
+        uint16_t v = _data[_pos] | (_data[_pos + 1] << 8);
+        _pos += 2;
+        return v;
+    }
+
+    uint32_t u32() {
+        uint32_t lo = u16();
+        uint32_t hi = u16();
+        return lo | (hi << 16);
+    }
+
+    const uint8_t* bytes(std::size_t n) {
+        if (!need(n)) return nullptr;
+        const uint8_t* p = _data + _pos;
+        _pos += n;
+        return p;
+    }
+
+   private:
+    bool need(std::size_t n) {
+        if (_size - _pos < n) _ok = false;
+        return _ok;
+    }
+
+    const uint8_t* _data;
+    std::size_t    _size;
+    std::size_t    _pos;
+    bool           _ok;
+};
+
+inline Box read_box(Reader& r) {
+    Box b{};
+    b.x      = r.u16();
+    b.y      = r.u16();
+    b.w      = r.u16();
+    b.h      = r.u16();
+    b.score  = r.u8();
+    b.target = r.u16();
+    return b;
+}
+
+inline Point read_point(Reader& r) {
+    Point p{};
+    p.x      = r.u16();
+    p.y      = r.u16();
+    p.score  = r.u8();
+    p.target = r.u8();
+    return p;
+}
+
+// parses the payload of an event frame, unknown sections are skipped for forward compatibility
+inline bool parse_event(const Frame& frame, Event& event) {
+    if (frame.type != MSG_TYPE_EVENT) return false;
+
+    event = Event{};
+
+    Reader r(frame.payload.data(), frame.payload.size());
+
+    std::size_t    name_len = r.u8();
+    const uint8_t* name     = r.bytes(name_len);
+    if (!name) return false;
+    event.name.assign(reinterpret_cast<const char*>(name), name_len);
+    event.code  = r.u8();
+    event.count = r.u32();
+
+    while (r.ok() && !r.eof()) {
+        uint8_t        id   = r.u8();
+        uint32_t       len  = r.u32();
+        const uint8_t* data = r.bytes(len);
+        if (!data) return false;
+
+        Reader s(data, len);
+        switch (id) {
+        case SECTION_PERF:
+            event.has_perf = true;
+            for (auto& v : event.perf) v = s.u32();
+            break;
+        case SECTION_RESOLUTION:
+            event.has_resolution = true;
+            event.width          = s.u16();
+            event.height         = s.u16();
+            break;
+        case SECTION_BOXES:
+            for (uint16_t n = s.u16(); s.ok() && n; --n) event.boxes.push_back(read_box(s));
+            break;
+        case SECTION_POINTS:
+            for (uint16_t n = s.u16(); s.ok() && n; --n) event.points.push_back(read_point(s));
+            break;
+        case SECTION_CLASSES:
+            for (uint16_t n = s.u16(); s.ok() && n; --n) {
+                Class c{};
+                c.score  = s.u16();
+                c.target = s.u16();
+                event.classes.push_back(c);
+            }
+            break;
+        case SECTION_KEYPOINTS:
+            for (uint16_t n = s.u16(); s.ok() && n; --n) {
+                Keypoint kp{};
+                kp.box    = read_box(s);
+                kp.score  = s.u8();
+                kp.target = s.u8();
+                for (uint8_t m = s.u8(); s.ok() && m; --m) kp.pts.push_back(read_point(s));
+                event.keypoints.push_back(std::move(kp));
+            }
+            break;
+        case SECTION_IDS:
+            for (uint16_t n = s.u16(); s.ok() && n; --n) event.ids.push_back(s.u32());
+            break;
+        case SECTION_DELTA:
+            event.has_delta = true;
+            event.added     = s.u16();
+            event.moved     = s.u16();
+            for (uint16_t n = s.u16(); s.ok() && n; --n) event.removed.push_back(s.u32());
+            break;
+        case SECTION_IMAGE:
+            event.image.assign(data, data + len);
+            break;
+        default:
+            break;
+        }
+        if (!s.ok()) return false;
+    }
+
+    return r.ok();
+}
+
+// splits a byte stream into binary frames and text, frames with bad CRC are dropped
+class Decoder {
+   public:
+    explicit Decoder(std::size_t max_payload = 16u << 20) : _max_payload(max_payload), _dropped(0) {}
+
+    void feed(const uint8_t* data, std::size_t size) { _buffer.insert(_buffer.end(), data, data + size); }
+
+    bool next(Frame& frame) {
+        for (;;) {
+            std::size_t i = 0;
+            while (i < _buffer.size() && _buffer[i] != FRAME_MAGIC[0]) ++i;
+            _text.append(_buffer.begin(), _buffer.begin() + i);
+            _buffer.erase(_buffer.begin(), _buffer.begin() + i);
+
+            if (_buffer.size() < 2) return false;
+            if (_buffer[1] != FRAME_MAGIC[1]) {
+                _text += static_cast<char>(_buffer[0]);
+                _buffer.erase(_buffer.begin());
+                continue;
+            }
+            if (_buffer.size() < FRAME_HEADER_SIZE) return false;
+
+            std::size_t length = _buffer[4] | (_buffer[5] << 8) | (_buffer[6] << 16) |
+                                 (static_cast<std::size_t>(_buffer[7]) << 24);
+            if (length > _max_payload) {
+                ++_dropped;
+                _buffer.erase(_buffer.begin());
+                continue;
+            }
+            std::size_t total = FRAME_HEADER_SIZE + length + FRAME_TRAILER_SIZE;
+            if (_buffer.size() < total) return false;
+
+            uint16_t crc      = crc16_maxim(_buffer.data() + 2, total - FRAME_TRAILER_SIZE - 2) ^ 0xffff;
+            uint16_t expected = _buffer[total - 2] | (_buffer[total - 1] << 8);
+            if (crc != expected || _buffer[2] != FRAME_VERSION) {
+                // resync from the next byte, the magic may be a part of text or a corrupted frame
+                ++_dropped;
+                _buffer.erase(_buffer.begin());
+                continue;
+            }
+
+            frame.version = _buffer[2];
+            frame.type    = _buffer[3];
+            frame.payload.assign(_buffer.begin() + FRAME_HEADER_SIZE, _buffer.begin() + FRAME_HEADER_SIZE + length);
+            _buffer.erase(_buffer.begin(), _buffer.begin() + total);
+            return true;
+        }
+    }
+
+    std::string take_text() {
+        std::string text;
+        text.swap(_text);
+        return text;
+    }
+
+    std::size_t dropped() const { return _dropped; }
+
+   private:
+    std::vector<uint8_t> _buffer;
+    std::string          _text;
+    std::size_t          _max_payload;
+    std::size_t          _dropped;
+};
+
+}  // namespace sscma::protocol::binary::host
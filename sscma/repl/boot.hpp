@@ -0,0 +1,139 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <utility>
+
+#include "core/el_debug.h"
+#include "core/synchronize/el_event.hpp"
+#include "porting/el_misc.h"
+#include "sscma/definations.hpp"
+
+#if !CONFIG_EL_HAS_FREERTOS_SUPPORT
+    #include <thread>
+#endif
+
+namespace sscma::repl {
+
+// stages of the boot sequence, the sensor stage runs on a boot worker concurrently with the algorithm and model stages
+typedef enum {
+    BOOT_STAGE_HARDWARE = 0,
+    BOOT_STAGE_BACKEND,
+    BOOT_STAGE_FRONTEND,
+    BOOT_STAGE_SENSOR,
+    BOOT_STAGE_ALGORITHM,
+    BOOT_STAGE_MODEL,
+    BOOT_STAGE_ACTION,
+    BOOT_STAGE_NETWORK,
+    BOOT_STAGE_COUNT
+} boot_stage_e;
+
+// times are in ms since the boot sequence is started, the profile could be updated and read from different tasks
+class BootProfile {
+   public:
+    BootProfile() : _origin(el_get_time_ms()), _ready(0), _begin{}, _end{}, _state{}, _done_event() {}
+
+    ~BootProfile() = default;
+
+    BootProfile(const BootProfile&)            = delete;
+    BootProfile& operator=(const BootProfile&) = delete;
+
+    inline void begin(boot_stage_e stage) {
+        _begin[stage].store(get_time());
+        _state[stage].store(STATE_RUNNING);
+    }
+
+    inline void end(boot_stage_e stage) {
+        _end[stage].store(get_time());
+        _state[stage].store(STATE_DONE);
+        _done_event.set();
+    }
+
+    inline void set_ready() { _ready.store(get_time()); }
+
+    inline bool is_done(boot_stage_e stage) const { return _state[stage].load() == STATE_DONE; }
+
+    inline uint32_t get_ready() const { return _ready.load(); }
+
+    inline uint32_t get_begin(boot_stage_e stage) const { return _begin[stage].load(); }
+
+    // time spent on the stage, or until now if the stage is still running
+    inline uint32_t get_time(boot_stage_e stage) const {
+        switch (_state[stage].load()) {
+        case STATE_RUNNING:
+            return get_time() - _begin[stage].load();
+        case STATE_DONE:
+            return _end[stage].load() - _begin[stage].load();
+        default:
+            return 0;
+        }
+    }
+
+    inline uint8_t get_state(boot_stage_e stage) const { return _state[stage].load(); }
+
+    static inline const char* get_name(boot_stage_e stage) {
+        static const char* names[BOOT_STAGE_COUNT] = {
+          "hardware", "backend", "frontend", "sensor", "algorithm", "model", "action", "network"};
+        return names[stage];
+    }
+
+    // blocks the caller until the stage is done, the stages on the boot worker are joined this way, the event is set by
+    // any stage done, so the stage is checked again once it is set or on timeout (e.g. taken by another waiter)
+    inline void wait(boot_stage_e stage) const {
+        while (_state[stage].load() == STATE_RUNNING) _done_event.wait(SSCMA_BOOT_WAIT_TIMEOUT_MS);
+    }
+
+    static constexpr uint8_t STATE_PENDING = 0;
+    static constexpr uint8_t STATE_RUNNING = 1;
+    static constexpr uint8_t STATE_DONE    = 2;
+
+   protected:
+    inline uint32_t get_time() const { return static_cast<uint32_t>(el_get_time_ms() - _origin); }
+
+   private:
+    uint64_t              _origin;
+    std::atomic<uint32_t> _ready;
+    std::atomic<uint32_t> _begin[BOOT_STAGE_COUNT];
+    std::atomic<uint32_t> _end[BOOT_STAGE_COUNT];
+    std::atomic<uint8_t>  _state[BOOT_STAGE_COUNT];
+    edgelab::Event        _done_event;
+};
+
+// runs a boot stage on a short-lived worker, the stage is marked running before the worker is created so that it could
+// be waited on at once, the stage runs on the caller if the worker is unable to be created
+inline void run_boot_stage_async(BootProfile* profile, boot_stage_e stage, std::function<void(void)> fn) {
+    struct Job {
+        BootProfile*              profile;
+        boot_stage_e              stage;
+        std::function<void(void)> fn;
+
+        static void run(void* this_pointer) {
+            auto* job = static_cast<Job*>(this_pointer);
+            job->fn();
+            job->profile->end(job->stage);
+            delete job;
+#if CONFIG_EL_HAS_FREERTOS_SUPPORT
+            vTaskDelete(nullptr);
+#endif
+        }
+    };
+
+    profile->begin(stage);
+    auto* job = new Job{profile, stage, std::move(fn)};
+
+#if CONFIG_EL_HAS_FREERTOS_SUPPORT
+    auto ret =
+      xTaskCreate(&Job::run, SSCMA_BOOT_WORKER_NAME, SSCMA_BOOT_WORKER_STACK_SIZE, job, SSCMA_REPL_EXECUTOR_PRIO, nullptr);
+    if (ret == pdPASS) [[likely]]
+        return;
+    EL_LOGI("[SSCMA] failed to create boot worker, running %s stage in place", BootProfile::get_name(stage));
+    job->fn();
+    profile->end(stage);
+    delete job;
+#else
+    std::thread(&Job::run, job).detach();
+#endif
+}
+
+}  // namespace sscma::repl
@@ -8,11 +8,17 @@
 #include <utility>
 
 #include "core/el_debug.h"
+#include "core/synchronize/el_event.hpp"
 #include "core/synchronize/el_guard.hpp"
 #include "core/synchronize/el_mutex.hpp"
+#include "porting/el_misc.h"
 #include "sscma/definations.hpp"
 #include "sscma/types.hpp"
 
+#if !CONFIG_EL_HAS_FREERTOS_SUPPORT
+    #include <thread>
+#endif
+
 namespace sscma::repl {
 
 using namespace edgelab;
@@ -24,6 +30,7 @@ class Executor {
    public:
     Executor(std::size_t stack_size, std::size_t priority)
         : _task_queue_lock(),
+          _task_event(),
           _task_stop_requested(false),
           _worker_thread_stop_requested(false),
           _worker_name(SSCMA_EXECUTOR_WORKER_NAME_PREFIX),
@@ -33,28 +40,46 @@ class Executor {
 
         // prepare worker name (FreeRTOS task required), reserve 2 bytes for uint8_t hex string
         _worker_name.reserve(_worker_name.length() + (sizeof(uint8_t) << 1) + 1);
+#if CONFIG_EL_HAS_FREERTOS_SUPPORT
         EL_ASSERT(_worker_name.size() < configMAX_TASK_NAME_LEN);
+#endif
 
         // convert worker id to hex string
         _worker_name += hex_literals[worker_id >> 4];
         _worker_name += hex_literals[worker_id & 0x0f];
 
+#if CONFIG_EL_HAS_FREERTOS_SUPPORT
         [[maybe_unused]] auto ret =
           xTaskCreate(&Executor::c_run, _worker_name.c_str(), stack_size, this, priority, &_worker_handler);
         EL_ASSERT(ret == pdPASS);  // TODO: handle error
+#else
+        // stack size and priority are managed by the OS scheduler
+        (void)stack_size;
+        (void)priority;
+        _worker_handler = std::thread(&Executor::c_run, this);
+#endif
     }
 
     ~Executor() {
         _task_stop_requested.store(true, std::memory_order_seq_cst);
         _worker_thread_stop_requested.store(true, std::memory_order_seq_cst);
+        _task_event.set();
         while (_worker_thread_stop_requested.load()) yield();  // wait for destory
+#if CONFIG_EL_HAS_FREERTOS_SUPPORT
         vTaskDelete(_worker_handler);
+#else
+        if (_worker_handler.joinable()) [[likely]]
+            _worker_handler.join();
+#endif
     }
 
     // the Callable must be a function object or a lambda, the prototype is repl_task_t
     template <typename Callable> inline void add_task(Callable&& task) {
-        const Guard<Mutex> guard(_task_queue_lock);
-        _task_queue.push(std::forward<Callable>(task));
+        {
+            const Guard<Mutex> guard(_task_queue_lock);
+            _task_queue.push(std::forward<Callable>(task));
+        }
+        _task_event.set();
     }
 
     inline bool try_stop_task() {
@@ -70,7 +95,11 @@ class Executor {
     }
 
    protected:
+#if CONFIG_EL_HAS_FREERTOS_SUPPORT
     inline void yield() const { vTaskDelay(10 / portTICK_PERIOD_MS); }
+#else
+    inline void yield() const { el_sleep(10); }
+#endif
 
     void run() {
         while (!_worker_thread_stop_requested.load()) {
@@ -89,7 +118,7 @@ class Executor {
                 continue;                                                          // skip yield
             }
             _task_stop_requested.store(false, std::memory_order_seq_cst);
-            yield();
+            _task_event.wait(SSCMA_REPL_EXECUTOR_WAIT_MS);  // blocks until a task is added
         }
         _worker_thread_stop_requested.store(false, std::memory_order_seq_cst);  // reset the flag
     }
@@ -98,11 +127,16 @@ class Executor {
 
    private:
     Mutex             _task_queue_lock;
+    Event             _task_event;
     std::atomic<bool> _task_stop_requested;
     std::atomic<bool> _worker_thread_stop_requested;
 
-    std::string  _worker_name;
+    std::string _worker_name;
+#if CONFIG_EL_HAS_FREERTOS_SUPPORT
     TaskHandle_t _worker_handler;
+#else
+    std::thread _worker_handler;
+#endif
 
     std::queue<repl_task_t> _task_queue;
 };
@@ -26,17 +26,19 @@
 #pragma once
 
 #include <algorithm>
+#include <cctype>
 #include <cstdint>
 #include <forward_list>
 #include <functional>
-#include <stack>
 #include <string>
+#include <string_view>
 #include <utility>
 #include <vector>
 
 #include "core/el_types.h"
 #include "core/synchronize/el_guard.hpp"
 #include "core/synchronize/el_mutex.hpp"
+#include "sscma/definations.hpp"
 #include "sscma/repl/history.hpp"
 #include "sscma/utility.hpp"
 
@@ -86,7 +88,14 @@ using namespace sscma::types;
 
 class Server {
    public:
-    Server() : _history(SSCMA_REPL_HISTORY_MAX), _cmd_list_lock(), _exec_lock(), _is_ctrl(false), _line_index(-1) {}
+    Server()
+        : _history(SSCMA_REPL_HISTORY_MAX),
+          _cmd_list_lock(),
+          _cmd_table(SSCMA_REPL_CMD_TABLE_SIZE_MIN),
+          _cmd_count(0),
+          _exec_lock(),
+          _is_ctrl(false),
+          _line_index(-1) {}
 
     ~Server() { deinit(); }
 
@@ -110,6 +119,7 @@ class Server {
 
         _history.clear();
         _cmd_list.clear();
+        m_rebuild_cmd_table();
 
         _is_ctrl = false;
         _ctrl_line.clear();
@@ -119,24 +129,23 @@ class Server {
 
     bool has_cmd(const std::string& cmd) {
         const Guard<Mutex> guard(_cmd_list_lock);
-        auto               it = std::find_if(
-          _cmd_list.begin(), _cmd_list.end(), [&](const repl_cmd_t& c) { return c.cmd.compare(cmd) == 0; });
-        return it != _cmd_list.end();
+        return m_find_cmd(cmd, false) != nullptr;
     }
 
     template <typename Command> el_err_code_t register_cmd(Command&& cmd) {
         const Guard<Mutex> guard(_cmd_list_lock);
 
-        if (cmd.cmd.empty()) [[unlikely]]
+        if (cmd.cmd.empty() || cmd._argc > SSCMA_REPL_ARGC_MAX) [[unlikely]]
             return EL_EINVAL;
 
-        auto it = std::find_if(
-          _cmd_list.begin(), _cmd_list.end(), [&](const repl_cmd_t& c) { return c.cmd.compare(cmd.cmd) == 0; });
-        if (it != _cmd_list.end()) [[unlikely]] {                 // if cmd already registered, replace it
-            const Guard<Mutex> guard(_exec_lock);                 // lock to avoid concurrency modification of cmd list
-            *it = std::forward<Command>(cmd);                     // overloaded construct (copy or move)
-        } else                                                    // else register an new cmd
+        auto it = m_find_cmd(cmd.cmd, false);
+        if (it) [[unlikely]] {                     // if cmd already registered, replace it
+            const Guard<Mutex> guard(_exec_lock);  // lock to avoid concurrency modification of cmd list
+            *it = std::forward<Command>(cmd);      // overloaded construct (copy or move), the slot is kept
+        } else {                                   // else register an new cmd
             _cmd_list.emplace_front(std::forward<Command>(cmd));  // inplace construct (copy or move)
+            m_index_cmd(&_cmd_list.front());
+        }
 
         return EL_OK;
     }
@@ -170,6 +179,26 @@ class Server {
         return exec_non_lock(std::move(line), caller);
     }
 
+    // a batch line has more than one command delimited by SSCMA_REPL_BATCH_DELIM (outside of quotes)
+    static bool is_batch(std::string_view line) {
+        std::size_t count = 0;
+        m_split_batch(line, [&](std::string_view) { ++count; });
+        return count > 1;
+    }
+
+    // commands of a batch line are executed in order, returns the number of commands and the number of the failed ones
+    std::size_t exec_batch(std::string_view line, void* caller, std::size_t* failed = nullptr) {
+        std::size_t count = 0;
+        std::size_t n     = 0;
+        m_split_batch(line, [&](std::string_view cmd) {
+            ++count;
+            if (exec(std::string(cmd), caller) != EL_OK) [[unlikely]]
+                ++n;
+        });
+        if (failed) *failed = n;
+        return count;
+    }
+
     void loop(const std::string& line, void* caller) {
         std::for_each(line.begin(), line.end(), [this, caller](char c) { this->loop(c, caller); });
     }
@@ -261,43 +290,176 @@ class Server {
     }
 
    protected:
+    struct cmd_slot_t {
+        uint32_t    hash;
+        repl_cmd_t* cmd;
+    };
+
+    struct cmd_arg_t {
+        std::string_view str;
+        bool             escaped;
+    };
+
     void m_unregister_cmd(std::string cmd) {
         const Guard<Mutex> guard(_exec_lock);
+        if (!m_find_cmd(cmd, false)) return;
         _cmd_list.remove_if([&](const repl_cmd_t& c) { return c.cmd.compare(cmd) == 0; });
+        m_rebuild_cmd_table();
+    }
+
+    // the spaces before a command are trimmed, the empty commands (e.g. after a trailing delimiter) are skipped
+    template <typename Callable> static void m_split_batch(std::string_view line, Callable&& fn) {
+        std::size_t prev  = 0;
+        char        quote = 0;
+        auto        emit  = [&](std::size_t end) {
+            while (prev < end && line[prev] == ' ') ++prev;
+            if (end > prev) fn(line.substr(prev, end - prev));
+        };
+        for (std::size_t i = 0; i < line.size(); ++i) {
+            char c = line[i];
+            if (quote) {
+                if (c == '\\')
+                    ++i;
+                else if (c == quote)
+                    quote = 0;
+            } else if (c == '\'' || c == '"')
+                quote = c;
+            else if (c == SSCMA_REPL_BATCH_DELIM) {
+                emit(i);
+                prev = i + 1;
+            }
+        }
+        emit(line.size());
+    }
+
+    // FNV-1a of the upper-cased name, so that the name in a line is hashed without being copied
+    static inline uint32_t m_hash_cmd(std::string_view name, bool upper) {
+        uint32_t hash = 2166136261u;
+        for (char c : name) {
+            hash ^= static_cast<uint8_t>(upper ? std::toupper(static_cast<unsigned char>(c)) : c);
+            hash *= 16777619u;
+        }
+        return hash;
+    }
+
+    // the registered names are compared as they are, the name in a line is upper-cased on compare
+    static inline bool m_equal_cmd(const std::string& cmd, std::string_view name, bool upper) {
+        if (cmd.size() != name.size()) return false;
+        for (std::size_t i = 0; i < name.size(); ++i) {
+            char c = upper ? static_cast<char>(std::toupper(static_cast<unsigned char>(name[i]))) : name[i];
+            if (cmd[i] != c) return false;
+        }
+        return true;
+    }
+
+    // open addressing with linear probing, the table is at most half full so that a probe always ends on an empty slot
+    repl_cmd_t* m_find_cmd(std::string_view name, bool upper) const {
+        std::size_t mask = _cmd_table.size() - 1;
+        uint32_t    hash = m_hash_cmd(name, upper);
+        for (std::size_t i = hash & mask;; i = (i + 1) & mask) {
+            const auto& slot = _cmd_table[i];
+            if (!slot.cmd) return nullptr;
+            if (slot.hash == hash && m_equal_cmd(slot.cmd->cmd, name, upper)) [[likely]]
+                return slot.cmd;
+        }
+    }
+
+    void m_index_cmd(repl_cmd_t* cmd) {
+        if ((++_cmd_count << 1) > _cmd_table.size()) [[unlikely]] {
+            m_rebuild_cmd_table();
+            return;
+        }
+        std::size_t mask = _cmd_table.size() - 1;
+        uint32_t    hash = m_hash_cmd(cmd->cmd, false);
+        std::size_t i    = hash & mask;
+        while (_cmd_table[i].cmd) i = (i + 1) & mask;
+        _cmd_table[i] = cmd_slot_t{.hash = hash, .cmd = cmd};
+    }
+
+    // rebuilt on unregister or on growth, the elements of the cmd list are never moved so the slots point to them
+    void m_rebuild_cmd_table() {
+        std::size_t count = std::distance(_cmd_list.begin(), _cmd_list.end());
+        std::size_t size  = SSCMA_REPL_CMD_TABLE_SIZE_MIN;
+        while ((count << 1) > size) size <<= 1;
+
+        _cmd_table.assign(size, cmd_slot_t{});
+        _cmd_count = 0;
+        for (auto& c : _cmd_list) m_index_cmd(&c);
+    }
+
+    // tokenize args to views of the line, quoted args keep their escapes until they are copied to argv
+    static std::size_t m_tokenize_args(std::string_view args, cmd_arg_t* argv, std::size_t argc) {
+        std::size_t n     = 0;
+        std::size_t index = 0;
+        std::size_t size  = args.size();
+        while (index < size && n < argc) {  // while not reach end of args and not enough args
+            char c = args[index];
+            if (c == '\'' || c == '"') [[unlikely]] {  // if current char is a quote, find the unescaped closing quote
+                std::size_t prev    = ++index;
+                bool        escaped = false;
+                while (index < size && args[index] != c) {
+                    if (args[index] == '\\') [[unlikely]] {
+                        escaped = true;
+                        ++index;
+                    }
+                    ++index;
+                }
+                argv[n++] = cmd_arg_t{.str = args.substr(prev, std::min(index, size) - prev), .escaped = escaped};
+                ++index;  // skip the closing quote
+            } else if (c == '-' || std::isdigit(c)) {  // if current char is a digit or a minus sign
+                std::size_t prev = index;
+                while (++index < size)                           // while not reach end of args
+                    if (!std::isdigit(args[index])) break;       // if current char is not a digit, break
+                argv[n++] = cmd_arg_t{.str = args.substr(prev, index - prev), .escaped = false};
+            } else
+                ++index;  // if current char is not a quote or a digit, skip it
+        }
+        return n;
+    }
+
+    static std::string m_unescape_arg(const cmd_arg_t& arg) {
+        if (!arg.escaped) [[likely]]
+            return std::string(arg.str);
+        std::string str;
+        str.reserve(arg.str.size());
+        for (std::size_t i = 0; i < arg.str.size(); ++i) {
+            if (arg.str[i] != '\\') [[likely]]
+                str += arg.str[i];
+            else if (++i < arg.str.size()) [[likely]]
+                str += arg.str[i];
+        }
+        return str;
     }
 
     el_err_code_t m_exec_cmd(const std::string& cmd, void* caller) {
-        el_err_code_t ret = EL_EINVAL;
-        std::string   cmd_name;
-        std::string   cmd_args;
+        el_err_code_t    ret = EL_EINVAL;
+        std::string_view cmd_name{cmd};
+        std::string_view cmd_args;
 
         // find first '=' in AT command (<cmd_name>=<cmd_args>)
-        size_t pos = cmd.find_first_of("=");
-        if (pos != std::string::npos) {
-            cmd_name = cmd.substr(0, pos);
-            cmd_args = cmd.substr(pos + 1, cmd.size());
-        } else
-            cmd_name = cmd;
-
-        std::transform(cmd_name.begin(), cmd_name.end(), cmd_name.begin(), ::toupper);
+        size_t pos = cmd_name.find('=');
+        if (pos != std::string_view::npos) {
+            cmd_args = cmd_name.substr(pos + 1);
+            cmd_name = cmd_name.substr(0, pos);
+        }
 
         // check if cmd_name is valid (starts with "AT+")
-        if (cmd_name.rfind("AT+", 0) != 0) {
+        if (cmd_name.size() < 3 || std::toupper(static_cast<unsigned char>(cmd_name[0])) != 'A' ||
+            std::toupper(static_cast<unsigned char>(cmd_name[1])) != 'T' || cmd_name[2] != '+') [[unlikely]] {
             m_echo_cb(caller, EL_EINVAL, "Unknown command: ", cmd, "\n");
             return EL_EINVAL;
         }
-        cmd_name = cmd_name.substr(3, cmd_name.size());  // remove "AT+" command prefix
+        cmd_name.remove_prefix(3);  // remove "AT+" command prefix
 
         // find command tag (everything after last '@'), then remove the tag to get the real command name
-        size_t cmd_body_pos    = cmd_name.rfind('@');
-        cmd_body_pos           = cmd_body_pos != std::string::npos ? cmd_body_pos + 1 : 0;
-        std::string target_cmd = cmd_name.substr(cmd_body_pos, cmd_name.size());
+        size_t           cmd_body_pos = cmd_name.rfind('@');
+        std::string_view target_cmd =
+          cmd_body_pos != std::string_view::npos ? cmd_name.substr(cmd_body_pos + 1) : cmd_name;
 
-        // find command in cmd list
+        // find command in cmd table
         _cmd_list_lock.lock();
-        auto it = std::find_if(
-          _cmd_list.begin(), _cmd_list.end(), [&](const repl_cmd_t& c) { return c.cmd.compare(target_cmd) == 0; });
-        if (it == _cmd_list.end()) [[unlikely]] {
+        auto it = m_find_cmd(target_cmd, true);
+        if (!it) [[unlikely]] {
             m_echo_cb(caller, EL_EINVAL, "Unknown command: ", cmd, "\n");
             _cmd_list_lock.unlock();
             return ret;
@@ -310,45 +472,26 @@ class Server {
         if (!it->cmd_cb) [[unlikely]]
             return ret;
 
-        // tokenize callback args in callback function exisits
-        std::vector<std::string> argv;
-        argv.push_back(cmd_name);
-        std::stack<char> stk;
-        size_t           index = 0;
-        size_t           size  = cmd_args.size();
-        while (index < size && argv.size() < it->_argc + 1u) {  // while not reach end of cmd_args and not enough args
-            char c = cmd_args.at(index);
-            if (c == '\'' || c == '"') [[unlikely]] {  // if current char is a quote
-                stk.push(c);                           // push the quote to stack
-                std::string arg;
-                while (++index < size && stk.size()) {  // while not reach end of cmd_args and stack is not empty
-                    c = cmd_args.at(index);             // get next char
-                    if (c == stk.top())                 // if the char matches the top of stack, pop the stack
-                        stk.pop();
-                    else if (c != '\\') [[likely]]  // if the char is not a backslash, append it to arg
-                        arg += c;
-                    else if (++index < size) [[likely]]  // if the char is a backslash, get next char, append it to arg
-                        arg += cmd_args.at(index);
-                }
-                argv.push_back(std::move(arg));
-            } else if (c == '-' || std::isdigit(c)) {  //if current char is a digit or a minus sign
-                size_t prev = index;
-                while (++index < size)                                // while not reach end of cmd_args
-                    if (!std::isdigit(cmd_args.at(index))) break;     // if current char is not a digit, break
-                argv.push_back(cmd_args.substr(prev, index - prev));  // append the number string to argv
-            } else
-                ++index;  // if current char is not a quote or a digit, skip it
-        }
-        argv.shrink_to_fit();
+        // tokenize callback args on stack, only the args of a command that matches its argc are copied
+        cmd_arg_t   args[SSCMA_REPL_ARGC_MAX];
+        std::size_t argc = m_tokenize_args(cmd_args, args, it->_argc);
+
+        std::string name(cmd_name);
+        std::transform(name.begin(), name.end(), name.begin(), ::toupper);
 
-        if (argv.size() != it->_argc + 1u) [[unlikely]] {
-            m_echo_cb(caller, EL_EINVAL, "Command ", cmd_name, " got wrong arguements.\n");
+        if (argc != it->_argc) [[unlikely]] {
+            m_echo_cb(caller, EL_EINVAL, "Command ", name, " got wrong arguements.\n");
             return ret;
         }
 
+        std::vector<std::string> argv;
+        argv.reserve(argc + 1);
+        argv.push_back(name);
+        for (std::size_t i = 0; i < argc; ++i) argv.push_back(m_unescape_arg(args[i]));
+
         ret = it->cmd_cb(std::move(argv), caller);  // execute callback function
         if (ret != EL_OK) [[unlikely]]
-            m_echo_cb(caller, EL_EINVAL, "Command ", cmd_name, " failed.\n");
+            m_echo_cb(caller, EL_EINVAL, "Command ", name, " failed.\n");
 
         return ret;
     }
@@ -364,6 +507,8 @@ class Server {
 
     Mutex                         _cmd_list_lock;
     std::forward_list<repl_cmd_t> _cmd_list;
+    std::vector<cmd_slot_t>       _cmd_table;
+    std::size_t                   _cmd_count;
 
     Mutex _exec_lock;
 
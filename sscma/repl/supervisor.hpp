@@ -4,12 +4,17 @@
 #include <cstdint>
 #include <list>
 
+#include "core/synchronize/el_event.hpp"
 #include "core/synchronize/el_guard.hpp"
 #include "core/synchronize/el_mutex.hpp"
 #include "porting/el_misc.h"
 #include "sscma/definations.hpp"
 #include "sscma/prototypes.hpp"
 
+#if !CONFIG_EL_HAS_FREERTOS_SUPPORT
+    #include <thread>
+#endif
+
 namespace sscma {
 
 namespace types {
@@ -40,14 +45,17 @@ class Supervisor {
     ~Supervisor() noexcept = default;
 
     void register_supervised_object(Supervisable* object, uint16_t priority) {
-        const Guard<Mutex> guard(_supervised_objects_lock);
-        _supervised_objects.remove_if(
-          [object](const SupervisedObject& supervised_object) { return supervised_object.object == object; });
-        auto it = std::upper_bound(_supervised_objects.begin(),
-                                   _supervised_objects.end(),
-                                   priority,
-                                   [](uint16_t lfs, const SupervisedObject& rhs) { return lfs < rhs.priority; });
-        _supervised_objects.insert(it, {object, priority});
+        {
+            const Guard<Mutex> guard(_supervised_objects_lock);
+            _supervised_objects.remove_if(
+              [object](const SupervisedObject& supervised_object) { return supervised_object.object == object; });
+            auto it = std::upper_bound(_supervised_objects.begin(),
+                                       _supervised_objects.end(),
+                                       priority,
+                                       [](uint16_t lfs, const SupervisedObject& rhs) { return lfs < rhs.priority; });
+            _supervised_objects.insert(it, {object, priority});
+        }
+        notify();
     }
 
     void unregister_supervised_object(Supervisable* object) {
@@ -56,6 +64,9 @@ class Supervisor {
           [object](const SupervisedObject& supervised_object) { return supervised_object.object == object; });
     }
 
+    // polls the supervised objects at once (e.g. a config is changed) instead of on the next period
+    inline void notify() const { _event.set(); }
+
     decltype(auto) get_supervised_objects() const {
         const Guard<Mutex> guard(_supervised_objects_lock);
         return _supervised_objects;
@@ -63,6 +74,7 @@ class Supervisor {
 
    protected:
     Supervisor() noexcept {
+#if CONFIG_EL_HAS_FREERTOS_SUPPORT
         [[maybe_unused]] auto ret = xTaskCreate(&Supervisor::c_run,
                                                 SSCMA_REPL_SUPERVISOR_NAME,
                                                 SSCMA_REPL_SUPERVISOR_STACK_SIZE,
@@ -70,6 +82,10 @@ class Supervisor {
                                                 SSCMA_REPL_SUPERVISOR_PRIO,
                                                 nullptr);
         EL_ASSERT(ret == pdPASS);  // TODO: handle error
+#else
+        // the supervisor lives until the program exits
+        std::thread(&Supervisor::c_run, this).detach();
+#endif
     }
 
     void run() {
@@ -77,7 +93,7 @@ class Supervisor {
         _supervised_objects_lock.lock();
         for (const auto& supervised_object : _supervised_objects) supervised_object.object->poll_from_supervisor();
         _supervised_objects_lock.unlock();
-        el_sleep(SSCMA_REPL_SUPERVISOR_POLL_DELAY);
+        _event.wait(SSCMA_REPL_SUPERVISOR_POLL_DELAY);
     }
         goto Loop;
     }
@@ -87,6 +103,7 @@ class Supervisor {
    private:
     std::list<SupervisedObject> _supervised_objects;
     Mutex                       _supervised_objects_lock;
+    Event                       _event;
 };
 
 }  // namespace repl
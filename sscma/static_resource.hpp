@@ -6,16 +6,22 @@
 #include <cstring>
 #include <functional>
 #include <string>
+#include <unordered_map>
 
+#include "callback/extension/result_log.hpp"
 #include "core/algorithm/el_algorithm_delegate.h"
 #include "core/data/el_data_models.h"
 #include "core/data/el_data_storage.hpp"
+#include "core/data/el_data_timeseries.h"
 #include "core/el_common.h"
 #include "core/engine/el_engine_tflite.h"
+#include "core/synchronize/el_event.hpp"
 #include "core/synchronize/el_guard.hpp"
 #include "core/synchronize/el_mutex.hpp"
+#include "interface/transport/batch.hpp"
 #include "interpreter/condition.hpp"
 #include "porting/el_device.h"
+#include "repl/boot.hpp"
 #include "repl/executor.hpp"
 #include "repl/server.hpp"
 #include "repl/supervisor.hpp"
@@ -35,10 +41,13 @@ using namespace sscma::types;
 using namespace sscma::utility;
 using namespace sscma::repl;
 using namespace sscma::interpreter;
+using namespace sscma::transport;
+#if CONFIG_EL_TSDB
+using namespace sscma::extension;
+#endif
 
 #if SSCMA_HAS_NATIVE_NETWORKING
 using namespace sscma::interface;
-using namespace sscma::transport;
 #endif
 
 class StaticResource final {
@@ -54,6 +63,11 @@ class StaticResource final {
     uint8_t             current_model_id;
     uint8_t             current_sensor_id;
     el_algorithm_type_t current_algorithm_type;
+    el_jpeg_config_t    jpeg_config;
+    preview_config_t    preview_config;
+#if CONFIG_EL_TSDB
+    result_log_config_t result_log_config;
+#endif
 
     // internal states
     std::atomic<std::size_t> current_task_id;
@@ -61,10 +75,23 @@ class StaticResource final {
     bool                     is_sample;
     bool                     is_invoke;
 
+    // timings of the boot stages, reported by AT+STAT?
+    BootProfile boot_profile;
+
+    // set by the transports once data is received, the AT server blocks on it while idle
+    Event input_event;
+
+    // reply formats selected by each transport, replies are in JSON if not specified
+    std::unordered_map<void*, reply_fmt_e> reply_formats;
+
     // external resources (hardware related)
     Device*                       device;
     std::forward_list<Transport*> transports;
 
+    // callers of the batch lines, one for each transport, never released since the replies of a batch may be sent
+    // after the batch is done (e.g. events of an invoke)
+    std::forward_list<Batch> batches;
+
 #if SSCMA_HAS_NATIVE_NETWORKING
     WiFi* wifi;
     MQTT* mqtt;
@@ -74,6 +101,10 @@ class StaticResource final {
     Storage*           storage;
     Engine*            engine;
     AlgorithmDelegate* algorithm_delegate;
+#if CONFIG_EL_TSDB
+    TimeSeries* time_series;
+    ResultLog*  result_log;
+#endif
 
     // destructor
     ~StaticResource() = default;
@@ -92,6 +123,12 @@ class StaticResource final {
         models             = Models::get_ptr();
         storage            = Storage::get_ptr();
         algorithm_delegate = AlgorithmDelegate::get_ptr();
+#if CONFIG_EL_TSDB
+        time_series = TimeSeries::get_ptr();
+
+        static ResultLog v_result_log{time_series};
+        result_log = &v_result_log;
+#endif
 
         static auto v_engine{EngineTFLite()};
         engine = &v_engine;
@@ -104,6 +141,16 @@ class StaticResource final {
         mqtt = &v_mqtt;
 #endif
 
+        for (auto transport : transports)
+            if (transport) [[likely]] {
+                batches.emplace_front(transport);
+                transport->set_recv_event(&input_event);
+            }
+#if SSCMA_HAS_NATIVE_NETWORKING
+        batches.emplace_front(mqtt);
+        mqtt->set_recv_event(&input_event);
+#endif
+
         static auto v_instance{Server()};
         instance = &v_instance;
 
@@ -120,6 +167,24 @@ class StaticResource final {
         if (post_init) post_init();
     }
 
+    inline Batch* get_batch(Transport* transport) {
+        for (auto& batch : batches)
+            if (batch.get_transport() == transport) return &batch;
+        return nullptr;
+    }
+
+    // states kept per transport are keyed by the transport behind a batch caller
+    inline void* get_origin(void* caller) const {
+        for (const auto& batch : batches)
+            if (static_cast<const Transport*>(&batch) == caller) return static_cast<void*>(batch.get_transport());
+        return caller;
+    }
+
+    inline reply_fmt_e get_reply_format(void* caller) const {
+        auto it = reply_formats.find(get_origin(caller));
+        return it != reply_formats.end() ? it->second : REPLY_FMT_JSON;
+    }
+
    protected:
     StaticResource() = default;
 
@@ -129,15 +194,30 @@ class StaticResource final {
         current_model_id       = 1;
         current_sensor_id      = 1;
         current_algorithm_type = EL_ALGO_TYPE_UNDEFINED;
+        jpeg_config            = {EL_JPEG_QUALITY_LOW, EL_JPEG_SUBSAMPLE_444, 0};
+        preview_config         = {0, 0, EL_PIXEL_FORMAT_UNKNOWN};
+#if CONFIG_EL_TSDB
+        result_log_config = {false, 60000};
+#endif
 
         current_task_id = 0;
         is_ready        = false;
         is_sample       = false;
         is_invoke       = false;
 
+        reply_formats.clear();
+
+        boot_profile.begin(BOOT_STAGE_HARDWARE);
         init_hardware();
+        boot_profile.end(BOOT_STAGE_HARDWARE);
+
+        boot_profile.begin(BOOT_STAGE_BACKEND);
         init_backend();
+        boot_profile.end(BOOT_STAGE_BACKEND);
+
+        boot_profile.begin(BOOT_STAGE_FRONTEND);
         init_frontend();
+        boot_profile.end(BOOT_STAGE_FRONTEND);
     }
 
     inline void init_hardware() {
@@ -167,9 +247,15 @@ class StaticResource final {
 
     inline void init_backend() {
         EL_LOGI("[SSCMA] loading resources from flash...");
-        models->init();
         storage->init();
 
+        // models are restored from the persisted index, the index is updated if the partition was rescanned
+        auto model_index = el_model_index_t{};
+        *storage >> el_make_storage_kv_from_type(model_index);
+        models->init(model_index);
+        if (auto index = models->get_index(); std::memcmp(&index, &model_index, sizeof(index)) != 0) [[unlikely]]
+            *storage << el_make_storage_kv_from_type(index);
+
         char version[EL_VERSION_LENTH_MAX]{};
         auto kv = el_make_storage_kv(SSCMA_STORAGE_KEY_VERSION, version);
         // if version match, load other configs from storage
@@ -177,17 +263,28 @@ class StaticResource final {
             *storage >> el_make_storage_kv(SSCMA_STORAGE_KEY_CONF_MODEL_ID, current_model_id) >>
               el_make_storage_kv(SSCMA_STORAGE_KEY_CONF_SENSOR_ID, current_sensor_id) >>
               el_make_storage_kv_from_type(current_algorithm_type) >>
+              el_make_storage_kv_from_type(jpeg_config) >> el_make_storage_kv_from_type(preview_config) >>
               el_make_storage_kv(SSCMA_STORAGE_KEY_BOOT_COUNT, boot_count);
         else {  // else init flash storage
             std::strncpy(version, EL_VERSION, sizeof(version));
             *storage << kv << el_make_storage_kv(SSCMA_STORAGE_KEY_CONF_MODEL_ID, current_model_id)
                      << el_make_storage_kv(SSCMA_STORAGE_KEY_CONF_SENSOR_ID, current_sensor_id)
                      << el_make_storage_kv_from_type(current_algorithm_type)
+                     << el_make_storage_kv_from_type(jpeg_config)
+                     << el_make_storage_kv_from_type(preview_config)
                      << el_make_storage_kv(SSCMA_STORAGE_KEY_BOOT_COUNT, boot_count);
         }
 
         // increment boot count
         *storage << el_make_storage_kv(SSCMA_STORAGE_KEY_BOOT_COUNT, ++boot_count);
+
+#if CONFIG_EL_TSDB
+        // the result log stays disabled until it is configured
+        if (time_series->init() != EL_OK) [[unlikely]]
+            EL_LOGI("[SSCMA] failed to initialize time series database");
+        *storage >> el_make_storage_kv_from_type(result_log_config);
+        result_log->set_flush_interval(result_log_config.flush_interval);
+#endif
     }
 
     inline void init_frontend() {
@@ -201,7 +298,11 @@ class StaticResource final {
                                        ", \"data\": ",
                                        quoted(msg),
                                        "}\n")};
-                if (caller) static_cast<Transport*>(caller)->send_bytes(ss.c_str(), ss.size());
+                if (!caller) [[unlikely]]
+                    return;
+                // replied on the server task, serialized with the replies of the executor
+                const Guard<Mutex> guard(static_cast<Transport*>(caller)->get_reply_lock());
+                static_cast<Transport*>(caller)->send_bytes(ss.c_str(), ss.size());
             }
         });
     }
@@ -107,6 +107,26 @@ typedef struct in6_info_t {
     ipv6_addr_t ip;
 } in6_info_t;
 
+typedef enum reply_fmt_e : uint8_t { REPLY_FMT_JSON = 0, REPLY_FMT_BINARY } reply_fmt_e;
+
+// event replies of invoke are sent every frame, on changes with the full results, or on changes with the added, moved
+// and removed results only (full results are sent as keyframes periodically)
+typedef enum invoke_diff_e : uint8_t { INVOKE_DIFF_NONE = 0, INVOKE_DIFF_FULL, INVOKE_DIFF_DELTA } invoke_diff_e;
+
+// preview image sent with the event replies, it fits into width x height (0 for unlimited) keeping the aspect ratio
+typedef struct preview_config_t {
+    uint16_t width;
+    uint16_t height;
+    uint8_t  format;  // el_pixel_format_t, EL_PIXEL_FORMAT_UNKNOWN keeps the frame format
+} preview_config_t;
+
+// summaries of the invoke results are logged to the time series database if enabled, the records are written in
+// batches once the batch is full or the oldest record is older than the flush interval
+typedef struct result_log_config_t {
+    bool     enabled;
+    uint32_t flush_interval;  // ms
+} result_log_config_t;
+
 typedef enum wifi_name_type_e : uint8_t { SSID, BSSID } wifi_name_type_e;
 
 typedef enum wifi_secu_type_e : uint8_t { AUTO = 0, NONE, WEP, WPA1_WPA2, WPA2_WPA3, WPA3 } wifi_secu_type_e;
@@ -12,9 +12,10 @@
 
 #include "core/algorithm/el_algorithm_delegate.h"
 #include "core/el_types.h"
-#include "core/utils/el_base64.h"
 #include "core/utils/el_cv.h"
 #include "definations.hpp"
+#include "jpeg_encoder.hpp"
+#include "json_writer.hpp"
 #include "porting/el_device.h"
 #include "traits.hpp"
 #include "types.hpp"
@@ -103,327 +104,277 @@ template <typename T> decltype(auto) to_hex_string(T dec) {
     return hex;
 }
 
-decltype(auto) model_info_2_json_str(const el_model_info_t& model_info) {
-    return concat_strings("{\"id\": ",
-                          std::to_string(model_info.id),
-                          ", \"type\": ",
-                          std::to_string(model_info.type),
-                          ", \"address\": ",
-                          std::to_string(model_info.addr_flash),
-                          ", \"size\": ",
-                          std::to_string(model_info.size),
-                          "}");
+// helpers named *_2_json write to a JsonWriter, a reply is streamed to its transport (or to a string) without copies
+
+inline void model_info_2_json(JsonWriter& w, const el_model_info_t& model_info) {
+    w << "{\"id\": " << model_info.id << ", \"type\": " << model_info.type << ", \"address\": " << model_info.addr_flash
+      << ", \"size\": " << model_info.size << "}";
 }
 
-decltype(auto) sensor_info_2_json_str(const el_sensor_info_t& sensor_info, Device* device, bool all_opts = false) {
-    std::string opts;
+void sensor_info_2_json(JsonWriter& w, const el_sensor_info_t& sensor_info, Device* device, bool all_opts = false) {
+    w << "{\"id\": " << sensor_info.id << ", \"type\": " << sensor_info.type << ", \"state\": " << sensor_info.state
+      << ", ";
 
     switch (sensor_info.type) {
     case EL_SENSOR_TYPE_CAM: {
         auto camera = device->get_camera();  // currently only support single camera
         auto opt_id = camera->current_opt_id();
-        opts += concat_strings(
-          "\"opt_id\": ", std::to_string(opt_id), ", \"opt_detail\": \"", camera->current_opt_detail(), "\"");
+        w << "\"opt_id\": " << opt_id << ", \"opt_detail\": \"" << camera->current_opt_detail() << "\"";
         const char* delim = "";
         if (all_opts) {
-            opts += ", \"opts\": {";
+            w << ", \"opts\": {";
             for (const auto& opt : camera->supported_opts()) {
-                opts += concat_strings(delim, quoted(std::to_string(opt.id)), ": ", quoted(opt.details));
+                w << delim << '"' << opt.id << "\": ";
+                w.quoted(opt.details);
                 delim = ", ";
             }
-            opts += "}";
+            w << "}";
         }
     } break;
 
     default:
-        opts = "\"opt_id\": -1, \"opt_detail\": \"Unknown\", \"opts\": {}";
+        w << "\"opt_id\": -1, \"opt_detail\": \"Unknown\", \"opts\": {}";
     }
 
-    return concat_strings("{\"id\": ",
-                          std::to_string(sensor_info.id),
-                          ", \"type\": ",
-                          std::to_string(sensor_info.type),
-                          ", \"state\": ",
-                          std::to_string(sensor_info.state),
-                          ", ",
-                          std::move(opts),
-                          "}");
+    w << "}";
+}
+
+inline void box_2_json(JsonWriter& w, const el_box_t& box) {
+    w << "[" << box.x << ", " << box.y << ", " << box.w << ", " << box.h << ", " << box.score << ", " << box.target
+      << "]";
 }
 
-decltype(auto) results_2_json_str(const std::forward_list<el_box_t>& results) {
-    std::string ss;
+inline void point_2_json(JsonWriter& w, const el_point_t& point) {
+    w << "[" << point.x << ", " << point.y << ", " << point.score << ", " << point.target << "]";
+}
+
+void results_2_json(JsonWriter& w, const std::forward_list<el_box_t>& results) {
     const char* delim = "";
 
-    ss = "\"boxes\": [";
+    w << "\"boxes\": [";
     for (const auto& box : results) {
-        ss += concat_strings(delim,
-                             "[",
-                             std::to_string(box.x),
-                             ", ",
-                             std::to_string(box.y),
-                             ", ",
-                             std::to_string(box.w),
-                             ", ",
-                             std::to_string(box.h),
-                             ", ",
-                             std::to_string(box.score),
-                             ", ",
-                             std::to_string(box.target),
-                             "]");
+        w << delim;
+        box_2_json(w, box);
         delim = ", ";
     }
-    ss += "]";
-
-    return ss;
+    w << "]";
 }
 
-decltype(auto) results_2_json_str(const std::forward_list<el_point_t>& results) {
-    std::string ss;
+void results_2_json(JsonWriter& w, const std::forward_list<el_point_t>& results) {
     const char* delim = "";
 
-    ss = "\"points\": [";
+    w << "\"points\": [";
     for (const auto& point : results) {
-        ss += concat_strings(delim,
-                             "[",
-                             std::to_string(point.x),
-                             ", ",
-                             std::to_string(point.y),
-                             ", ",
-                             std::to_string(point.score),
-                             ", ",
-                             std::to_string(point.target),
-                             "]");
+        w << delim;
+        point_2_json(w, point);
         delim = ", ";
     }
-    ss += "]";
+    w << "]";
+}
 
-    return ss;
+inline void class_2_json(JsonWriter& w, const el_class_t& cls) { w << "[" << cls.score << ", " << cls.target << "]"; }
+
+inline void keypoint_2_json(JsonWriter& w, const el_keypoint_t& kp) {
+    w << "[";
+    box_2_json(w, kp.box);
+    w << ", [";
+    const char* delim = "";
+    for (const auto& pt : kp.pts) {
+        w << delim;
+        point_2_json(w, pt);
+        delim = ", ";
+    }
+    w << "]]";
 }
 
-decltype(auto) results_2_json_str(const std::forward_list<el_class_t>& results) {
-    std::string ss;
+void results_2_json(JsonWriter& w, const std::forward_list<el_class_t>& results) {
     const char* delim = "";
 
-    ss = "\"classes\": [";
+    w << "\"classes\": [";
     for (const auto& cls : results) {
-        ss += concat_strings(delim, "[", std::to_string(cls.score), ", ", std::to_string(cls.target), "]");
+        w << delim;
+        class_2_json(w, cls);
         delim = ", ";
     }
-    ss += "]";
-
-    return ss;
+    w << "]";
 }
 
-decltype(auto) results_2_json_str(const std::forward_list<el_keypoint_t>& results) {
-    std::string ss;
+void results_2_json(JsonWriter& w, const std::forward_list<el_keypoint_t>& results) {
     const char* delim = "";
 
-    ss = "\"keypoints\": [";
+    w << "\"keypoints\": [";
     for (const auto& kp : results) {
-        std::string pts_str{"["};
-        const char* pts_delim = "";
-        for (const auto& pt : kp.pts) {
-            pts_str += concat_strings(pts_delim,
-                                      "[",
-                                      std::to_string(pt.x),
-                                      ", ",
-                                      std::to_string(pt.y),
-                                      ", ",
-                                      std::to_string(pt.score),
-                                      ", ",
-                                      std::to_string(pt.target),
-                                      "]");
-            pts_delim = ", ";
-        }
-        pts_str += "]";
-        ss += concat_strings(delim,
-                             "[",
-                             "[",
-                             std::to_string(kp.box.x),
-                             ", ",
-                             std::to_string(kp.box.y),
-                             ", ",
-                             std::to_string(kp.box.w),
-                             ", ",
-                             std::to_string(kp.box.h),
-                             ", ",
-                             std::to_string(kp.box.score),
-                             ", ",
-                             std::to_string(kp.box.target),
-                             "]",
-                             ", ",
-                             std::move(pts_str),
-                             "]");
+        w << delim;
+        keypoint_2_json(w, kp);
         delim = ", ";
     }
-    ss += "]";
+    w << "]";
+}
 
-    return ss;
+inline void result_2_json(JsonWriter& w, const el_box_t& box) { box_2_json(w, box); }
+
+inline void result_2_json(JsonWriter& w, const el_point_t& point) { point_2_json(w, point); }
+
+inline void result_2_json(JsonWriter& w, const el_class_t& cls) { class_2_json(w, cls); }
+
+inline void result_2_json(JsonWriter& w, const el_keypoint_t& kp) { keypoint_2_json(w, kp); }
+
+inline void img_res_2_json(JsonWriter& w, const el_img_t* img) {
+    w << "\"resolution\": [" << img->width << ", " << img->height << "]";
 }
 
-inline decltype(auto) img_res_2_json_str(const el_img_t* img) {
-    return concat_strings("\"resolution\": [", std::to_string(img->width), ", ", std::to_string(img->height), "]");
+inline void img_2_json(JsonWriter& w, const el_img_t* img) {
+    w << "\"image\": \"";
+    if (img && img->data && img->size) [[likely]]
+        w.base64(img->data, img->size);
+    w << "\"";
 }
 
-inline decltype(auto) img_2_json_str(const el_img_t* img) {
-    if (!img || !img->data || !img->size) [[unlikely]]
-        return std::string("\"image\": \"\"");
+// downscales the frame by the preview config into a buffer shared by all the callers (valid until the next call),
+// the frame itself is returned if it is already in the preview resolution and format
+inline el_err_code_t img_2_preview(const el_img_t* img, el_img_t* preview_img, const preview_config_t* config) {
+    static std::size_t size         = 0;
+    static uint8_t*    preview_data = nullptr;
 
-#if SSCMA_SHARED_BASE64_BUFFER
-    static char*       buffer      = reinterpret_cast<char*>(SSCMA_SHARED_BASE64_BUFFER_BASE);
-    static std::size_t buffer_size = SSCMA_SHARED_BASE64_BUFFER_SIZE;
+    if (!img || !img->data || !img->size) [[unlikely]]
+        return EL_EINVAL;
+
+    uint32_t width  = img->width;
+    uint32_t height = img->height;
+    auto     format = config->format == EL_PIXEL_FORMAT_UNKNOWN ? img->format
+                                                                : static_cast<el_pixel_format_t>(config->format);
+    if (config->width && width > config->width) {
+        height = height * config->width / width;
+        width  = config->width;
+    }
+    if (config->height && height > config->height) {
+        width  = width * config->height / height;
+        height = config->height;
+    }
+    if (!width || !height) [[unlikely]]
+        return EL_EINVAL;
 
-    if ((((img->size + 2u) / 3u) << 2u) + 1u > buffer_size) {
-        EL_LOGW("Error: shared base64 buffer exhausted");
-        return std::string{"\"image\": \"\""};
+    if (width == img->width && height == img->height && format == img->format) [[likely]] {
+        *preview_img = *img;
+        return EL_OK;
     }
-#else
-    static char*       buffer      = nullptr;
-    static std::size_t buffer_size = 0;
-    static std::size_t size        = 0;
-
-    // only reallcate memory when buffer size is not enough
-    if (img->size > size) [[unlikely]] {
-        size        = img->size;
-        buffer_size = (((size + 2u) / 3u) << 2u) + 1u;  // base64 encoded size, +1 for terminating null character
-
-        if (buffer) [[likely]]
-            delete[] buffer;
-        buffer = new char[buffer_size]{};
+
+    std::size_t preview_size = width * height;
+    if (format == EL_PIXEL_FORMAT_RGB565)
+        preview_size <<= 1;
+    else if (format == EL_PIXEL_FORMAT_RGB888)
+        preview_size *= 3;
+    else if (format != EL_PIXEL_FORMAT_GRAYSCALE) [[unlikely]]
+        return EL_ENOTSUP;
+    // only reallocate when the buffer is not large enough
+    if (preview_size > size) [[unlikely]] {
+        if (preview_data) [[likely]]
+            delete[] preview_data;
+        preview_data = new uint8_t[preview_size]{};
+        size         = preview_size;
     }
-#endif
 
-    std::memset(buffer, 0, buffer_size);
-    el_base64_encode(img->data, img->size, buffer);
+    *preview_img = el_img_t{.data   = preview_data,
+                            .size   = preview_size,
+                            .width  = static_cast<uint16_t>(width),
+                            .height = static_cast<uint16_t>(height),
+                            .format = format,
+                            .rotate = EL_PIXEL_ROTATE_0};
 
-    return concat_strings("\"image\": \"", buffer, "\"");
+    return el_img_convert(img, preview_img);
 }
 
-// TODO: avoid repeatly allocate/release memory in for loop
-inline decltype(auto) img_2_jpeg_json_str(const el_img_t* img) {
-    if (!img || !img->data || !img->size) [[unlikely]]
-        return std::string("\"image\": \"\"");
-
-    static std::size_t size      = 0;
-    static uint8_t*    jpeg_data = nullptr;
-    std::size_t        jpeg_size = img->size >> 2u;  // assuing jpeg size is 1/4 of raw image size
-    // only reallcate memory when buffer size is not enough (TODO: reallocate logging for profiling)
-    if (jpeg_size > size) [[unlikely]] {
-        size = jpeg_size;
-        if (jpeg_data) [[likely]]
-            delete[] jpeg_data;
-        jpeg_data = new uint8_t[size]{};
-    }
+// the encoder and its output buffer are shared by all the callers, the output is valid until the next call
+inline el_err_code_t img_2_jpeg(const el_img_t* img, el_img_t* jpeg_img, const el_jpeg_config_t* config = nullptr) {
+    static JpegEncoder            encoder;
+    static const el_jpeg_config_t default_config{
+      .quality = EL_JPEG_QUALITY_LOW, .subsample = EL_JPEG_SUBSAMPLE_444, .max_size = 0};
+
+    return encoder.encode(img, jpeg_img, config ? *config : default_config);
+}
+
+// the preview stage runs before JPEG encoding, so that a smaller preview takes less time to encode and to send
+inline el_err_code_t img_2_preview_jpeg(const el_img_t*         img,
+                                        el_img_t*               jpeg_img,
+                                        const preview_config_t* preview_config,
+                                        const el_jpeg_config_t* jpeg_config) {
+    auto preview_img = el_img_t{};
+    auto ret         = img_2_preview(img, &preview_img, preview_config);
+    if (ret != EL_OK) [[unlikely]]
+        return ret;
+
+    return img_2_jpeg(&preview_img, jpeg_img, jpeg_config);
+}
+
+inline void jpeg_config_2_json(JsonWriter& w, const el_jpeg_config_t* config) {
+    w << "{\"quality\": " << config->quality << ", \"subsample\": " << config->subsample
+      << ", \"max_size\": " << config->max_size << "}";
+}
+
+inline void preview_config_2_json(JsonWriter& w, const preview_config_t* config) {
+    w << "{\"width\": " << config->width << ", \"height\": " << config->height << ", \"format\": " << config->format
+      << "}";
+}
+
+inline void algorithm_info_2_json(JsonWriter& w, const el_algorithm_info_t* info) {
+    w << "{\"type\": " << info->type << ", \"categroy\": " << info->categroy << ", \"input_from\": " << info->input_from
+      << "}";
+}
 
-    std::memset(jpeg_data, 0, size);
-    auto jpeg_img = el_img_t{.data   = jpeg_data,
-                             .size   = size,
-                             .width  = img->width,
-                             .height = img->height,
-                             .format = EL_PIXEL_FORMAT_JPEG,
-                             .rotate = img->rotate};
-
-    if (el_img_convert(img, &jpeg_img) == EL_OK) [[likely]]
-        return img_2_json_str(&jpeg_img);
-
-    return std::string("\"image\": \"\"");
-}
-
-decltype(auto) algorithm_info_2_json_str(const el_algorithm_info_t* info) {
-    return concat_strings("{\"type\": ",
-                          std::to_string(info->type),
-                          ", \"categroy\": ",
-                          std::to_string(info->categroy),
-                          ", \"input_from\": ",
-                          std::to_string(info->input_from),
-                          "}");
-}
-
-template <typename AlgorithmConfigType>
-constexpr decltype(auto) algorithm_config_2_json_str(const AlgorithmConfigType& config) {
-    bool        comma{false};
-    std::string ss{concat_strings("{\"type\": ",
-                                  std::to_string(config.info.type),
-                                  ", \"categroy\": ",
-                                  std::to_string(config.info.categroy),
-                                  ", \"input_from\": ",
-                                  std::to_string(config.info.input_from),
-                                  ", \"config\": {")};
+template <typename AlgorithmConfigType> void algorithm_config_2_json(JsonWriter& w, const AlgorithmConfigType& config) {
+    bool comma{false};
+    w << "{\"type\": " << config.info.type << ", \"categroy\": " << config.info.categroy
+      << ", \"input_from\": " << config.info.input_from << ", \"config\": {";
     if constexpr (has_member_score_threshold<typename std::remove_reference<decltype(config)>::type>()) {
-        ss += concat_strings("\"tscore\": ", std::to_string(config.score_threshold));
+        w << "\"tscore\": " << config.score_threshold;
         comma = true;
     }
     if constexpr (has_member_iou_threshold<typename std::remove_reference<decltype(config)>::type>()) {
-        if (comma) ss += ", ";
-        ss += concat_strings("\"tiou\": ", std::to_string(config.iou_threshold));
+        if (comma) w << ", ";
+        w << "\"tiou\": " << config.iou_threshold;
         comma = true;
     }
-    ss += "}}";
-
-    return ss;
+    w << "}}";
 }
 
-template <typename AlgorithmType> decltype(auto) algorithm_config_2_json_str(std::shared_ptr<AlgorithmType> algorithm) {
-    return algorithm_config_2_json_str(algorithm->get_algorithm_config());
+template <typename AlgorithmType>
+inline void algorithm_config_2_json(JsonWriter& w, std::shared_ptr<AlgorithmType> algorithm) {
+    algorithm_config_2_json(w, algorithm->get_algorithm_config());
 }
 
 template <typename AlgorithmType>
-decltype(auto) algorithm_results_2_json_str(std::shared_ptr<AlgorithmType> algorithm) {
-    std::string ss{concat_strings("\"perf\": [",
-                                  std::to_string(algorithm->get_preprocess_time()),
-                                  ", ",
-                                  std::to_string(algorithm->get_run_time()),
-                                  ", ",
-                                  std::to_string(algorithm->get_postprocess_time()),
-                                  "], ",
-                                  results_2_json_str(algorithm->get_results()))};
-
-    return ss;
+void algorithm_results_2_json(JsonWriter& w, std::shared_ptr<AlgorithmType> algorithm) {
+    w << "\"perf\": [" << algorithm->get_preprocess_time() << ", " << algorithm->get_run_time() << ", "
+      << algorithm->get_postprocess_time() << "], ";
+    results_2_json(w, algorithm->get_results());
 }
 
-decltype(auto) wifi_config_2_json_str(const wifi_sta_cfg_t& config, bool secure = true) {
-    auto        pwd = /* secure ? std::string(std::strlen(config.passwd), '*') : */ std::string(config.passwd);
-    std::string ss{concat_strings("{\"name_type\": ",
-                                  std::to_string(config.name_type),
-                                  ", \"name\": ",
-                                  quoted(config.name),
-                                  ", \"security\": ",
-                                  std::to_string(config.security_type),
-                                  ", \"password\": ",
-                                  quoted(pwd),
-                                  "}")};
-    return ss;
+void wifi_config_2_json(JsonWriter& w, const wifi_sta_cfg_t& config) {
+    w << "{\"name_type\": " << config.name_type << ", \"name\": ";
+    w.quoted(config.name);
+    w << ", \"security\": " << config.security_type << ", \"password\": ";
+    w.quoted(config.passwd);
+    w << "}";
 }
 
-decltype(auto) mqtt_server_config_2_json_str(const mqtt_server_config_t& config, bool secure = true) {
-    auto        pwd = /* secure ? std::string(std::strlen(config.password), '*') : */ std::string(config.password);
-    std::string ss{concat_strings("{\"client_id\": ",
-                                  quoted(config.client_id),
-                                  ", \"address\": ",
-                                  quoted(config.address),
-                                  ", \"port\": ",
-                                  std::to_string(config.port),
-                                  ", \"username\": ",
-                                  quoted(config.username),
-                                  ", \"password\": ",
-                                  quoted(pwd),
-                                  ", \"use_ssl\": ",
-                                  std::to_string(config.use_ssl ? 1 : 0),
-                                  "}")};
-    return ss;
+void mqtt_server_config_2_json(JsonWriter& w, const mqtt_server_config_t& config) {
+    w << "{\"client_id\": ";
+    w.quoted(config.client_id);
+    w << ", \"address\": ";
+    w.quoted(config.address);
+    w << ", \"port\": " << config.port << ", \"username\": ";
+    w.quoted(config.username);
+    w << ", \"password\": ";
+    w.quoted(config.password);
+    w << ", \"use_ssl\": " << (config.use_ssl ? 1 : 0) << "}";
 }
 
-decltype(auto) mqtt_pubsub_config_2_json_str(const mqtt_pubsub_config_t& config) {
-    std::string ss{concat_strings("{\"pub_topic\": ",
-                                  quoted(config.pub_topic),
-                                  ", \"pub_qos\": ",
-                                  std::to_string(config.pub_qos),
-                                  ", \"sub_topic\": ",
-                                  quoted(config.sub_topic),
-                                  ", \"sub_qos\": ",
-                                  std::to_string(config.sub_qos),
-                                  "}")};
-    return ss;
+void mqtt_pubsub_config_2_json(JsonWriter& w, const mqtt_pubsub_config_t& config) {
+    w << "{\"pub_topic\": ";
+    w.quoted(config.pub_topic);
+    w << ", \"pub_qos\": " << config.pub_qos << ", \"sub_topic\": ";
+    w.quoted(config.sub_topic);
+    w << ", \"sub_qos\": " << config.sub_qos << "}";
 }
 
 inline decltype(auto) tokenize_function_2_argv(const std::string& input) {
@@ -479,18 +430,11 @@ decltype(auto) get_default_mqtt_server_config(const Device* device) {
     return default_config;
 }
 
-decltype(auto) in4_info_2_json_str(const in4_info_t& config) {
-    return concat_strings("{\"ip\": \"",
-                          config.ip.to_str(),
-                          "\", \"netmask\": \"",
-                          config.netmask.to_str(),
-                          "\", \"gateway\": \"",
-                          config.gateway.to_str(),
-                          "\"}");
+void in4_info_2_json(JsonWriter& w, const in4_info_t& config) {
+    w << "{\"ip\": \"" << config.ip.to_str() << "\", \"netmask\": \"" << config.netmask.to_str() << "\", \"gateway\": \""
+      << config.gateway.to_str() << "\"}";
 }
 
-decltype(auto) in6_info_2_json_str(const in6_info_t& config) {
-    return concat_strings("{\"ip\": \"", config.ip.to_str(), "\"}");
-}
+void in6_info_2_json(JsonWriter& w, const in6_info_t& config) { w << "{\"ip\": \"" << config.ip.to_str() << "\"}"; }
 
 }  // namespace sscma::utility